@@ -1,6 +1,9 @@
 #version 330 core
 out vec4 FragColor;
-uniform vec4 uColor; // CPU에서 넣어줄 '전역 상수' 같은 값
+// CPU에서 넣어줄 '전역 상수' 같은 값 (C++ 쪽 ObjectBlock과 std140 레이아웃 공유)
+layout(std140) uniform ObjectBlock {
+    vec4 uColor;
+};
 
 void main()
 {
@@ -2,18 +2,31 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
-#include <fstream>
-#include <sstream>
-
+#include <cmath>
 #include <iostream>
 
+#include "shader_util.h"
+#include "embedded_shaders.h"
+#include "program_cache.h"
+#include "std140.h"
+#include "uniform_ring.h"
+#include "gl_state.h"
+
+// shaders/uniform.frag 의 ObjectBlock과 같은 std140 레이아웃
+struct ObjectBlock {
+    std140::Vec4 color;
+};
+using ObjectBlockLayout = std140::Layout<std140::Vec4>;
+STD140_ASSERT_MEMBER(ObjectBlock, ObjectBlockLayout, 0, color);
+STD140_ASSERT_SIZE(ObjectBlock, ObjectBlockLayout);
+
 // 창 크기 상수
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 
 // 프레임버퍼 크기 변경 콜백: 창이 리사이즈될 때 실제 렌더링 영역(뷰포트)도 맞춰줌
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    GetGlState().Viewport(0, 0, width, height);
 }
 
 // 입력 처리 헬퍼: ESC를 누르면 창 닫기 플래그 세팅함
@@ -22,90 +35,6 @@ void processInput(GLFWwindow* window) {
         glfwSetWindowShouldClose(window, true);
 }
 
-static void CheckShaderCompile(GLuint shader, const char* name)
-{
-    GLint success = 0;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        GLint len = 0; glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &len);
-        std::string log(len, '\0');
-        glGetShaderInfoLog(shader, len, &len, log.data());
-        fprintf(stderr, "[Shader Compile Error] %s\n%s\n", name, log.c_str());
-    }
-}
-
-static void CheckProgramLink(GLuint prog)
-{
-    GLint success = 0; glGetProgramiv(prog, GL_LINK_STATUS, &success);
-    if (!success) {
-        GLint len = 0; glGetProgramiv(prog, GL_INFO_LOG_LENGTH, &len);
-        std::string log(len, '\0');
-        glGetProgramInfoLog(prog, len, &len, log.data());
-        fprintf(stderr, "[Program Link Error]\n%s\n", log.c_str());
-    }
-}
-
-GLuint CreateShaderProgram(const char* vs, const char* fs)
-{
-    GLuint v = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(v, 1, &vs, nullptr);
-    glCompileShader(v);
-    CheckShaderCompile(v, "Vertex");
-
-    GLuint f = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(f, 1, &fs, nullptr);
-    glCompileShader(f);
-    CheckShaderCompile(f, "Fragment");
-
-    GLuint p = glCreateProgram();
-    glAttachShader(p, v);
-    glAttachShader(p, f);
-    glLinkProgram(p);
-    CheckProgramLink(p);
-
-    glDeleteShader(v);
-    glDeleteShader(f);
-    return p;
-}
-
-
-static std::string ReadFile(const char* path) {
-    std::ifstream f(path, std::ios::binary);
-    if (!f) {
-        fprintf(stderr, "Failed to open %s", path);
-            return {};
-    }
-    std::ostringstream ss; ss << f.rdbuf();
-    return ss.str();
-}
-
-static GLuint CreateShaderProgramFromFiles(const char* vsPath, const char* fsPath) {
-    std::string vsCode = ReadFile(vsPath);
-    std::string fsCode = ReadFile(fsPath);
-    if (vsCode.empty() || fsCode.empty()) {
-        fprintf(stderr, "Shader source empty: %s or %s", vsPath, fsPath);
-            return 0;
-    }
-    const char* vsSrc = vsCode.c_str();
-    const char* fsSrc = fsCode.c_str();
-
-    GLuint v = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(v, 1, &vsSrc, nullptr);
-    glCompileShader(v); CheckShaderCompile(v, "Vertex");
-
-    GLuint f = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(f, 1, &fsSrc, nullptr);
-    glCompileShader(f); CheckShaderCompile(f, "Fragment");
-
-    GLuint p = glCreateProgram();
-    glAttachShader(p, v);
-    glAttachShader(p, f);
-    glLinkProgram(p); CheckProgramLink(p);
-
-    glDeleteShader(v); glDeleteShader(f);
-    return p;
-}
-
 int main() {
     // 2. GLFW 초기화
     if (!glfwInit()) {
@@ -140,7 +69,7 @@ int main() {
     }
 
     // 7. 첫 뷰포트 설정(왼쪽 아래(0,0) ~ (SCR_WIDTH, SCR_HEIGHT))
-    glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
+    GetGlState().Viewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
 
     // 8. 리사이즈 콜백 등록(창 크기 바뀌면 자동으로 glViewport 맞춰줌)
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
@@ -234,9 +163,15 @@ int main() {
 // (가정) GLFW로 창/컨텍스트 생성 완료, GLAD 초기화 완료
 
     GLuint program = CreateShaderProgramFromFiles("shaders/uniform.vert", "shaders/uniform.frag");
+    GetProgramCache().PrintStats(stdout); // 두 번째 실행부터 hits가 올라가야 정상
+    PrintEmbeddedShaderStats(stdout);     // hits가 0이면 디스크에서 읽은 것
+
+    // uColor는 uniform block(ObjectBlock)으로 옮김: 바인딩 포인트 0에 연결
+    glUniformBlockBinding(program, glGetUniformBlockIndex(program, "ObjectBlock"), 0);
 
-    // 프로그램 링크 후, 한 번만 uniform 위치를 찾아둡니다.
-    GLint colorLoc = glGetUniformLocation(program, "uColor");
+    // 프레임당 draw 여러 개를 가정한 UBO 링 (draw마다 memcpy 한 번 + glBindBufferRange)
+    UniformRing uboRing;
+    uboRing.Init(64 * 1024);
 
     // 렌더 루프 직전에 와이어프레임 모드 켜기
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -245,15 +180,21 @@ int main() {
     {
         float t = (float)glfwGetTime();               // 경과 시간(초)
         float g = 0.5f * std::sin(t) + 0.5f;          // 0~1 사이로 변환
-        glUseProgram(program);                           // (중요) 활성화 먼저
-        glUniform4f(colorLoc, 0.0f, g, 1.0f - g, 1.0f); // 파랑<->초록 계열 변화
-        glBindVertexArray(VAO);
+        uboRing.BeginFrame();
+        GetGlState().UseProgram(program);                // (중요) 활성화 먼저 (같으면 생략)
+        ObjectBlock obj{ { 0.0f, g, 1.0f - g, 1.0f } };  // 파랑<->초록 계열 변화
+        uboRing.Bind(0, uboRing.Push(obj));
+        GetGlState().BindVertexArray(VAO);
         glDrawArrays(GL_TRIANGLES, 0, 3);
+        uboRing.EndFrame();
         glfwSwapBuffers(window);
         glfwPollEvents();
 
     }
     // 10. 종료 처리
+    uboRing.PrintStats(stdout);
+    GetGlState().PrintStats(stdout);
+    uboRing.Destroy();
     glfwTerminate();
     return 0;
 }
@@ -0,0 +1,51 @@
+#pragma once
+// CPU 블록 압축기 (BC1 / BC3 / BC7)
+//  - BC1: 불투명 (4x4 블록당 8바이트, RGBA8 대비 1/8)
+//  - BC3: BC1 색 + BC4 알파 (16바이트, 1/4)
+//  - BC7: 모드 6만 사용 (RGBA 7.7.7.7 + p비트, 4비트 인덱스 / 16바이트). BC3보다 색 품질이 좋음
+// 블록 끝점은 주성분 축으로 잡고 최소제곱으로 다듬음 (quality가 반복 횟수를 정함)
+// 가장 가까운 팔레트 항목 찾기는 SSE2, 블록 행은 스레드로 나눔
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdio>
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+enum class BcFormat { BC1, BC3, BC7 };
+enum class BcQuality { Fast, Normal, High };
+
+struct BcEncodeOptions {
+    BcFormat format = BcFormat::BC1;
+    BcQuality quality = BcQuality::Normal;
+    int threads = 0;          // 0이면 코어 수
+};
+
+struct BcEncodeStats {
+    size_t blocks = 0;
+    size_t pixels = 0;
+    double sqErrRgb = 0.0;    // 원본 대비 제곱 오차 합 (이미지 안쪽 픽셀만)
+    double sqErrAlpha = 0.0;
+    double ms = 0.0;
+
+    double PsnrRgb() const;   // 오차가 없으면 inf
+    double PsnrAlpha() const;
+    void Add(const BcEncodeStats& o);
+};
+
+// 블록 단위로 올림한 압축 크기
+size_t BcCompressedSize(BcFormat format, int w, int h);
+GLenum BcInternalFormat(BcFormat format);
+const char* BcFormatName(BcFormat format);
+
+// rgba: w*h*4 (행 간격 w*4). out은 BcCompressedSize() 바이트.
+// 가장자리 블록은 마지막 행/열을 반복해서 채움
+void EncodeBc(const unsigned char* rgba, int w, int h, const BcEncodeOptions& options,
+              unsigned char* out, BcEncodeStats* stats = nullptr);
+
+void PrintBcStats(FILE* out, const char* name, BcFormat format, const BcEncodeStats& stats);
@@ -0,0 +1,87 @@
+#pragma once
+// 미리 구운(cooked) 텍스처 컨테이너 (.gtex)
+//  - 오프라인(TextureCook)에서 디코드 + 뒤집기 + 밉 체인 생성까지 끝내 두고
+//  - 런타임은 Vfs로 매핑한 파일을 그대로 glTexStorage2D + 레벨별 glTexSubImage2D (stb_image 없음)
+//  - 블록 압축(BC1/BC3/BC7)도 구울 때 끝내 두고 레벨을 glCompressedTex(Sub)Image2D로 그대로 올림
+// 파일 구성: Header | Level[levels] | 16바이트 정렬된 레벨 데이터 (레벨 0부터)
+#include <glad/glad.h>
+
+#include "bc_encoder.h"
+#include "mip_builder.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class FileView;
+class PixelUploadRing;
+
+namespace cooked {
+constexpr uint32_t kMagic = 0x58455447; // "GTEX"
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kMaxLevels = 16;
+
+enum Flags : uint32_t {
+    kFlippedRows = 1u << 0,   // 첫 행이 이미지 아래쪽 (GL 순서)
+    kCompressed  = 1u << 1,   // 블록 압축: format/type 대신 glCompressedTexSubImage2D
+};
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t levels;
+    uint32_t internalFormat;  // glTexStorage2D에 그대로 넘길 값
+    uint32_t format;          // 비압축일 때 glTexSubImage2D의 format/type
+    uint32_t type;
+    uint32_t flags;
+    uint32_t reserved[3];
+};
+
+struct Level {
+    uint64_t offset;          // 파일 시작 기준
+    uint64_t size;
+    uint32_t width;
+    uint32_t height;
+};
+} // namespace cooked
+
+// Auto: 알파가 없으면 BC1, 있으면 BC3 (AutoBc7이면 BC7)
+enum class CookCompression { None, Auto, AutoBc7, BC1, BC3, BC7 };
+
+struct CookOptions {
+    bool flipY = true;
+    bool mipmaps = true;
+    MipOptions mip;               // 밉 체인 필터 (sRGB 선형 평균 / Box·Kaiser / 알파 커버리지)
+    CookCompression compression = CookCompression::None;
+    BcQuality quality = BcQuality::Normal;
+    int threads = 0;              // 블록 압축 스레드 (0이면 코어 수)
+};
+
+struct CookedTextureInfo {
+    int width = 0, height = 0, levels = 0;
+    GLenum internalFormat = 0;
+    bool compressed = false;
+    size_t bytes = 0;         // 모든 레벨 데이터 합
+};
+
+// 이미지 파일(JPEG/PNG 등) → .gtex. 실패 시 stderr 출력 후 false
+// 압축하면 bcStats에 인코딩 시간(모든 레벨)과 레벨 0의 오차(PSNR)를 더함. mipStats에는 밉 생성 시간/처리량
+bool CookTexture(const std::string& srcPath, const std::string& dstPath, const CookOptions& options = {},
+                 BcEncodeStats* bcStats = nullptr, BcFormat* bcFormat = nullptr, MipStats* mipStats = nullptr);
+
+// 헤더와 레벨 목차를 검증하고 정보만 읽음 (레벨 크기가 밉 체인을 따르고, 레벨 바이트가 크기/포맷과 맞고, 파일 범위 안인지)
+bool ReadCookedTextureInfo(const FileView& file, CookedTextureInfo* info);
+// 매핑된 .gtex를 현재 GL_TEXTURE_2D 바인딩에 올림. ring이 있으면 비압축 레벨은 PBO 링을 거침
+bool UploadCookedTexture(const FileView& file, PixelUploadRing* ring = nullptr, CookedTextureInfo* info = nullptr);
+// 텍스처를 새로 만들어 올림 (업로드 전용 유닛 사용). 실패 시 0
+GLuint LoadCookedTexture(const std::string& path, PixelUploadRing* ring = nullptr, CookedTextureInfo* info = nullptr);
+
+// 블록 압축 포맷을 이 컨텍스트에서 쓸 수 있는지 (S3TC 확장 / BPTC는 4.2 또는 확장). GL 스레드 전용
+bool IsCompressedFormatSupported(GLenum internalFormat);
+
+// 확장자가 .gtex인지
+bool IsCookedTexturePath(const std::string& path);
+// "assets/a.jpg" → "assets/a.bc.gtex"(압축 포맷을 지원할 때) → "assets/a.gtex" → 원래 경로 순으로 있는 것
+std::string PreferCookedTexture(const std::string& path);
@@ -0,0 +1,48 @@
+#pragma once
+// stb_image 전용 스레드별 bump 아레나 (stb_image_impl.cpp가 STBI_MALLOC/REALLOC/FREE를 여기로 돌림)
+//  - ImageArenaScope가 살아 있는 동안 이 스레드의 stb 할당은 아레나에서 포인터만 밀어서 나감
+//    (free는 맨 위 블록이면 되감고 아니면 무시, realloc은 맨 위 블록이면 제자리에서 늘림)
+//  - 가장 바깥 스코프가 끝나면 통째로 되감음. 블록은 스레드에 남아 다음 이미지가 재사용
+//    (여러 블록으로 자랐으면 다음 스코프에서 합친 크기 하나로 다시 잡음 → 같은 크기 이미지는 힙 할당 0회)
+//  - 스코프 밖 할당은 그냥 힙. 스코프 안에서 받은 stb 결과를 스코프 밖으로 들고 나가면 안 됨
+//    → 출력은 stbi_load_from_memory_into / stbi_load_rows_from_memory로 호출자 버퍼에 받을 것
+#include <cstddef>
+#include <cstdio>
+
+struct ImageArenaStats {
+    size_t scopes = 0;          // 끝난 가장 바깥 스코프 수 (디코드 + 디코드 풀 작업 묶음)
+    size_t allocs = 0;          // 스코프 안 malloc/realloc 호출 수
+    size_t heapAllocs = 0;      // 그중 힙까지 간 수 (아레나 블록을 새로 잡거나 늘림)
+    size_t unscopedAllocs = 0;  // 스코프 밖 stb 할당 (그냥 힙)
+    size_t peakBytes = 0;       // 스코프 하나가 쓴 최대 바이트
+};
+
+class ImageArenaScope {
+public:
+    // expectedBytes: 이번 디코드에 쓸 것으로 보이는 바이트 (ImageArenaEstimate). 0이면 필요할 때 늘림
+    explicit ImageArenaScope(size_t expectedBytes = 0);
+    ~ImageArenaScope();
+    ImageArenaScope(const ImageArenaScope&) = delete;
+    ImageArenaScope& operator=(const ImageArenaScope&) = delete;
+
+    // 이 스코프가 열린 뒤 이 스레드의 stb 할당 호출 수 / 그중 힙까지 간 수
+    size_t Allocations() const;
+    size_t HeapAllocations() const;
+
+private:
+    size_t allocs0_, heap0_;
+};
+
+// stbi_info로 읽은 크기에서 디코드 작업 메모리 추정 (실패하면 0)
+size_t ImageArenaEstimate(const unsigned char* data, size_t size);
+// 스코프가 끝난 뒤 스레드에 남겨 둘 아레나 최대 크기 (넘으면 힙에 돌려줌). 기본 64MB
+void SetImageArenaRetainLimit(size_t bytes);
+
+ImageArenaStats GetImageArenaStats();
+void ResetImageArenaStats();
+void PrintImageArenaStats(FILE* out);
+
+// STBI_MALLOC/REALLOC/FREE 구현 (stb_image_impl.cpp 전용)
+void* ImageArenaMalloc(size_t size);
+void* ImageArenaRealloc(void* p, size_t size);
+void ImageArenaFree(void* p);
@@ -0,0 +1,9 @@
+#pragma once
+// stb_image 병렬 디코드용 스레드 풀 (stbi_set_parallel_for에 연결)
+//  - JPEG 디코더가 IDCT/업샘플/색 변환을 행 묶음으로, 재시작 마커가 있으면 엔트로피 디코드도 구간별로 나눔
+//  - 작업 스레드는 미리 만들어 두고, 디코드를 부른 스레드도 한 몫을 맡음
+//  - 여러 스레드(예: TextureLoader 워커)가 동시에 디코드해도 됨. 결과는 단일 스레드와 비트 단위로 같음
+
+// threads = 0이면 코어 수, 1이면 끔. 디코드 중에는 바꾸지 말 것
+void SetImageDecodeThreads(int threads);
+int ImageDecodeThreads();
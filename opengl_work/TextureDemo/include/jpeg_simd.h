@@ -0,0 +1,22 @@
+#pragma once
+// stb_image JPEG 내부 루프 커널 선택 (8x8 IDCT / 4:2:0 크로마 업샘플 / YCbCr→RGB(A))
+//  - stb 기본은 SSE2. 여기서 CPUID로 AVX2 / AVX-512 커널을 골라 stbi_set_jpeg_kernels로 끼움
+//  - AVX2/AVX-512 커널은 jpeg_simd_avx2.cpp / jpeg_simd_avx512.cpp만 해당 플래그로 빌드 (mip_builder와 같은 방식)
+//  - 어느 커널이든 출력은 스칼라 경로와 바이트 단위로 같음 (DecodeBench가 확인)
+//  - stb 전역 설정이라 디코드 중인 스레드가 있을 때 바꾸지 말 것
+#include "stb_image.h"
+
+enum class JpegKernel { Auto, Scalar, Sse2, Avx2, Avx512 };
+
+// 이후 디코드부터 적용. 이 CPU/빌드에서 못 쓰면 false (설치 안 함)
+bool SetJpegKernel(JpegKernel kernel);
+// 처음 한 번만 Auto를 설치. 이미 SetJpegKernel로 골랐으면 그대로 둠 (디코드하는 모듈의 Init에서 호출)
+void InstallDefaultJpegKernels();
+
+bool IsJpegKernelSupported(JpegKernel kernel);
+// kernel의 커널 묶음 (벤치/비교용). 못 쓰면 false
+bool GetJpegKernels(JpegKernel kernel, stbi_jpeg_kernels* out);
+// Auto면 이 CPU에서 실제로 고를 커널 이름 ("scalar" / "sse2" / "avx2" / "avx512")
+const char* JpegKernelName(JpegKernel kernel = JpegKernel::Auto);
+// 지금 설치된 커널 이름
+const char* ActiveJpegKernelName();
@@ -0,0 +1,51 @@
+#pragma once
+// CPU 밉맵 생성기 (glGenerateMipmap 대체)
+//  - 색 채널은 sRGB → 선형으로 풀어서 평균하고 다시 sRGB로 (어두운 쪽으로 뭉개지지 않음). 알파는 그대로 선형
+//  - 레벨 사이는 float(선형)로 이어 가므로 8비트 반올림 오차가 쌓이지 않음
+//  - 필터: Box(2x2) / Kaiser(8탭 창 sinc, 분리형. 더 선명하지만 약간 느림)
+//  - alphaCutoff > 0이면 레벨마다 알파를 배율 조정해 컷오프 통과 비율(커버리지)을 레벨 0과 맞춤
+//    (알파 테스트 텍스처가 멀어질수록 얇아져 사라지는 것 방지)
+//  - 행 단위 커널은 스칼라 / SSE2 / AVX2+FMA (CPU를 런타임에 보고 고름), 큰 레벨은 행 묶음을 스레드로 나눔
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+enum class MipFilter { Box, Kaiser };
+enum class MipKernel { Auto, Scalar, Sse2, Avx2 };
+
+struct MipOptions {
+    MipFilter filter = MipFilter::Box;
+    bool srgb = true;           // false면 모든 채널을 선형 값으로 취급 (노멀맵/데이터 텍스처)
+    float alphaCutoff = 0.0f;   // 예: 0.5 (알파 테스트 기준값)
+    int maxLevels = 16;         // 레벨 0 포함
+    int threads = 0;            // 0이면 코어 수
+    MipKernel kernel = MipKernel::Auto;
+};
+
+struct MipLevel {
+    int width = 0, height = 0;
+    std::vector<unsigned char> pixels;   // width*height*channels, 행 사이 여백 없음
+};
+
+struct MipStats {
+    unsigned levels = 0;
+    size_t pixelsIn = 0;        // 필터가 읽은 원본 픽셀 수 (처리량 기준)
+    double ms = 0.0;
+    const char* kernel = "";
+    double MPixPerSec() const { return ms > 0.0 ? pixelsIn / (ms * 1000.0) : 0.0; }
+};
+
+// 레벨 1부터 1x1(또는 maxLevels)까지. 레벨 0(src)은 포함하지 않음
+// channels: 1(회색) 2(회색+알파) 3(RGB) 4(RGBA)
+std::vector<MipLevel> BuildMipChain(const unsigned char* src, int w, int h, int channels,
+                                    const MipOptions& options = {}, MipStats* stats = nullptr);
+
+// 레벨 0 포함 전체 레벨 수 / 레벨 0 포함 전체 바이트
+int MipLevelCount(int w, int h, int maxLevels = 16);
+size_t MipChainBytes(int w, int h, int channels, int maxLevels = 16);
+
+// 이 CPU에서 실제로 쓸 커널 이름 ("scalar" / "sse2" / "avx2")
+const char* MipKernelName(MipKernel kernel = MipKernel::Auto);
+bool IsMipKernelSupported(MipKernel kernel);
+
+void PrintMipStats(FILE* out, const char* name, const MipStats& stats);
@@ -492,6 +492,60 @@ STBIDEF void     stbi_image_free      (void *retval_from_stbi_load);
 
 // get image dimensions & components without fully decoding
 STBIDEF int      stbi_info_from_memory(stbi_uc const *buffer, int len, int *x, int *y, int *comp);
+
+// decode directly into caller-provided memory (e.g. a mapped pixel buffer object) instead of a
+// malloc'd result. query the size first with stbi_info_from_memory; out must hold out_stride*y
+// bytes and desired_channels must be 1..4. bottom_up stores the first image row last (OpenGL
+// order) without a separate flip pass; the flip-on-load flags are ignored. returns 1 on success.
+// JPEG rows are written in place; other formats decode to a temporary and are copied once.
+STBIDEF int      stbi_load_from_memory_into(stbi_uc const *buffer, int len, stbi_uc *out, int out_stride, int bottom_up, int *x, int *y, int *channels_in_file, int desired_channels);
+
+// streaming decode: finished rows go to rows->rows while later rows are still being decoded, and
+// the whole image is never allocated. baseline JPEG hands out rows after each MCU row (one MCU
+// row behind, for upsampling), PNG (8-bit or less, not interlaced) as inflate produces them.
+// anything else (progressive JPEG, interlaced or 16-bit PNG, other formats) is decoded whole and
+// then handed out the same way. begin gets the size before any rows; rows come top row first
+// in bands of band_rows (the last one may be shorter), tightly packed at x*channels bytes per
+// row, and only valid during the call. returning 0 from either callback stops the decode
+// (failure reason "aborted"). desired_channels 0 keeps the file's channels. flip-on-load flags
+// are ignored. returns 1 on success.
+typedef struct
+{
+   int      (*begin)(void *user, int x, int y, int channels_in_file, int channels);
+   int      (*rows) (void *user, const stbi_uc *data, int y0, int count);
+} stbi_row_callbacks;
+
+STBIDEF int      stbi_load_rows_from_memory   (stbi_uc           const *buffer, int len , stbi_row_callbacks const *rows, void *rows_user, int band_rows, int *x, int *y, int *channels_in_file, int desired_channels);
+STBIDEF int      stbi_load_rows_from_callbacks(stbi_io_callbacks const *clbk  , void *user, stbi_row_callbacks const *rows, void *rows_user, int band_rows, int *x, int *y, int *channels_in_file, int desired_channels);
+
+// multithreaded decoding. stb_image never creates threads itself: the application supplies a
+// parallel-for that runs task(arg, i) for every i in [0,count), on any threads in any order, and
+// returns once all of them have finished. count never exceeds max_tasks. the JPEG decoder then
+// runs IDCT, upsampling and color conversion in row bands, and splits baseline entropy decoding
+// on restart intervals when the file has them and is decoded from memory. output is identical
+// to the serial decoder. pass NULL (or max_tasks <= 1) to decode serially; don't change this
+// while another thread is decoding.
+typedef void stbi_parallel_for(void *user, int count, void (*task)(void *arg, int index), void *arg);
+STBIDEF void     stbi_set_parallel_for(stbi_parallel_for *func, void *user, int max_tasks);
+
+// JPEG inner-loop kernels: 8x8 IDCT, 2x2 (4:2:0) chroma upsampling and YCbCr->RGB(A). the
+// application can install its own, e.g. AVX2 versions built separately and picked at runtime.
+// a replacement must produce exactly the same bytes as the built-in kernel. idct_block gets
+// 16-byte aligned data; YCbCr_to_RGB with step 4 writes alpha 255 and with step 3 may write one
+// byte past the last pixel; resample_row_hv_2 writes w*2 bytes and returns out.
+typedef struct
+{
+   void     (*idct_block)(stbi_uc *out, int out_stride, short data[64]);
+   void     (*YCbCr_to_RGB)(stbi_uc *out, const stbi_uc *y, const stbi_uc *pcb, const stbi_uc *pcr, int count, int step);
+   stbi_uc *(*resample_row_hv_2)(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs);
+} stbi_jpeg_kernels;
+
+// fills *k with the built-in kernels: plain C if simd is 0, otherwise the SSE2/NEON ones this
+// build would use (plain C when there are none)
+STBIDEF void     stbi_jpeg_builtin_kernels(stbi_jpeg_kernels *k, int simd);
+// kernels for subsequent decodes. NULL members (or k == NULL) fall back to the built-in ones;
+// don't change this while another thread is decoding
+STBIDEF void     stbi_set_jpeg_kernels(const stbi_jpeg_kernels *k);
 STBIDEF int      stbi_info_from_callbacks(stbi_io_callbacks const *clbk, void *user, int *x, int *y, int *comp);
 STBIDEF int      stbi_is_16_bit_from_memory(stbi_uc const *buffer, int len);
 STBIDEF int      stbi_is_16_bit_from_callbacks(stbi_io_callbacks const *clbk, void *user);
@@ -643,12 +697,14 @@ typedef unsigned short stbi__uint16;
 typedef   signed short stbi__int16;
 typedef unsigned int   stbi__uint32;
 typedef   signed int   stbi__int32;
+typedef unsigned __int64 stbi__uint64;
 #else
 #include <stdint.h>
 typedef uint16_t stbi__uint16;
 typedef int16_t  stbi__int16;
 typedef uint32_t stbi__uint32;
 typedef int32_t  stbi__int32;
+typedef uint64_t stbi__uint64;
 #endif
 
 // should produce compiler error if size is wrong
@@ -750,7 +806,7 @@ static int stbi__cpuid3(void)
 
 #define STBI_SIMD_ALIGN(type, name) __declspec(align(16)) type name
 
-#if !defined(STBI_NO_JPEG) && defined(STBI_SSE2)
+#if !(defined(STBI_NO_JPEG) && defined(STBI_NO_PNG)) && defined(STBI_SSE2)
 static int stbi__sse2_available(void)
 {
    int info3 = stbi__cpuid3();
@@ -761,7 +817,7 @@ static int stbi__sse2_available(void)
 #else // assume GCC-style if not VC++
 #define STBI_SIMD_ALIGN(type, name) type name __attribute__((aligned(16)))
 
-#if !defined(STBI_NO_JPEG) && defined(STBI_SSE2)
+#if !(defined(STBI_NO_JPEG) && defined(STBI_NO_PNG)) && defined(STBI_SSE2)
 static int stbi__sse2_available(void)
 {
    // If we're even attempting to compile this on GCC/Clang, that means
@@ -905,10 +961,20 @@ typedef struct
    int channel_order;
 } stbi__result_info;
 
+// streaming output (stbi_load_rows_*)
+typedef struct
+{
+   stbi_row_callbacks cb;
+   void *user;
+   int band_rows;
+   int started;   // begin has been called
+} stbi__rowsink;
+
 #ifndef STBI_NO_JPEG
 static int      stbi__jpeg_test(stbi__context *s);
 static void    *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__result_info *ri);
 static int      stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp);
+static int      stbi__jpeg_load_rows(stbi__context *s, stbi__rowsink *sink, int *x, int *y, int *comp, int req_comp);
 #endif
 
 #ifndef STBI_NO_PNG
@@ -916,6 +982,7 @@ static int      stbi__png_test(stbi__context *s);
 static void    *stbi__png_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__result_info *ri);
 static int      stbi__png_info(stbi__context *s, int *x, int *y, int *comp);
 static int      stbi__png_is16(stbi__context *s);
+static int      stbi__png_load_rows(stbi__context *s, stbi__rowsink *sink, int *x, int *y, int *comp, int req_comp);
 #endif
 
 #ifndef STBI_NO_BMP
@@ -1134,6 +1201,59 @@ STBIDEF void stbi_set_flip_vertically_on_load_thread(int flag_true_if_should_fli
                                          : stbi__vertically_flip_on_load_global)
 #endif // STBI_THREAD_LOCAL
 
+static stbi_parallel_for *stbi__parallel_func = NULL;
+static void *stbi__parallel_user = NULL;
+static int stbi__parallel_max_tasks = 1;
+
+STBIDEF void stbi_set_parallel_for(stbi_parallel_for *func, void *user, int max_tasks)
+{
+   stbi__parallel_func = func;
+   stbi__parallel_user = user;
+   stbi__parallel_max_tasks = func && max_tasks > 1 ? max_tasks : 1;
+}
+
+// how many tasks to split 'work' units into so that each gets at least 'min_work'
+static int stbi__parallel_tasks(size_t work, size_t min_work)
+{
+   size_t n = min_work ? work / min_work : work;
+   if (n > (size_t) stbi__parallel_max_tasks) n = (size_t) stbi__parallel_max_tasks;
+   return n < 1 ? 1 : (int) n;
+}
+
+static void stbi__parallel_run(int count, void (*task)(void *arg, int index), void *arg)
+{
+   int i;
+   if (count > 1 && stbi__parallel_func)
+      stbi__parallel_func(stbi__parallel_user, count, task, arg);
+   else
+      for (i=0; i < count; ++i) task(arg, i);
+}
+
+static int stbi__rowsink_begin(stbi__rowsink *r, int x, int y, int comp, int n)
+{
+   r->started = 1;
+   if (r->cb.begin && !r->cb.begin(r->user, x, y, comp, n)) return stbi__err("aborted", "Stopped by row callback");
+   return 1;
+}
+
+static int stbi__rowsink_rows(stbi__rowsink *r, const stbi_uc *data, int y0, int count)
+{
+   if (r->cb.rows && !r->cb.rows(r->user, data, y0, count)) return stbi__err("aborted", "Stopped by row callback");
+   return 1;
+}
+
+// a fully decoded image, handed out in bands like a streamed one
+static int stbi__rowsink_image(stbi__rowsink *r, const stbi_uc *data, int x, int y, int comp, int n)
+{
+   int y0;
+   if (!stbi__rowsink_begin(r, x, y, comp, n)) return 0;
+   for (y0=0; y0 < y; y0 += r->band_rows) {
+      int count = y - y0 < r->band_rows ? y - y0 : r->band_rows;
+      if (!stbi__rowsink_rows(r, data + (size_t) n * x * y0, y0, count)) return 0;
+   }
+   return 1;
+}
+
 static void *stbi__load_main(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__result_info *ri, int bpc)
 {
    memset(ri, 0, sizeof(*ri)); // make sure it's initialized if we add new fields
@@ -1752,19 +1872,10 @@ static stbi_uc stbi__compute_y(int r, int g, int b)
 #if defined(STBI_NO_PNG) && defined(STBI_NO_BMP) && defined(STBI_NO_PSD) && defined(STBI_NO_TGA) && defined(STBI_NO_GIF) && defined(STBI_NO_PIC) && defined(STBI_NO_PNM)
 // nothing
 #else
-static unsigned char *stbi__convert_format(unsigned char *data, int img_n, int req_comp, unsigned int x, unsigned int y)
+// convert y rows from data into good (streamed PNG bands use this directly)
+static int stbi__convert_format_rows(unsigned char *good, unsigned char *data, int img_n, int req_comp, unsigned int x, unsigned int y)
 {
    int i,j;
-   unsigned char *good;
-
-   if (req_comp == img_n) return data;
-   STBI_ASSERT(req_comp >= 1 && req_comp <= 4);
-
-   good = (unsigned char *) stbi__malloc_mad3(req_comp, x, y, 0);
-   if (good == NULL) {
-      STBI_FREE(data);
-      return stbi__errpuc("outofmem", "Out of memory");
-   }
 
    for (j=0; j < (int) y; ++j) {
       unsigned char *src  = data + j * x * img_n   ;
@@ -1787,11 +1898,31 @@ static unsigned char *stbi__convert_format(unsigned char *data, int img_n, int r
          STBI__CASE(4,1) { dest[0]=stbi__compute_y(src[0],src[1],src[2]);                   } break;
          STBI__CASE(4,2) { dest[0]=stbi__compute_y(src[0],src[1],src[2]); dest[1] = src[3]; } break;
          STBI__CASE(4,3) { dest[0]=src[0];dest[1]=src[1];dest[2]=src[2];                    } break;
-         default: STBI_ASSERT(0); STBI_FREE(data); STBI_FREE(good); return stbi__errpuc("unsupported", "Unsupported format conversion");
+         default: STBI_ASSERT(0); return stbi__err("unsupported", "Unsupported format conversion");
       }
       #undef STBI__CASE
    }
+   return 1;
+}
+
+static unsigned char *stbi__convert_format(unsigned char *data, int img_n, int req_comp, unsigned int x, unsigned int y)
+{
+   unsigned char *good;
+
+   if (req_comp == img_n) return data;
+   STBI_ASSERT(req_comp >= 1 && req_comp <= 4);
+
+   good = (unsigned char *) stbi__malloc_mad3(req_comp, x, y, 0);
+   if (good == NULL) {
+      STBI_FREE(data);
+      return stbi__errpuc("outofmem", "Out of memory");
+   }
 
+   if (!stbi__convert_format_rows(good, data, img_n, req_comp, x, y)) {
+      STBI_FREE(data);
+      STBI_FREE(good);
+      return NULL;
+   }
    STBI_FREE(data);
    return good;
 }
@@ -1935,6 +2066,9 @@ static stbi_uc *stbi__hdr_to_ldr(float   *data, int x, int y, int comp)
 // huffman decoding acceleration
 #define FAST_BITS   9  // larger handles more cases; smaller stomps less cache
 
+// minimum pixels per parallel task (below this the hand-off costs more than it saves)
+#define STBI__JPEG_PARALLEL_MIN  (1 << 15)
+
 typedef struct
 {
    stbi_uc  fast[1 << FAST_BITS];
@@ -1994,6 +2128,18 @@ typedef struct
    int scan_n, order[4];
    int restart_interval, todo;
 
+   // optional caller-provided output (stbi_load_from_memory_into)
+   stbi_uc *dst;
+   int dst_stride, dst_bottom_up;
+
+   // baseline only: entropy decoding stores coefficients (like progressive) and the idct runs
+   // afterwards in parallel row bands (see stbi_set_parallel_for)
+   int defer_idct;
+
+   // streaming output (stbi_load_rows_*): baseline rows are handed out during entropy decoding
+   stbi__rowsink *sink;
+   void *stream;   // stbi__jpeg_stream
+
 // kernels
    void (*idct_block_kernel)(stbi_uc *out, int out_stride, short data[64]);
    void (*YCbCr_to_RGB_kernel)(stbi_uc *out, const stbi_uc *y, const stbi_uc *pcb, const stbi_uc *pcr, int count, int step);
@@ -2946,10 +3092,134 @@ static void stbi__jpeg_reset(stbi__jpeg *j)
    // since we don't even allow 1<<30 pixels
 }
 
+// number of MCUs in the current scan (a single-component scan has one block per MCU)
+static int stbi__jpeg_scan_mcus(stbi__jpeg *z)
+{
+   if (z->scan_n == 1) {
+      int n = z->order[0];
+      return ((z->img_comp[n].x+7) >> 3) * ((z->img_comp[n].y+7) >> 3);
+   }
+   return z->img_mcu_x * z->img_mcu_y;
+}
+
+// decode MCUs [begin,end) of the current baseline scan into the coefficient planes (defer_idct)
+static int stbi__jpeg_decode_mcus(stbi__jpeg *z, int begin, int end)
+{
+   int m,k,x,y;
+   if (z->scan_n == 1) {
+      int n = z->order[0];
+      int w = (z->img_comp[n].x+7) >> 3;
+      int ha = z->img_comp[n].ha;
+      for (m=begin; m < end; ++m) {
+         short *coeff = z->img_comp[n].coeff + 64 * (m % w + (m / w) * z->img_comp[n].coeff_w);
+         if (!stbi__jpeg_decode_block(z, coeff, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+      }
+      return 1;
+   }
+   for (m=begin; m < end; ++m) {
+      int i = m % z->img_mcu_x, j = m / z->img_mcu_x;
+      for (k=0; k < z->scan_n; ++k) {
+         int n = z->order[k];
+         int ha = z->img_comp[n].ha;
+         for (y=0; y < z->img_comp[n].v; ++y) {
+            for (x=0; x < z->img_comp[n].h; ++x) {
+               int x2 = i*z->img_comp[n].h + x;
+               int y2 = j*z->img_comp[n].v + y;
+               short *coeff = z->img_comp[n].coeff + 64 * (x2 + y2 * z->img_comp[n].coeff_w);
+               if (!stbi__jpeg_decode_block(z, coeff, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+            }
+         }
+      }
+   }
+   return 1;
+}
+
+typedef struct
+{
+   stbi__jpeg *z;
+   stbi_uc **starts;   // entropy data of each restart interval
+   int intervals, mcus, tasks;
+   int *ok;
+} stbi__jpeg_restart_job;
+
+static void stbi__jpeg_restart_task(void *arg, int index)
+{
+   stbi__jpeg_restart_job *job = (stbi__jpeg_restart_job *) arg;
+   int first = (int) ((size_t) job->intervals * index / job->tasks);
+   int last  = (int) ((size_t) job->intervals * (index+1) / job->tasks);
+   int i;
+   stbi__context s = *job->z->s;
+   // private copy of the entropy decoder state; tables, quantizers and planes are shared read-only
+   // (or written in disjoint blocks)
+   stbi__jpeg *z = (stbi__jpeg *) stbi__malloc(sizeof(stbi__jpeg));
+   job->ok[index] = 0;
+   if (!z) return;
+   memcpy(z, job->z, sizeof(stbi__jpeg));
+   z->s = &s;
+   for (i=first; i < last; ++i) {
+      int begin = i * z->restart_interval;
+      int end = begin + z->restart_interval < job->mcus ? begin + z->restart_interval : job->mcus;
+      s.img_buffer = job->starts[i];
+      stbi__jpeg_reset(z);
+      if (!stbi__jpeg_decode_mcus(z, begin, end)) { STBI_FREE(z); return; }
+   }
+   STBI_FREE(z);
+   job->ok[index] = 1;
+}
+
+// split a baseline scan on its RSTn markers and entropy-decode the intervals in parallel.
+// returns 1/0 like stbi__parse_entropy_coded_data, or -1 to fall back to the serial decoder
+// (nothing consumed) when the markers don't match the restart interval
+static int stbi__jpeg_parse_restarts_parallel(stbi__jpeg *z)
+{
+   stbi__jpeg_restart_job job;
+   stbi_uc *p = z->s->img_buffer, *end = z->s->img_buffer_end;
+   int found = 1, i, ok = 1;
+
+   job.mcus = stbi__jpeg_scan_mcus(z);
+   job.intervals = (job.mcus + z->restart_interval - 1) / z->restart_interval;
+   job.tasks = stbi__parallel_tasks((size_t) z->s->img_x * z->s->img_y, STBI__JPEG_PARALLEL_MIN);
+   if (job.tasks > job.intervals) job.tasks = job.intervals;
+   if (job.tasks <= 1) return -1;
+
+   job.starts = (stbi_uc **) stbi__malloc_mad2(job.intervals, sizeof(stbi_uc *), 0);
+   job.ok = (int *) stbi__malloc_mad2(job.tasks, sizeof(int), 0);
+   if (!job.starts || !job.ok) { STBI_FREE(job.starts); STBI_FREE(job.ok); return -1; }
+
+   // find where each interval starts; any marker other than RSTn (or a surplus RSTn) ends the scan
+   job.starts[0] = p;
+   while (p + 1 < end) {
+      if (p[0] != 0xff || p[1] == 0x00) { p += p[0] == 0xff ? 2 : 1; continue; }
+      if (p[1] == 0xff) { ++p; continue; } // fill byte
+      if (!STBI__RESTART(p[1]) || found == job.intervals) break;
+      job.starts[found++] = p + 2;
+      p += 2;
+   }
+   if (found != job.intervals) { STBI_FREE(job.starts); STBI_FREE(job.ok); return -1; }
+
+   job.z = z;
+   stbi__parallel_run(job.tasks, stbi__jpeg_restart_task, &job);
+   for (i=0; i < job.tasks; ++i) ok &= job.ok[i];
+   STBI_FREE(job.starts);
+   STBI_FREE(job.ok);
+   if (!ok) return stbi__err("bad huffman code","Corrupt JPEG"); // the tasks' reasons are thread-local
+
+   // leave the stream where the serial decoder would: at the marker that ends the scan
+   z->s->img_buffer = p;
+   stbi__jpeg_reset(z);
+   return 1;
+}
+
+static int stbi__jpeg_stream_rows(stbi__jpeg *z, int decoded);
+
 static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
 {
    stbi__jpeg_reset(z);
    if (!z->progressive) {
+      if (z->defer_idct && z->restart_interval && !z->s->read_from_callbacks) {
+         int r = stbi__jpeg_parse_restarts_parallel(z);
+         if (r >= 0) return r;
+      }
       if (z->scan_n == 1) {
          int i,j;
          STBI_SIMD_ALIGN(short, data[64]);
@@ -2963,8 +3233,13 @@ static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
          for (j=0; j < h; ++j) {
             for (i=0; i < w; ++i) {
                int ha = z->img_comp[n].ha;
-               if (!stbi__jpeg_decode_block(z, data, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
-               z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
+               if (z->defer_idct) {
+                  short *coeff = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
+                  if (!stbi__jpeg_decode_block(z, coeff, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+               } else {
+                  if (!stbi__jpeg_decode_block(z, data, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+                  z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
+               }
                // every data block is an MCU, so countdown the restart interval
                if (--z->todo <= 0) {
                   if (z->code_bits < 24) stbi__grow_buffer_unsafe(z);
@@ -2974,6 +3249,7 @@ static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
                   stbi__jpeg_reset(z);
                }
             }
+            if (z->sink && !stbi__jpeg_stream_rows(z, (j+1) * 8 * z->img_v_max / z->img_comp[n].v)) return 0;
          }
          return 1;
       } else { // interleaved
@@ -2991,6 +3267,11 @@ static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
                         int x2 = (i*z->img_comp[n].h + x)*8;
                         int y2 = (j*z->img_comp[n].v + y)*8;
                         int ha = z->img_comp[n].ha;
+                        if (z->defer_idct) {
+                           short *coeff = z->img_comp[n].coeff + 64 * (x2/8 + (y2/8) * z->img_comp[n].coeff_w);
+                           if (!stbi__jpeg_decode_block(z, coeff, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+                           continue;
+                        }
                         if (!stbi__jpeg_decode_block(z, data, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
                         z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*y2+x2, z->img_comp[n].w2, data);
                      }
@@ -3004,6 +3285,7 @@ static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
                   stbi__jpeg_reset(z);
                }
             }
+            if (z->sink && !stbi__jpeg_stream_rows(z, (j+1) * z->img_mcu_h)) return 0;
          }
          return 1;
       }
@@ -3077,25 +3359,45 @@ static void stbi__jpeg_dequantize(short *data, stbi__uint16 *dequant)
       data[i] *= dequant[i];
 }
 
-static void stbi__jpeg_finish(stbi__jpeg *z)
+typedef struct
 {
-   if (z->progressive) {
-      // dequantize and idct the data
-      int i,j,n;
-      for (n=0; n < z->s->img_n; ++n) {
-         int w = (z->img_comp[n].x+7) >> 3;
-         int h = (z->img_comp[n].y+7) >> 3;
-         for (j=0; j < h; ++j) {
-            for (i=0; i < w; ++i) {
-               short *data = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
+   stbi__jpeg *z;
+   int tasks;
+} stbi__jpeg_finish_job;
+
+// one band of block rows of every component
+static void stbi__jpeg_finish_task(void *arg, int index)
+{
+   stbi__jpeg_finish_job *job = (stbi__jpeg_finish_job *) arg;
+   stbi__jpeg *z = job->z;
+   int i,j,n;
+   for (n=0; n < z->s->img_n; ++n) {
+      int w = (z->img_comp[n].x+7) >> 3;
+      int h = (z->img_comp[n].y+7) >> 3;
+      int j0 = h * index / job->tasks, j1 = h * (index+1) / job->tasks;
+      for (j=j0; j < j1; ++j) {
+         for (i=0; i < w; ++i) {
+            short *data = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
+            // baseline blocks were dequantized while decoding
+            if (z->progressive)
                stbi__jpeg_dequantize(data, z->dequant[z->img_comp[n].tq]);
-               z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
-            }
+            z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
          }
       }
    }
 }
 
+static void stbi__jpeg_finish(stbi__jpeg *z)
+{
+   if (z->progressive || z->defer_idct) {
+      // dequantize and idct the data
+      stbi__jpeg_finish_job job;
+      job.z = z;
+      job.tasks = stbi__parallel_tasks((size_t) z->s->img_x * z->s->img_y, STBI__JPEG_PARALLEL_MIN);
+      stbi__parallel_run(job.tasks, stbi__jpeg_finish_task, &job);
+   }
+}
+
 static int stbi__process_marker(stbi__jpeg *z, int m)
 {
    int L;
@@ -3309,6 +3611,10 @@ static int stbi__process_frame_header(stbi__jpeg *z, int scan)
       if (v_max % z->img_comp[i].v != 0) return stbi__err("bad V","Corrupt JPEG");
    }
 
+   // only worth the extra coefficient memory if the idct will actually be split. streaming
+   // needs the idct done as each MCU row is decoded
+   z->defer_idct = !z->sink && !z->progressive && stbi__parallel_tasks((size_t) s->img_x * s->img_y, STBI__JPEG_PARALLEL_MIN) > 1;
+
    // compute interleaved mcu info
    z->img_h_max = h_max;
    z->img_v_max = v_max;
@@ -3339,7 +3645,7 @@ static int stbi__process_frame_header(stbi__jpeg *z, int scan)
          return stbi__free_jpeg_components(z, i+1, stbi__err("outofmem", "Out of memory"));
       // align blocks for idct using mmx/sse
       z->img_comp[i].data = (stbi_uc*) (((size_t) z->img_comp[i].raw_data + 15) & ~15);
-      if (z->progressive) {
+      if (z->progressive || z->defer_idct) {
          // w2, h2 are multiples of 8 (see above)
          z->img_comp[i].coeff_w = z->img_comp[i].w2 / 8;
          z->img_comp[i].coeff_h = z->img_comp[i].h2 / 8;
@@ -3441,7 +3747,7 @@ static int stbi__decode_jpeg_image(stbi__jpeg *j)
          m = stbi__get_marker(j);
       }
    }
-   if (j->progressive)
+   if (j->progressive || j->defer_idct)
       stbi__jpeg_finish(j);
    return 1;
 }
@@ -3817,28 +4123,48 @@ static void stbi__YCbCr_to_RGB_simd(stbi_uc *out, stbi_uc const *y, stbi_uc cons
 }
 #endif
 
-// set up the kernels
-static void stbi__setup_jpeg(stbi__jpeg *j)
+STBIDEF void stbi_jpeg_builtin_kernels(stbi_jpeg_kernels *k, int simd)
 {
-   j->idct_block_kernel = stbi__idct_block;
-   j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_row;
-   j->resample_row_hv_2_kernel = stbi__resample_row_hv_2;
+   k->idct_block = stbi__idct_block;
+   k->YCbCr_to_RGB = stbi__YCbCr_to_RGB_row;
+   k->resample_row_hv_2 = stbi__resample_row_hv_2;
+   if (!simd) return;
 
 #ifdef STBI_SSE2
    if (stbi__sse2_available()) {
-      j->idct_block_kernel = stbi__idct_simd;
-      j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_simd;
-      j->resample_row_hv_2_kernel = stbi__resample_row_hv_2_simd;
+      k->idct_block = stbi__idct_simd;
+      k->YCbCr_to_RGB = stbi__YCbCr_to_RGB_simd;
+      k->resample_row_hv_2 = stbi__resample_row_hv_2_simd;
    }
 #endif
 
 #ifdef STBI_NEON
-   j->idct_block_kernel = stbi__idct_simd;
-   j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_simd;
-   j->resample_row_hv_2_kernel = stbi__resample_row_hv_2_simd;
+   k->idct_block = stbi__idct_simd;
+   k->YCbCr_to_RGB = stbi__YCbCr_to_RGB_simd;
+   k->resample_row_hv_2 = stbi__resample_row_hv_2_simd;
 #endif
 }
 
+static stbi_jpeg_kernels stbi__jpeg_user_kernels;
+
+STBIDEF void stbi_set_jpeg_kernels(const stbi_jpeg_kernels *k)
+{
+   if (k)
+      stbi__jpeg_user_kernels = *k;
+   else
+      memset(&stbi__jpeg_user_kernels, 0, sizeof(stbi__jpeg_user_kernels));
+}
+
+// set up the kernels
+static void stbi__setup_jpeg(stbi__jpeg *j)
+{
+   stbi_jpeg_kernels k;
+   stbi_jpeg_builtin_kernels(&k, 1);
+   j->idct_block_kernel = stbi__jpeg_user_kernels.idct_block ? stbi__jpeg_user_kernels.idct_block : k.idct_block;
+   j->YCbCr_to_RGB_kernel = stbi__jpeg_user_kernels.YCbCr_to_RGB ? stbi__jpeg_user_kernels.YCbCr_to_RGB : k.YCbCr_to_RGB;
+   j->resample_row_hv_2_kernel = stbi__jpeg_user_kernels.resample_row_hv_2 ? stbi__jpeg_user_kernels.resample_row_hv_2 : k.resample_row_hv_2;
+}
+
 // clean up the temporary component buffers
 static void stbi__cleanup_jpeg(stbi__jpeg *j)
 {
@@ -3862,161 +4188,249 @@ static stbi_uc stbi__blinn_8x8(stbi_uc x, stbi_uc y)
    return (stbi_uc) ((t + (t >>8)) >> 8);
 }
 
-static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp, int req_comp)
+typedef struct
 {
-   int n, decode_n, is_rgb;
-   z->s->img_n = 0; // make stbi__cleanup_jpeg safe
-
-   // validate req_comp
-   if (req_comp < 0 || req_comp > 4) return stbi__errpuc("bad req_comp", "Internal error");
-
-   // load a jpeg image from whichever source, but leave in YCbCr format
-   if (!stbi__decode_jpeg_image(z)) { stbi__cleanup_jpeg(z); return NULL; }
-
-   // determine actual number of components to generate
-   n = req_comp ? req_comp : z->s->img_n >= 3 ? 3 : 1;
-
-   is_rgb = z->s->img_n == 3 && (z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
-
-   if (z->s->img_n == 3 && n < 3 && !is_rgb)
-      decode_n = 1;
-   else
-      decode_n = z->s->img_n;
-
-   // nothing to do if no components requested; check this now to avoid
-   // accessing uninitialized coutput[0] later
-   if (decode_n <= 0) { stbi__cleanup_jpeg(z); return NULL; }
-
-   // resample and color-convert
-   {
-      int k;
-      unsigned int i,j;
-      stbi_uc *output;
-      stbi_uc *coutput[4] = { NULL, NULL, NULL, NULL };
-
-      stbi__resample res_comp[4];
-
+   stbi__jpeg *z;
+   stbi__resample res_comp[4];   // resampler state at row 0
+   stbi_uc *output;              // malloc'd result (z->dst == NULL), or a streamed band
+   unsigned int output_y0;       // image row of the first output row (streamed bands)
+   stbi_uc *scratch;             // per band: decode_n line buffers, then a spill row if n == 3
+   size_t scratch_band;
+   int n, decode_n, is_rgb, bands;
+} stbi__jpeg_rows_job;
+
+// resample and color-convert output rows [j0,j1). res_comp must be at row j0 and is left at j1;
+// scratch is one band's worth of job->scratch
+static void stbi__jpeg_rows(stbi__jpeg_rows_job *job, stbi__resample *res_comp, stbi_uc *scratch, unsigned int j0, unsigned int j1)
+{
+   stbi__jpeg *z = job->z;
+   int k, n = job->n, decode_n = job->decode_n, is_rgb = job->is_rgb;
+   unsigned int i,j;
+   stbi_uc *coutput[4] = { NULL, NULL, NULL, NULL };
+   stbi_uc *linebuf[4] = { NULL, NULL, NULL, NULL };
+   stbi_uc *spill = n == 3 ? scratch + (size_t) decode_n * (z->s->img_x + 3) : NULL;
+
+   for (k=0; k < decode_n; ++k)
+      linebuf[k] = scratch + (size_t) k * (z->s->img_x + 3);
+
+   for (j=j0; j < j1; ++j) {
+      stbi_uc *out = job->output + (size_t) n * z->s->img_x * (j - job->output_y0);
+      stbi_uc *spill_to = NULL;
+      // the n==3 paths below write one spare byte past each row. the malloc'd output reserves
+      // it after the last row; elsewhere it lands on the next row, which may belong to another
+      // band, so a band's last row goes through the spill row. in a caller's buffer it only
+      // lands on a row that is written later when rows are packed top-down; otherwise (padded
+      // stride, bottom-up) it would clobber caller memory, so every row spills
+      if (z->dst) {
+         unsigned int mem_row = z->dst_bottom_up ? z->s->img_y - 1 - j : j;
+         out = z->dst + (size_t) z->dst_stride * mem_row;
+         if (spill && (z->dst_bottom_up || z->dst_stride != n * (int) z->s->img_x || j == j1 - 1)) { spill_to = out; out = spill; }
+      } else if (spill && j == j1 - 1 && j1 < z->s->img_y) {
+         spill_to = out; out = spill;
+      }
       for (k=0; k < decode_n; ++k) {
          stbi__resample *r = &res_comp[k];
-
-         // allocate line buffer big enough for upsampling off the edges
-         // with upsample factor of 4
-         z->img_comp[k].linebuf = (stbi_uc *) stbi__malloc(z->s->img_x + 3);
-         if (!z->img_comp[k].linebuf) { stbi__cleanup_jpeg(z); return stbi__errpuc("outofmem", "Out of memory"); }
-
-         r->hs      = z->img_h_max / z->img_comp[k].h;
-         r->vs      = z->img_v_max / z->img_comp[k].v;
-         r->ystep   = r->vs >> 1;
-         r->w_lores = (z->s->img_x + r->hs-1) / r->hs;
-         r->ypos    = 0;
-         r->line0   = r->line1 = z->img_comp[k].data;
-
-         if      (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
-         else if (r->hs == 1 && r->vs == 2) r->resample = stbi__resample_row_v_2;
-         else if (r->hs == 2 && r->vs == 1) r->resample = stbi__resample_row_h_2;
-         else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
-         else                               r->resample = stbi__resample_row_generic;
-      }
-
-      // can't error after this so, this is safe
-      output = (stbi_uc *) stbi__malloc_mad3(n, z->s->img_x, z->s->img_y, 1);
-      if (!output) { stbi__cleanup_jpeg(z); return stbi__errpuc("outofmem", "Out of memory"); }
-
-      // now go ahead and resample
-      for (j=0; j < z->s->img_y; ++j) {
-         stbi_uc *out = output + n * z->s->img_x * j;
-         for (k=0; k < decode_n; ++k) {
-            stbi__resample *r = &res_comp[k];
-            int y_bot = r->ystep >= (r->vs >> 1);
-            coutput[k] = r->resample(z->img_comp[k].linebuf,
-                                     y_bot ? r->line1 : r->line0,
-                                     y_bot ? r->line0 : r->line1,
-                                     r->w_lores, r->hs);
-            if (++r->ystep >= r->vs) {
-               r->ystep = 0;
-               r->line0 = r->line1;
-               if (++r->ypos < z->img_comp[k].y)
-                  r->line1 += z->img_comp[k].w2;
-            }
+         int y_bot = r->ystep >= (r->vs >> 1);
+         coutput[k] = r->resample(linebuf[k],
+                                  y_bot ? r->line1 : r->line0,
+                                  y_bot ? r->line0 : r->line1,
+                                  r->w_lores, r->hs);
+         if (++r->ystep >= r->vs) {
+            r->ystep = 0;
+            r->line0 = r->line1;
+            if (++r->ypos < z->img_comp[k].y)
+               r->line1 += z->img_comp[k].w2;
          }
-         if (n >= 3) {
-            stbi_uc *y = coutput[0];
-            if (z->s->img_n == 3) {
-               if (is_rgb) {
-                  for (i=0; i < z->s->img_x; ++i) {
-                     out[0] = y[i];
-                     out[1] = coutput[1][i];
-                     out[2] = coutput[2][i];
-                     out[3] = 255;
-                     out += n;
-                  }
-               } else {
-                  z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-               }
-            } else if (z->s->img_n == 4) {
-               if (z->app14_color_transform == 0) { // CMYK
-                  for (i=0; i < z->s->img_x; ++i) {
-                     stbi_uc m = coutput[3][i];
-                     out[0] = stbi__blinn_8x8(coutput[0][i], m);
-                     out[1] = stbi__blinn_8x8(coutput[1][i], m);
-                     out[2] = stbi__blinn_8x8(coutput[2][i], m);
-                     out[3] = 255;
-                     out += n;
-                  }
-               } else if (z->app14_color_transform == 2) { // YCCK
-                  z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                  for (i=0; i < z->s->img_x; ++i) {
-                     stbi_uc m = coutput[3][i];
-                     out[0] = stbi__blinn_8x8(255 - out[0], m);
-                     out[1] = stbi__blinn_8x8(255 - out[1], m);
-                     out[2] = stbi__blinn_8x8(255 - out[2], m);
-                     out += n;
-                  }
-               } else { // YCbCr + alpha?  Ignore the fourth channel for now
-                  z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-               }
-            } else
+      }
+      if (n >= 3) {
+         stbi_uc *y = coutput[0];
+         if (z->s->img_n == 3) {
+            if (is_rgb) {
                for (i=0; i < z->s->img_x; ++i) {
-                  out[0] = out[1] = out[2] = y[i];
-                  out[3] = 255; // not used if n==3
+                  out[0] = y[i];
+                  out[1] = coutput[1][i];
+                  out[2] = coutput[2][i];
+                  out[3] = 255;
                   out += n;
                }
-         } else {
-            if (is_rgb) {
-               if (n == 1)
-                  for (i=0; i < z->s->img_x; ++i)
-                     *out++ = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-               else {
-                  for (i=0; i < z->s->img_x; ++i, out += 2) {
-                     out[0] = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-                     out[1] = 255;
-                  }
-               }
-            } else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
+            } else {
+               z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+            }
+         } else if (z->s->img_n == 4) {
+            if (z->app14_color_transform == 0) { // CMYK
                for (i=0; i < z->s->img_x; ++i) {
                   stbi_uc m = coutput[3][i];
-                  stbi_uc r = stbi__blinn_8x8(coutput[0][i], m);
-                  stbi_uc g = stbi__blinn_8x8(coutput[1][i], m);
-                  stbi_uc b = stbi__blinn_8x8(coutput[2][i], m);
-                  out[0] = stbi__compute_y(r, g, b);
-                  out[1] = 255;
+                  out[0] = stbi__blinn_8x8(coutput[0][i], m);
+                  out[1] = stbi__blinn_8x8(coutput[1][i], m);
+                  out[2] = stbi__blinn_8x8(coutput[2][i], m);
+                  out[3] = 255;
                   out += n;
                }
-            } else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
+            } else if (z->app14_color_transform == 2) { // YCCK
+               z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
                for (i=0; i < z->s->img_x; ++i) {
-                  out[0] = stbi__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
-                  out[1] = 255;
+                  stbi_uc m = coutput[3][i];
+                  out[0] = stbi__blinn_8x8(255 - out[0], m);
+                  out[1] = stbi__blinn_8x8(255 - out[1], m);
+                  out[2] = stbi__blinn_8x8(255 - out[2], m);
                   out += n;
                }
-            } else {
-               stbi_uc *y = coutput[0];
-               if (n == 1)
-                  for (i=0; i < z->s->img_x; ++i) out[i] = y[i];
-               else
-                  for (i=0; i < z->s->img_x; ++i) { *out++ = y[i]; *out++ = 255; }
+            } else { // YCbCr + alpha?  Ignore the fourth channel for now
+               z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+            }
+         } else
+            for (i=0; i < z->s->img_x; ++i) {
+               out[0] = out[1] = out[2] = y[i];
+               out[3] = 255; // not used if n==3
+               out += n;
+            }
+      } else {
+         if (is_rgb) {
+            if (n == 1)
+               for (i=0; i < z->s->img_x; ++i)
+                  *out++ = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
+            else {
+               for (i=0; i < z->s->img_x; ++i, out += 2) {
+                  out[0] = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
+                  out[1] = 255;
+               }
+            }
+         } else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
+            for (i=0; i < z->s->img_x; ++i) {
+               stbi_uc m = coutput[3][i];
+               stbi_uc r = stbi__blinn_8x8(coutput[0][i], m);
+               stbi_uc g = stbi__blinn_8x8(coutput[1][i], m);
+               stbi_uc b = stbi__blinn_8x8(coutput[2][i], m);
+               out[0] = stbi__compute_y(r, g, b);
+               if (n == 2) out[1] = 255; // n==1 has no spare byte here
+               out += n;
             }
+         } else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
+            for (i=0; i < z->s->img_x; ++i) {
+               out[0] = stbi__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
+               if (n == 2) out[1] = 255;
+               out += n;
+            }
+         } else {
+            stbi_uc *y = coutput[0];
+            if (n == 1)
+               for (i=0; i < z->s->img_x; ++i) out[i] = y[i];
+            else
+               for (i=0; i < z->s->img_x; ++i) { *out++ = y[i]; *out++ = 255; }
          }
       }
+      if (spill_to) memcpy(spill_to, spill, n * z->s->img_x);
+   }
+}
+
+// one band of output rows. bands are independent: each starts its own resamplers at the
+// band's first row, so the result doesn't depend on how rows are split
+static void stbi__jpeg_rows_task(void *arg, int index)
+{
+   stbi__jpeg_rows_job *job = (stbi__jpeg_rows_job *) arg;
+   stbi__jpeg *z = job->z;
+   int k;
+   unsigned int j;
+   unsigned int j0 = (unsigned int) ((size_t) z->s->img_y * index / job->bands);
+   unsigned int j1 = (unsigned int) ((size_t) z->s->img_y * (index+1) / job->bands);
+   stbi__resample res_comp[4];
+
+   memcpy(res_comp, job->res_comp, sizeof(res_comp));
+
+   // step the resamplers to the first row of the band (same stepping as stbi__jpeg_rows, no output)
+   for (j=0; j < j0; ++j) {
+      for (k=0; k < job->decode_n; ++k) {
+         stbi__resample *r = &res_comp[k];
+         if (++r->ystep >= r->vs) {
+            r->ystep = 0;
+            r->line0 = r->line1;
+            if (++r->ypos < z->img_comp[k].y)
+               r->line1 += z->img_comp[k].w2;
+         }
+      }
+   }
+   stbi__jpeg_rows(job, res_comp, job->scratch + job->scratch_band * index, j0, j1);
+}
+
+// output channels, the components to resample and their resamplers at row 0. 0 if there's
+// nothing to decode
+static int stbi__jpeg_rows_setup(stbi__jpeg *z, stbi__jpeg_rows_job *job, int req_comp)
+{
+   int k;
+   // determine actual number of components to generate
+   job->z = z;
+   job->n = req_comp ? req_comp : z->s->img_n >= 3 ? 3 : 1;
+   job->is_rgb = z->s->img_n == 3 && (z->rgb == 3 || (z->app14_color_transform == 0 && !z->jfif));
+
+   if (z->s->img_n == 3 && job->n < 3 && !job->is_rgb)
+      job->decode_n = 1;
+   else
+      job->decode_n = z->s->img_n;
+
+   // nothing to do if no components requested; check this now to avoid
+   // accessing uninitialized coutput[0] later
+   if (job->decode_n <= 0) return 0;
+
+   for (k=0; k < job->decode_n; ++k) {
+      stbi__resample *r = &job->res_comp[k];
+
+      r->hs      = z->img_h_max / z->img_comp[k].h;
+      r->vs      = z->img_v_max / z->img_comp[k].v;
+      r->ystep   = r->vs >> 1;
+      r->w_lores = (z->s->img_x + r->hs-1) / r->hs;
+      r->ypos    = 0;
+      r->line0   = r->line1 = z->img_comp[k].data;
+
+      if      (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
+      else if (r->hs == 1 && r->vs == 2) r->resample = stbi__resample_row_v_2;
+      else if (r->hs == 2 && r->vs == 1) r->resample = stbi__resample_row_h_2;
+      else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
+      else                               r->resample = stbi__resample_row_generic;
+   }
+   return 1;
+}
+
+static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp, int req_comp)
+{
+   z->s->img_n = 0; // make stbi__cleanup_jpeg safe
+
+   // validate req_comp
+   if (req_comp < 0 || req_comp > 4) return stbi__errpuc("bad req_comp", "Internal error");
+
+   // load a jpeg image from whichever source, but leave in YCbCr format
+   if (!stbi__decode_jpeg_image(z)) { stbi__cleanup_jpeg(z); return NULL; }
+
+   // resample and color-convert
+   {
+      stbi_uc *output;
+      stbi__jpeg_rows_job job;
+      int n, decode_n;
+
+      if (!stbi__jpeg_rows_setup(z, &job, req_comp)) { stbi__cleanup_jpeg(z); return NULL; }
+      n = job.n;
+      decode_n = job.decode_n;
+
+      // per band: line buffers big enough for upsampling off the edges with upsample factor
+      // of 4, plus a spill row for the n==3 spare byte
+      job.bands = stbi__parallel_tasks((size_t) z->s->img_x * z->s->img_y, STBI__JPEG_PARALLEL_MIN);
+      if (job.bands > (int) z->s->img_y) job.bands = (int) z->s->img_y;
+      job.scratch_band = (size_t) decode_n * (z->s->img_x + 3) + (n == 3 ? (size_t) n * z->s->img_x + 1 : 0);
+      job.scratch = (stbi_uc *) stbi__malloc(job.scratch_band * job.bands);
+      if (!job.scratch) { stbi__cleanup_jpeg(z); return stbi__errpuc("outofmem", "Out of memory"); }
+
+      if (z->dst) {
+         output = z->dst;
+      } else {
+         // can't error after this so, this is safe
+         output = (stbi_uc *) stbi__malloc_mad3(n, z->s->img_x, z->s->img_y, 1);
+         if (!output) { STBI_FREE(job.scratch); stbi__cleanup_jpeg(z); return stbi__errpuc("outofmem", "Out of memory"); }
+      }
+      job.output = output;
+      job.output_y0 = 0;
+
+      // now go ahead and resample
+      stbi__parallel_run(job.bands, stbi__jpeg_rows_task, &job);
+      STBI_FREE(job.scratch);
       stbi__cleanup_jpeg(z);
       *out_x = z->s->img_x;
       *out_y = z->s->img_y;
@@ -4025,6 +4439,88 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
    }
 }
 
+typedef struct
+{
+   stbi__jpeg_rows_job job;      // output is one band, allocated when streaming starts
+   stbi__resample res_comp[4];   // resamplers at row 'next'
+   unsigned int next;            // first row not handed out yet
+   int req_comp;
+} stbi__jpeg_stream;
+
+static int stbi__jpeg_stream_start(stbi__jpeg *z, stbi__jpeg_stream *st)
+{
+   stbi__jpeg_rows_job *job = &st->job;
+   if (!stbi__jpeg_rows_setup(z, job, st->req_comp)) return stbi__err("no components", "Corrupt JPEG");
+   memcpy(st->res_comp, job->res_comp, sizeof(st->res_comp));
+   job->bands = 1;
+   job->scratch_band = (size_t) job->decode_n * (z->s->img_x + 3) + (job->n == 3 ? (size_t) job->n * z->s->img_x + 1 : 0);
+   job->scratch = (stbi_uc *) stbi__malloc(job->scratch_band);
+   job->output = (stbi_uc *) stbi__malloc_mad3(job->n, z->s->img_x, z->sink->band_rows, 1);
+   if (!job->scratch || !job->output) return stbi__err("outofmem", "Out of memory");
+   return stbi__rowsink_begin(z->sink, z->s->img_x, z->s->img_y, z->s->img_n >= 3 ? 3 : 1, job->n);
+}
+
+// convert and hand out rows [next, end) in bands
+static int stbi__jpeg_stream_emit(stbi__jpeg *z, stbi__jpeg_stream *st, unsigned int end)
+{
+   while (st->next < end) {
+      unsigned int count = end - st->next < (unsigned int) z->sink->band_rows ? end - st->next : (unsigned int) z->sink->band_rows;
+      st->job.output_y0 = st->next;
+      stbi__jpeg_rows(&st->job, st->res_comp, st->job.scratch, st->next, st->next + count);
+      if (!stbi__rowsink_rows(z->sink, st->job.output, st->next, count)) return 0;
+      st->next += count;
+   }
+   return 1;
+}
+
+// called after each MCU row of a baseline scan; 'decoded' output rows have all their blocks.
+// rows need every component, and upsampling reads a row ahead, so stay one MCU row behind
+// and hand out whole bands only
+static int stbi__jpeg_stream_rows(stbi__jpeg *z, int decoded)
+{
+   stbi__jpeg_stream *st = (stbi__jpeg_stream *) z->stream;
+   unsigned int end, band = (unsigned int) z->sink->band_rows;
+   if (z->scan_n != z->s->img_n) return 1;
+   if (!st->job.output && !stbi__jpeg_stream_start(z, st)) return 0;
+   end = decoded > z->img_mcu_h ? (unsigned int) (decoded - z->img_mcu_h) : 0;
+   if (end > z->s->img_y) end = z->s->img_y;
+   if (end < st->next + band) return 1;
+   return stbi__jpeg_stream_emit(z, st, st->next + (end - st->next) / band * band);
+}
+
+static int stbi__jpeg_load_rows(stbi__context *s, stbi__rowsink *sink, int *x, int *y, int *comp, int req_comp)
+{
+   int ok;
+   stbi__jpeg_stream st;
+   stbi__jpeg *z;
+   if (req_comp < 0 || req_comp > 4) return stbi__err("bad req_comp", "Internal error");
+   z = (stbi__jpeg *) stbi__malloc(sizeof(stbi__jpeg));
+   if (!z) return stbi__err("outofmem", "Out of memory");
+   memset(z, 0, sizeof(stbi__jpeg));
+   memset(&st, 0, sizeof(st));
+   st.req_comp = req_comp;
+   z->s = s;
+   z->sink = sink;
+   z->stream = &st;
+   stbi__setup_jpeg(z);
+   z->s->img_n = 0; // make stbi__cleanup_jpeg safe
+
+   ok = stbi__decode_jpeg_image(z);
+   // progressive images start here; everything else has the rows after the last full band left
+   if (ok && !st.job.output) ok = stbi__jpeg_stream_start(z, &st);
+   if (ok) ok = stbi__jpeg_stream_emit(z, &st, z->s->img_y);
+   if (ok) {
+      *x = z->s->img_x;
+      *y = z->s->img_y;
+      if (comp) *comp = z->s->img_n >= 3 ? 3 : 1;
+   }
+   STBI_FREE(st.job.scratch);
+   STBI_FREE(st.job.output);
+   stbi__cleanup_jpeg(z);
+   STBI_FREE(z);
+   return ok;
+}
+
 static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__result_info *ri)
 {
    unsigned char* result;
@@ -4084,6 +4580,8 @@ static int stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp)
 //      - all output is written to a single output buffer (can malloc/realloc)
 //    performance
 //      - fast huffman
+//      - 64-bit bit buffer; the main loop refills once per symbol and decodes up to two
+//        literals per lookup from a wider table while input/output are far from the ends
 
 #ifndef STBI_NO_ZLIB
 
@@ -4092,6 +4590,27 @@ static int stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp)
 #define STBI__ZFAST_MASK  ((1 << STBI__ZFAST_BITS) - 1)
 #define STBI__ZNSYMS 288 // number of symbols in literal/length alphabet
 
+// wide tables for the fast loop, entries have code bits in 24-27 and a kind in 28-31: 0 = longer
+// code, 1 or 2 = that many literals (or one distance), 3 = length or end of block.
+// literal/length: symbol in bits 0-8, then either the second literal in 16-23 or, for lengths,
+// extra bits in 9-11 and base-3 in 16-23. distance: base in bits 0-15, extra bits in 16-19
+#define STBI__ZWIDE_BITS  11
+#define STBI__ZWIDE_MASK  ((1 << STBI__ZWIDE_BITS) - 1)
+
+static const int stbi__zlength_base[31] = {
+   3,4,5,6,7,8,9,10,11,13,
+   15,17,19,23,27,31,35,43,51,59,
+   67,83,99,115,131,163,195,227,258,0,0 };
+
+static const int stbi__zlength_extra[31]=
+{ 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0,0,0 };
+
+static const int stbi__zdist_base[32] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,
+257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577,0,0};
+
+static const int stbi__zdist_extra[32] =
+{ 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+
 // zlib-style huffman encoding
 // (jpegs packs from left, zlib from right, so can't share code)
 typedef struct
@@ -4168,6 +4687,44 @@ static int stbi__zbuild_huffman(stbi__zhuffman *z, const stbi_uc *sizelist, int
    return 1;
 }
 
+static stbi__uint32 stbi__zwide_entry(int sym, int s, int dist)
+{
+   stbi__uint32 e = (stbi__uint32) s << 24;
+   if (dist)
+      return sym < 30 ? e | (1u << 28) | ((stbi__uint32) stbi__zdist_extra[sym] << 16) | (stbi__uint32) stbi__zdist_base[sym] : 0;
+   if (sym < 256)
+      return e | (1u << 28) | (stbi__uint32) sym;
+   if (sym > 256 && sym < 286)
+      e |= ((stbi__uint32) (stbi__zlength_base[sym-257] - 3) << 16) | ((stbi__uint32) stbi__zlength_extra[sym-257] << 9);
+   return e | (3u << 28) | (stbi__uint32) sym;
+}
+
+// fill a wide table from the canonical code tables built by stbi__zbuild_huffman
+static void stbi__zbuild_wide(stbi__uint32 *wide, const stbi__zhuffman *z, int dist)
+{
+   int i,j,s;
+   memset(wide, 0, sizeof(wide[0]) << STBI__ZWIDE_BITS);
+   // single symbols
+   for (s=1; s <= STBI__ZWIDE_BITS; ++s) {
+      for (i=z->firstsymbol[s]; i < z->firstsymbol[s+1]; ++i) {
+         stbi__uint32 e = stbi__zwide_entry(z->value[i], s, dist);
+         for (j = stbi__bit_reverse(z->firstcode[s] + i - z->firstsymbol[s], s); j < (1 << STBI__ZWIDE_BITS); j += (1 << s))
+            wide[j] = e;
+      }
+   }
+   if (dist) return;
+   // a literal followed by another literal whose code fits in the remaining bits. going
+   // downwards, wide[j >> s] (< j) still holds its single-symbol entry
+   for (j=(1 << STBI__ZWIDE_BITS)-1; j >= 0; --j) {
+      stbi__uint32 e1 = wide[j], e2;
+      int s1 = (e1 >> 24) & 15;
+      if ((e1 >> 28) != 1) continue;
+      e2 = wide[j >> s1];
+      if ((e2 >> 28) != 1 || s1 + (int) ((e2 >> 24) & 15) > STBI__ZWIDE_BITS) continue;
+      wide[j] = (2u << 28) | ((stbi__uint32) (s1 + ((e2 >> 24) & 15)) << 24) | ((e2 & 255) << 16) | (e1 & 511);
+   }
+}
+
 // zlib-from-memory implementation for PNG reading
 //    because PNG allows splitting the zlib stream arbitrarily,
 //    and it's annoying structurally to have PNG call ZLIB call PNG,
@@ -4179,14 +4736,19 @@ typedef struct
    stbi_uc *zbuffer, *zbuffer_end;
    int num_bits;
    int hit_zeof_once;
-   stbi__uint32 code_buffer;
+   stbi__uint64 code_buffer;
 
    char *zout;
    char *zout_start;
    char *zout_end;
    int   z_expandable;
 
+   // optional, called after each block with all output so far (streamed PNG rows)
+   int (*progress)(void *user, stbi_uc *out, stbi__uint32 len);
+   void *progress_user;
+
    stbi__zhuffman z_length, z_distance;
+   stbi__uint32 z_length_wide[1 << STBI__ZWIDE_BITS], z_distance_wide[1 << STBI__ZWIDE_BITS];
 } stbi__zbuf;
 
 stbi_inline static int stbi__zeof(stbi__zbuf *z)
@@ -4202,31 +4764,38 @@ stbi_inline static stbi_uc stbi__zget8(stbi__zbuf *z)
 static void stbi__fill_bits(stbi__zbuf *z)
 {
    do {
-      if (z->code_buffer >= (1U << z->num_bits)) {
+      if (z->code_buffer >= ((stbi__uint64) 1 << z->num_bits)) {
         z->zbuffer = z->zbuffer_end;  /* treat this as EOF so we fail. */
         return;
       }
-      z->code_buffer |= (unsigned int) stbi__zget8(z) << z->num_bits;
+      // only real input goes in the buffer (uncompressed blocks hand leftover bytes back);
+      // callers supply the zero bits past the end
+      if (stbi__zeof(z)) return;
+      z->code_buffer |= (stbi__uint64) stbi__zget8(z) << z->num_bits;
       z->num_bits += 8;
-   } while (z->num_bits <= 24);
+   } while (z->num_bits < 56); // at most 63 bits, see stbi__parse_huffman_fast
 }
 
 stbi_inline static unsigned int stbi__zreceive(stbi__zbuf *z, int n)
 {
    unsigned int k;
-   if (z->num_bits < n) stbi__fill_bits(z);
-   k = z->code_buffer & ((1 << n) - 1);
+   if (z->num_bits < n) {
+      stbi__fill_bits(z);
+      if (z->num_bits < n) z->num_bits = n; // past the end reads as zeros
+   }
+   k = (unsigned int) (z->code_buffer & ((1 << n) - 1));
    z->code_buffer >>= n;
    z->num_bits -= n;
    return k;
 }
 
-static int stbi__zhuffman_decode_slowpath(stbi__zbuf *a, stbi__zhuffman *z)
+// decode a code longer than the fast table from the low 16 bits of 'bits'; sets *size
+static int stbi__zhuffman_decode_long(stbi__zhuffman *z, stbi__uint64 bits, int *size)
 {
    int b,s,k;
    // not resolved by fast table, so compute it the slow way
    // use jpeg approach, which requires MSbits at top
-   k = stbi__bit_reverse(a->code_buffer, 16);
+   k = stbi__bit_reverse((int) (bits & 0xffff), 16);
    for (s=STBI__ZFAST_BITS+1; ; ++s)
       if (k < z->maxcode[s])
          break;
@@ -4235,14 +4804,24 @@ static int stbi__zhuffman_decode_slowpath(stbi__zbuf *a, stbi__zhuffman *z)
    b = (k >> (16-s)) - z->firstcode[s] + z->firstsymbol[s];
    if (b >= STBI__ZNSYMS) return -1; // some data was corrupt somewhere!
    if (z->size[b] != s) return -1;  // was originally an assert, but report failure instead.
+   *size = s;
+   return z->value[b];
+}
+
+static int stbi__zhuffman_decode_slowpath(stbi__zbuf *a, stbi__zhuffman *z)
+{
+   int s, v = stbi__zhuffman_decode_long(z, a->code_buffer, &s);
+   if (v < 0) return -1;
    a->code_buffer >>= s;
    a->num_bits -= s;
-   return z->value[b];
+   return v;
 }
 
 stbi_inline static int stbi__zhuffman_decode(stbi__zbuf *a, stbi__zhuffman *z)
 {
    int b,s;
+   if (a->num_bits < 16)
+      stbi__fill_bits(a);
    if (a->num_bits < 16) {
       if (stbi__zeof(a)) {
          if (!a->hit_zeof_once) {
@@ -4256,11 +4835,9 @@ stbi_inline static int stbi__zhuffman_decode(stbi__zbuf *a, stbi__zhuffman *z)
             // out, this stream is actually prematurely terminated.
             return -1;
          }
-      } else {
-         stbi__fill_bits(a);
       }
    }
-   b = z->fast[a->code_buffer & STBI__ZFAST_MASK];
+   b = z->fast[(int) (a->code_buffer & STBI__ZFAST_MASK)];
    if (b) {
       s = b >> 9;
       a->code_buffer >>= s;
@@ -4292,25 +4869,126 @@ static int stbi__zexpand(stbi__zbuf *z, char *zout, int n)  // need to make room
    return 1;
 }
 
-static const int stbi__zlength_base[31] = {
-   3,4,5,6,7,8,9,10,11,13,
-   15,17,19,23,27,31,35,43,51,59,
-   67,83,99,115,131,163,195,227,258,0,0 };
-
-static const int stbi__zlength_extra[31]=
-{ 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0,0,0 };
-
-static const int stbi__zdist_base[32] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,
-257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577,0,0};
+// main loop, used while at least 8 input bytes and STBI__ZFAST_OUT output bytes remain: refills
+// 56+ bits once per symbol (a length/distance pair needs at most 15+5+15+13 = 48), so no
+// bounds or EOF checks per field. copies may write up to 15 bytes past the match.
+// returns 0 on error, 1 at end of block, 2 when the slow loop has to take over
+#define STBI__ZFAST_OUT (258 + 16)
+// building the wide tables costs about as much as decoding this much input the slow way
+#define STBI__ZWIDE_MIN_IN 1024
+
+static int stbi__parse_huffman_fast(stbi__zbuf *a, char **pzout)
+{
+   // all in locals, since stores through zout could alias anything in a
+   char *zout = *pzout, *zout_start = a->zout_start, *zout_end = a->zout_end;
+   const stbi_uc *in = a->zbuffer, *in_end = a->zbuffer_end;
+   const stbi__uint32 *lwide = a->z_length_wide, *dwide = a->z_distance_wide;
+   stbi__uint64 bits = a->code_buffer;
+   int num_bits = a->num_bits;
+   int result = 2;
+
+   while (in_end - in >= 8 && zout_end - zout >= STBI__ZFAST_OUT) {
+      stbi__uint64 word = (stbi__uint64) in[0]       | ((stbi__uint64) in[1] << 8)  |
+                          ((stbi__uint64) in[2] << 16) | ((stbi__uint64) in[3] << 24) |
+                          ((stbi__uint64) in[4] << 32) | ((stbi__uint64) in[5] << 40) |
+                          ((stbi__uint64) in[6] << 48) | ((stbi__uint64) in[7] << 56);
+      stbi__uint32 e;
+      int z, s, len, dist;
+      stbi_uc *p;
+
+      // take whole bytes up to 56..63 bits. bits above num_bits already hold the next input
+      // bits, so or-ing the same bytes in again is harmless
+      bits |= word << num_bits;
+      in += (63 - num_bits) >> 3;
+      num_bits |= 56;
+
+      e = lwide[(int) (bits & STBI__ZWIDE_MASK)];
+      if ((e >> 28) - 1 < 2) {
+         // one or two literals on the same path; a lone literal's second byte is overwritten
+         s = (e >> 24) & 15;
+         zout[0] = (char) e;
+         zout[1] = (char) (e >> 16);
+         zout += e >> 28;
+         bits >>= s; num_bits -= s;
+         continue;
+      }
+      if (!e) {
+         z = stbi__zhuffman_decode_long(&a->z_length, bits, &s);
+         if (z < 0) { result = stbi__err("bad huffman code","Corrupt PNG"); break; }
+         e = stbi__zwide_entry(z, s, 0);
+      }
+      s = (e >> 24) & 15;
+      z = e & 511;
+      bits >>= s; num_bits -= s;
+      if (z < 256) {
+         *zout++ = (char) z;
+         continue;
+      }
+      if (z == 256) { result = 1; break; }
+      if (z >= 286) { result = stbi__err("bad huffman code","Corrupt PNG"); break; }
+
+      // length and distance: code and extra bits come off in one shift each
+      s = (e >> 9) & 7;
+      len = (int) ((e >> 16) & 255) + 3 + (int) (bits & ((1 << s) - 1));
+      bits >>= s; num_bits -= s;
+
+      e = dwide[(int) (bits & STBI__ZWIDE_MASK)];
+      if (!e) {
+         z = stbi__zhuffman_decode_long(&a->z_distance, bits, &s);
+         if (z < 0 || z >= 30) { result = stbi__err("bad huffman code","Corrupt PNG"); break; }
+         e = stbi__zwide_entry(z, s, 1);
+      }
+      s = (e >> 24) & 15;
+      z = (e >> 16) & 15;
+      dist = (int) (e & 0xffff) + (int) ((bits >> s) & ((1u << z) - 1));
+      bits >>= s + z; num_bits -= s + z;
+      if (zout - zout_start < dist) { result = stbi__err("bad dist","Corrupt PNG"); break; }
+
+      p = (stbi_uc *) (zout - dist);
+      if (dist >= 8) {
+         // whole chunks no longer than dist, so the source never overlaps the chunk being
+         // written (nor, for 16, a store still in flight)
+         char *end = zout + len;
+         if (dist >= 16)
+            do { memcpy(zout, p, 16); zout += 16; p += 16; } while (zout < end);
+         else
+            do { memcpy(zout, p, 8); zout += 8; p += 8; } while (zout < end);
+         zout = end;
+      } else if (dist == 1) { // run of one byte; common in images.
+         memset(zout, *p, len);
+         zout += len;
+      } else {
+         do *zout++ = (char) *p++; while (--len);
+      }
+   }
 
-static const int stbi__zdist_extra[32] =
-{ 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+   a->zbuffer = (stbi_uc *) in;
+   a->code_buffer = bits & (((stbi__uint64) 1 << num_bits) - 1); // drop the read-ahead
+   a->num_bits = num_bits;
+   *pzout = zout;
+   return result;
+}
 
 static int stbi__parse_huffman_block(stbi__zbuf *a)
 {
    char *zout = a->zout;
+   int wide_built = 0;
    for(;;) {
-      int z = stbi__zhuffman_decode(a, &a->z_length);
+      int z;
+      if (a->zbuffer_end - a->zbuffer >= 8 && a->zout_end - zout >= STBI__ZFAST_OUT) {
+         // only blocks that reach the fast loop with enough input left pay for its tables
+         if (!wide_built && a->zbuffer_end - a->zbuffer >= STBI__ZWIDE_MIN_IN) {
+            stbi__zbuild_wide(a->z_length_wide, &a->z_length, 0);
+            stbi__zbuild_wide(a->z_distance_wide, &a->z_distance, 1);
+            wide_built = 1;
+         }
+         if (wide_built) {
+            z = stbi__parse_huffman_fast(a, &zout);
+            if (z == 0) return 0;
+            if (z == 1) { a->zout = zout; return 1; }
+         }
+      }
+      z = stbi__zhuffman_decode(a, &a->z_length);
       if (z < 256) {
          if (z < 0) return stbi__err("bad huffman code","Corrupt PNG"); // error in huffman codes
          if (zout >= a->zout_end) {
@@ -4414,12 +5092,20 @@ static int stbi__parse_uncompressed_block(stbi__zbuf *a)
       stbi__zreceive(a, a->num_bits & 7); // discard
    // drain the bit-packed data into header
    k = 0;
-   while (a->num_bits > 0) {
+   while (a->num_bits > 0 && k < 4) {
       header[k++] = (stbi_uc) (a->code_buffer & 255); // suppress MSVC run-time check
       a->code_buffer >>= 8;
       a->num_bits -= 8;
    }
    if (a->num_bits < 0) return stbi__err("zlib corrupt","Corrupt PNG");
+   // the 64-bit buffer can hold more than the header: give the rest back to the input
+   // (minus the 16 implicit zero bits added at EOF, which never came from it)
+   if (a->num_bits > 0) {
+      int keep = a->num_bits - (a->hit_zeof_once ? 16 : 0);
+      if (keep > 0) a->zbuffer -= keep >> 3;
+      a->code_buffer = 0;
+      a->num_bits = 0;
+   }
    // now fill header the normal way
    while (k < 4)
       header[k++] = stbi__zget8(a);
@@ -4503,6 +5189,7 @@ static int stbi__parse_zlib(stbi__zbuf *a, int parse_header)
          }
          if (!stbi__parse_huffman_block(a)) return 0;
       }
+      if (a->progress && !a->progress(a->progress_user, (stbi_uc *) a->zout_start, (stbi__uint32) (a->zout - a->zout_start))) return 0;
    } while (!final);
    return 1;
 }
@@ -4513,6 +5200,7 @@ static int stbi__do_zlib(stbi__zbuf *a, char *obuf, int olen, int exp, int parse
    a->zout       = obuf;
    a->zout_end   = obuf + olen;
    a->z_expandable = exp;
+   a->progress = NULL;
 
    return stbi__parse_zlib(a, parse_header);
 }
@@ -4632,6 +5320,7 @@ typedef struct
    stbi__context *s;
    stbi_uc *idata, *expanded, *out;
    int depth;
+   stbi__rowsink *sink;   // streaming output (stbi_load_rows_*), else NULL
 } stbi__png;
 
 
@@ -4669,6 +5358,154 @@ static int stbi__paeth(int a, int b, int c)
 
 static const stbi_uc stbi__depth_scale_table[9] = { 0, 0xff, 0x55, 0, 0x11, 0,0,0, 0x01 };
 
+#ifdef STBI_SSE2
+// one 1-, 3- or 4-byte pixel, without touching the bytes after it
+stbi_inline static int stbi__png_get_px(const stbi_uc *p, int bpp)
+{
+   int v;
+   if (bpp == 4)      memcpy(&v, p, 4);
+   else if (bpp == 3) v = p[0] | (p[1] << 8) | (p[2] << 16);
+   else               v = p[0];
+   return v;
+}
+
+stbi_inline static void stbi__png_put_px(stbi_uc *p, int v, int bpp)
+{
+   if (bpp == 4) memcpy(p, &v, 4);
+   else if (bpp == 3) { p[0] = (stbi_uc) v; p[1] = (stbi_uc) (v >> 8); p[2] = (stbi_uc) (v >> 16); }
+   else p[0] = (stbi_uc) v;
+}
+
+// x + stbi__paeth(a,b,c) in 16-bit lanes; the chain through a is a few ops long
+stbi_inline static __m128i stbi__png_paeth_sse2(__m128i a, __m128i b, __m128i c, __m128i x)
+{
+   __m128i thresh = _mm_sub_epi16(_mm_add_epi16(c, _mm_add_epi16(c, c)), _mm_add_epi16(a, b));
+   __m128i lo = _mm_min_epi16(a, b), hi = _mm_max_epi16(a, b);
+   __m128i m0 = _mm_cmpgt_epi16(hi, thresh), m1 = _mm_cmpgt_epi16(thresh, lo);
+   __m128i t0 = _mm_or_si128(_mm_andnot_si128(m0, lo), _mm_and_si128(m0, c));
+   __m128i t1 = _mm_or_si128(_mm_andnot_si128(m1, hi), _mm_and_si128(m1, t0));
+   return _mm_and_si128(_mm_add_epi16(x, t1), _mm_set1_epi16(0xff));
+}
+
+// two paeth rows back to back (1-, 3- or 4-byte pixels). the lower row runs one pixel behind, so
+// its b and c are the upper row's results from the step before; a pixel of each row shares
+// one register, which gives two independent a -> a chains
+static void stbi__png_paeth2_sse2(stbi_uc *cur, stbi_uc *next, const stbi_uc *prior, const stbi_uc *raw, const stbi_uc *raw_next, int nk, int bpp)
+{
+   __m128i zero = _mm_setzero_si128();
+   __m128i a = zero, c = zero; // upper row in lanes 0-3, lower row in 4-7
+   __m128i b = _mm_unpacklo_epi8(_mm_cvtsi32_si128(stbi__png_get_px(prior, bpp)), zero);
+   int k;
+   for (k=0; k <= nk; k += bpp) {
+      // upper row at pixel k, lower row at pixel k-bpp
+      int x0 = k < nk ? stbi__png_get_px(raw + k, bpp) : 0;
+      int x1 = k > 0 ? stbi__png_get_px(raw_next + k - bpp, bpp) : 0;
+      __m128i x = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(x0), _mm_cvtsi32_si128(x1)), zero);
+      __m128i n = stbi__png_paeth_sse2(a, b, c, x), p = _mm_packus_epi16(n, n);
+      if (k < nk) stbi__png_put_px(cur + k, _mm_cvtsi128_si32(p), bpp);
+      if (k > 0)  stbi__png_put_px(next + k - bpp, _mm_cvtsi128_si32(_mm_srli_si128(p, 4)), bpp);
+      else        n = _mm_unpacklo_epi64(n, zero); // lower row starts with a = 0
+      c = _mm_unpacklo_epi64(b, a);
+      b = _mm_unpacklo_epi64(_mm_unpacklo_epi8(_mm_cvtsi32_si128(k + bpp < nk ? stbi__png_get_px(prior + k + bpp, bpp) : 0), zero), n);
+      a = n;
+   }
+}
+#endif
+
+// undo one row's filter. prior is only read when filter uses it (never on the first row).
+// simd is stbi__sse2_available(), checked once per image
+static void stbi__png_unfilter_row(stbi_uc *cur, const stbi_uc *prior, const stbi_uc *raw, int nk, int filter_bytes, int filter, int simd)
+{
+   int k = 0;
+   STBI_NOTUSED(simd);
+
+#ifdef STBI_SSE2
+   // up has no dependency between bytes: 16 at a time. sub/avg/paeth depend on the pixel to
+   // the left, so for 3- and 4-byte pixels they go one step at a time in a register (sub
+   // with a prefix sum over 4 pixels); other pixel sizes stay on the C loops below
+   if (simd) {
+      __m128i zero = _mm_setzero_si128();
+      if (filter == STBI__F_up) {
+         for (; k + 16 <= nk; k += 16)
+            _mm_storeu_si128((__m128i *) (cur + k), _mm_add_epi8(_mm_loadu_si128((const __m128i *) (raw + k)),
+                                                                 _mm_loadu_si128((const __m128i *) (prior + k))));
+      } else if (filter == STBI__F_sub && filter_bytes == 4) {
+         __m128i last = zero;
+         for (; k + 16 <= nk; k += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i *) (raw + k));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi8(x, last);
+            _mm_storeu_si128((__m128i *) (cur + k), x);
+            last = _mm_shuffle_epi32(x, 0xff);
+         }
+      } else if (filter == STBI__F_sub && filter_bytes == 3) {
+         // 4 pixels (12 bytes) per step; the 4 bytes stored past them are rewritten next step
+         __m128i last = zero, mask = _mm_setr_epi32(0xffffff, 0, 0, 0);
+         for (; k + 16 <= nk; k += 12) {
+            __m128i x = _mm_loadu_si128((const __m128i *) (raw + k)), t;
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 3));
+            x = _mm_add_epi8(x, _mm_slli_si128(x, 6));
+            x = _mm_add_epi8(x, last);
+            _mm_storeu_si128((__m128i *) (cur + k), x);
+            t = _mm_and_si128(_mm_srli_si128(x, 9), mask);
+            t = _mm_or_si128(t, _mm_slli_si128(t, 3));
+            last = _mm_or_si128(t, _mm_slli_si128(t, 6));
+         }
+      } else if ((filter == STBI__F_avg || filter == STBI__F_paeth) && (filter_bytes == 3 || filter_bytes == 4)) {
+         __m128i a = zero, c = zero; // left and upper-left pixel, 16 bits per channel
+         __m128i one = _mm_set1_epi16(1);
+         for (; k < nk; k += filter_bytes) {
+            __m128i b = _mm_unpacklo_epi8(_mm_cvtsi32_si128(stbi__png_get_px(prior + k, filter_bytes)), zero);
+            __m128i x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(stbi__png_get_px(raw + k, filter_bytes)), zero);
+            if (filter == STBI__F_avg) {
+               // floor((a + b) / 2): pavg rounds up, so take off the odd bit
+               __m128i d = _mm_sub_epi16(_mm_avg_epu16(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+               a = _mm_and_si128(_mm_add_epi16(x, d), _mm_set1_epi16(0xff));
+            } else {
+               a = stbi__png_paeth_sse2(a, b, c, x);
+               c = b;
+            }
+            stbi__png_put_px(cur + k, _mm_cvtsi128_si32(_mm_packus_epi16(a, a)), filter_bytes);
+         }
+      }
+   }
+#endif
+
+   switch (filter) {
+   case STBI__F_none:
+      memcpy(cur, raw, nk);
+      break;
+   case STBI__F_sub:
+      for (; k < filter_bytes; ++k)
+         cur[k] = raw[k];
+      for (; k < nk; ++k)
+         cur[k] = STBI__BYTECAST(raw[k] + cur[k-filter_bytes]);
+      break;
+   case STBI__F_up:
+      for (; k < nk; ++k)
+         cur[k] = STBI__BYTECAST(raw[k] + prior[k]);
+      break;
+   case STBI__F_avg:
+      for (; k < filter_bytes; ++k)
+         cur[k] = STBI__BYTECAST(raw[k] + (prior[k]>>1));
+      for (; k < nk; ++k)
+         cur[k] = STBI__BYTECAST(raw[k] + ((prior[k] + cur[k-filter_bytes])>>1));
+      break;
+   case STBI__F_paeth:
+      for (; k < filter_bytes; ++k)
+         cur[k] = STBI__BYTECAST(raw[k] + prior[k]); // prior[k] == stbi__paeth(0,prior[k],0)
+      for (; k < nk; ++k)
+         cur[k] = STBI__BYTECAST(raw[k] + stbi__paeth(cur[k-filter_bytes], prior[k], prior[k-filter_bytes]));
+      break;
+   case STBI__F_avg_first:
+      memcpy(cur, raw, filter_bytes);
+      for (k = filter_bytes; k < nk; ++k)
+         cur[k] = STBI__BYTECAST(raw[k] + (cur[k-filter_bytes] >> 1));
+      break;
+   }
+}
+
 // adds an extra all-255 alpha channel
 // dest == src is legal
 // img_n must be 1 or 3
@@ -4692,96 +5529,92 @@ static void stbi__create_png_alpha_expand8(stbi_uc *dest, stbi_uc *src, stbi__ui
    }
 }
 
-// create the png data from post-deflated data
-static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 raw_len, int out_n, stbi__uint32 x, stbi__uint32 y, int depth, int color)
+typedef struct
 {
-   int bytes = (depth == 16 ? 2 : 1);
-   stbi__context *s = a->s;
-   stbi__uint32 i,j,stride = x*out_n*bytes;
-   stbi__uint32 img_len, img_width_bytes;
+   stbi__uint32 x, y, j, stride, img_width_bytes;
+   int img_n, out_n, depth, color, filter_bytes, width, in_place, next_done, simd;
    stbi_uc *filter_buf;
-   int all_ok = 1;
-   int k;
-   int img_n = s->img_n; // copy it into a local for later
+} stbi__png_unfilter;
 
-   int output_bytes = out_n*bytes;
-   int filter_bytes = img_n*bytes;
-   int width = x;
+// check the sizes of an x*y image (or interlace pass) and set up unfiltering from its first row
+static int stbi__png_unfilter_begin(stbi__png_unfilter *u, int img_n, int out_n, stbi__uint32 x, stbi__uint32 y, int depth, int color)
+{
+   int bytes = (depth == 16 ? 2 : 1);
 
-   STBI_ASSERT(out_n == s->img_n || out_n == s->img_n+1);
-   a->out = (stbi_uc *) stbi__malloc_mad3(x, y, output_bytes, 0); // extra bytes to write off the end into
-   if (!a->out) return stbi__err("outofmem", "Out of memory");
+   STBI_ASSERT(out_n == img_n || out_n == img_n+1);
+   u->x = x;
+   u->y = y;
+   u->j = 0;
+   u->stride = x*out_n*bytes;
+   u->img_n = img_n;
+   u->out_n = out_n;
+   u->depth = depth;
+   u->color = color;
+   u->filter_bytes = img_n*bytes;
+   u->width = x;
+   u->in_place = depth == 8 && img_n == out_n;
+   u->next_done = 0;
+   u->simd = 0;
+   u->filter_buf = NULL;
 
-   // note: error exits here don't need to clean up a->out individually,
-   // stbi__do_png always does on error.
    if (!stbi__mad3sizes_valid(img_n, x, depth, 7)) return stbi__err("too large", "Corrupt PNG");
-   img_width_bytes = (((img_n * x * depth) + 7) >> 3);
-   if (!stbi__mad2sizes_valid(img_width_bytes, y, img_width_bytes)) return stbi__err("too large", "Corrupt PNG");
-   img_len = (img_width_bytes + 1) * y;
-
-   // we used to check for exact match between raw_len and img_len on non-interlaced PNGs,
-   // but issue #276 reported a PNG in the wild that had extra data at the end (all zeros),
-   // so just check for raw_len < img_len always.
-   if (raw_len < img_len) return stbi__err("not enough pixels","Corrupt PNG");
+   u->img_width_bytes = (((img_n * x * depth) + 7) >> 3);
+   if (!stbi__mad2sizes_valid(u->img_width_bytes, y, u->img_width_bytes)) return stbi__err("too large", "Corrupt PNG");
 
    // Allocate two scan lines worth of filter workspace buffer.
-   filter_buf = (stbi_uc *) stbi__malloc_mad2(img_width_bytes, 2, 0);
-   if (!filter_buf) return stbi__err("outofmem", "Out of memory");
+   u->filter_buf = (stbi_uc *) stbi__malloc_mad2(u->img_width_bytes, 2, 0);
+   if (!u->filter_buf) return stbi__err("outofmem", "Out of memory");
 
    // Filtering for low-bit-depth images
    if (depth < 8) {
-      filter_bytes = 1;
-      width = img_width_bytes;
+      u->filter_bytes = 1;
+      u->width = u->img_width_bytes;
    }
 
-   for (j=0; j < y; ++j) {
-      // cur/prior filter buffers alternate
-      stbi_uc *cur = filter_buf + (j & 1)*img_width_bytes;
-      stbi_uc *prior = filter_buf + (~j & 1)*img_width_bytes;
-      stbi_uc *dest = a->out + stride*j;
-      int nk = width * filter_bytes;
+#ifdef STBI_SSE2
+   u->simd = stbi__sse2_available();
+#endif
+   return 1;
+}
+
+// unfilter and expand the next count rows. raw is the first row's filter byte and dest its output
+// row, later rows follow at u->stride. cur/prior filter buffers alternate, except that 8-bit rows
+// that need no conversion are unfiltered straight into the output with the row above dest as
+// prior, so that row must hold the previous output row
+static int stbi__png_unfilter_rows(stbi__png_unfilter *u, stbi_uc *raw, stbi_uc *dest, stbi__uint32 count)
+{
+   stbi__uint32 i, j, end = u->j + count;
+   stbi__uint32 x = u->x, stride = u->stride, img_width_bytes = u->img_width_bytes;
+   int img_n = u->img_n, out_n = u->out_n, depth = u->depth, color = u->color;
+   int filter_bytes = u->filter_bytes, in_place = u->in_place, simd = u->simd;
+
+   for (j=u->j; j < end; ++j, dest += stride) {
+      stbi_uc *cur = in_place ? dest : u->filter_buf + (j & 1)*img_width_bytes;
+      stbi_uc *prior = in_place ? dest - stride : u->filter_buf + (~j & 1)*img_width_bytes;
+      int nk = u->width * filter_bytes;
       int filter = *raw++;
 
       // check filter type
-      if (filter > 4) {
-         all_ok = stbi__err("invalid filter","Corrupt PNG");
-         break;
-      }
+      if (filter > 4) return stbi__err("invalid filter","Corrupt PNG");
 
       // if first row, use special filter that doesn't sample previous row
       if (j == 0) filter = first_row_filter[filter];
 
       // perform actual filtering
-      switch (filter) {
-      case STBI__F_none:
-         memcpy(cur, raw, nk);
-         break;
-      case STBI__F_sub:
-         memcpy(cur, raw, filter_bytes);
-         for (k = filter_bytes; k < nk; ++k)
-            cur[k] = STBI__BYTECAST(raw[k] + cur[k-filter_bytes]);
-         break;
-      case STBI__F_up:
-         for (k = 0; k < nk; ++k)
-            cur[k] = STBI__BYTECAST(raw[k] + prior[k]);
-         break;
-      case STBI__F_avg:
-         for (k = 0; k < filter_bytes; ++k)
-            cur[k] = STBI__BYTECAST(raw[k] + (prior[k]>>1));
-         for (k = filter_bytes; k < nk; ++k)
-            cur[k] = STBI__BYTECAST(raw[k] + ((prior[k] + cur[k-filter_bytes])>>1));
-         break;
-      case STBI__F_paeth:
-         for (k = 0; k < filter_bytes; ++k)
-            cur[k] = STBI__BYTECAST(raw[k] + prior[k]); // prior[k] == stbi__paeth(0,prior[k],0)
-         for (k = filter_bytes; k < nk; ++k)
-            cur[k] = STBI__BYTECAST(raw[k] + stbi__paeth(cur[k-filter_bytes], prior[k], prior[k-filter_bytes]));
-         break;
-      case STBI__F_avg_first:
-         memcpy(cur, raw, filter_bytes);
-         for (k = filter_bytes; k < nk; ++k)
-            cur[k] = STBI__BYTECAST(raw[k] + (cur[k-filter_bytes] >> 1));
-         break;
+      if (u->next_done) {
+         u->next_done = 0; // already unfiltered together with the row above
+      } else {
+#ifdef STBI_SSE2
+         // the next row's cur is this row's prior only in the filter_buf case, and that
+         // pixel has been read by the time it is written
+         if (filter == STBI__F_paeth && filter_bytes != 2 && filter_bytes <= 4 && j+1 < end &&
+             raw[nk] == STBI__F_paeth && simd) {
+            stbi_uc *next = in_place ? dest + stride : prior;
+            stbi__png_paeth2_sse2(cur, next, prior, raw, raw + nk + 1, nk, filter_bytes);
+            u->next_done = 1;
+         } else
+#endif
+         stbi__png_unfilter_row(cur, prior, raw, nk, filter_bytes, filter, simd);
       }
 
       raw += nk;
@@ -4820,9 +5653,7 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
          if (img_n != out_n)
             stbi__create_png_alpha_expand8(dest, dest, x, img_n);
       } else if (depth == 8) {
-         if (img_n == out_n)
-            memcpy(dest, cur, x*img_n);
-         else
+         if (!in_place)
             stbi__create_png_alpha_expand8(dest, cur, x, img_n);
       } else if (depth == 16) {
          // convert the image data from big-endian to platform-native
@@ -4851,11 +5682,54 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
          }
       }
    }
+   u->j = end;
+   return 1;
+}
+
+// create the png data from post-deflated data
+static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 raw_len, int out_n, stbi__uint32 x, stbi__uint32 y, int depth, int color)
+{
+   stbi__png_unfilter u;
+   int ok;
 
-   STBI_FREE(filter_buf);
-   if (!all_ok) return 0;
+   a->out = (stbi_uc *) stbi__malloc_mad3(x, y, out_n*(depth == 16 ? 2 : 1), 0); // extra bytes to write off the end into
+   if (!a->out) return stbi__err("outofmem", "Out of memory");
 
-   return 1;
+   // note: error exits here don't need to clean up a->out individually,
+   // stbi__do_png always does on error.
+   if (!stbi__png_unfilter_begin(&u, a->s->img_n, out_n, x, y, depth, color)) { STBI_FREE(u.filter_buf); return 0; }
+
+   // we used to check for exact match between raw_len and img_len on non-interlaced PNGs,
+   // but issue #276 reported a PNG in the wild that had extra data at the end (all zeros),
+   // so just check for raw_len < img_len always.
+   if (raw_len < (u.img_width_bytes + 1) * y)
+      ok = stbi__err("not enough pixels","Corrupt PNG");
+   else
+      ok = stbi__png_unfilter_rows(&u, raw, a->out, y);
+
+   STBI_FREE(u.filter_buf);
+   return ok;
+}
+
+// bytes in the filtered image data: a filter byte plus packed samples per row, over all 7
+// passes when interlaced (empty passes have no rows)
+static stbi__uint32 stbi__png_raw_size(stbi__uint32 img_x, stbi__uint32 img_y, int img_n, int depth, int interlaced)
+{
+   static const int xorig[] = { 0,4,0,2,0,1,0 };
+   static const int yorig[] = { 0,0,4,0,2,0,1 };
+   static const int xspc[]  = { 8,8,4,4,2,2,1 };
+   static const int yspc[]  = { 8,8,8,4,4,2,2 };
+   stbi__uint32 total = 0;
+   int p;
+   if (!interlaced)
+      return ((img_x * img_n * depth + 7) >> 3) * img_y + img_y;
+   for (p=0; p < 7; ++p) {
+      stbi__uint32 x = (img_x - xorig[p] + xspc[p]-1) / xspc[p];
+      stbi__uint32 y = (img_y - yorig[p] + yspc[p]-1) / yspc[p];
+      if (img_x > (stbi__uint32) xorig[p] && img_y > (stbi__uint32) yorig[p])
+         total += ((x * img_n * depth + 7) >> 3) * y + y;
+   }
+   return total;
 }
 
 static int stbi__create_png_image(stbi__png *a, stbi_uc *image_data, stbi__uint32 image_data_len, int out_n, int depth, int color, int interlaced)
@@ -4903,11 +5777,9 @@ static int stbi__create_png_image(stbi__png *a, stbi_uc *image_data, stbi__uint3
    return 1;
 }
 
-static int stbi__compute_transparency(stbi__png *z, stbi_uc tc[3], int out_n)
+static void stbi__compute_transparency_px(stbi_uc *p, stbi__uint32 pixel_count, stbi_uc tc[3], int out_n)
 {
-   stbi__context *s = z->s;
-   stbi__uint32 i, pixel_count = s->img_x * s->img_y;
-   stbi_uc *p = z->out;
+   stbi__uint32 i;
 
    // compute color-based transparency, assuming we've
    // already got 255 as the alpha value in the output
@@ -4925,6 +5797,11 @@ static int stbi__compute_transparency(stbi__png *z, stbi_uc tc[3], int out_n)
          p += 4;
       }
    }
+}
+
+static int stbi__compute_transparency(stbi__png *z, stbi_uc tc[3], int out_n)
+{
+   stbi__compute_transparency_px(z->out, z->s->img_x * z->s->img_y, tc, out_n);
    return 1;
 }
 
@@ -4953,16 +5830,9 @@ static int stbi__compute_transparency16(stbi__png *z, stbi__uint16 tc[3], int ou
    return 1;
 }
 
-static int stbi__expand_png_palette(stbi__png *a, stbi_uc *palette, int len, int pal_img_n)
+static void stbi__expand_png_palette_px(stbi_uc *p, const stbi_uc *orig, stbi__uint32 pixel_count, const stbi_uc *palette, int pal_img_n)
 {
-   stbi__uint32 i, pixel_count = a->s->img_x * a->s->img_y;
-   stbi_uc *p, *temp_out, *orig = a->out;
-
-   p = (stbi_uc *) stbi__malloc_mad2(pixel_count, pal_img_n, 0);
-   if (p == NULL) return stbi__err("outofmem", "Out of memory");
-
-   // between here and free(out) below, exitting would leak
-   temp_out = p;
+   stbi__uint32 i;
 
    if (pal_img_n == 3) {
       for (i=0; i < pixel_count; ++i) {
@@ -4982,8 +5852,17 @@ static int stbi__expand_png_palette(stbi__png *a, stbi_uc *palette, int len, int
          p += 4;
       }
    }
+}
+
+static int stbi__expand_png_palette(stbi__png *a, stbi_uc *palette, int len, int pal_img_n)
+{
+   stbi__uint32 pixel_count = a->s->img_x * a->s->img_y;
+   stbi_uc *p = (stbi_uc *) stbi__malloc_mad2(pixel_count, pal_img_n, 0);
+   if (p == NULL) return stbi__err("outofmem", "Out of memory");
+
+   stbi__expand_png_palette_px(p, a->out, pixel_count, palette, pal_img_n);
    STBI_FREE(a->out);
-   a->out = temp_out;
+   a->out = p;
 
    STBI_NOTUSED(len);
 
@@ -5073,6 +5952,121 @@ static void stbi__de_iphone(stbi__png *z)
    }
 }
 
+typedef struct
+{
+   stbi__png *z;
+   stbi__png_unfilter u;
+   stbi__uint32 row_bytes;   // filter byte + packed samples
+   stbi__uint32 band_y0;     // image row in band row 1; row 0 keeps the row above for in-place unfiltering
+   stbi_uc *band;            // 1 + band_rows rows of u.out_n channels
+   stbi_uc *pal, *conv;      // palette-expanded and converted band, when needed
+   stbi_uc *palette, *tc;
+   int pal_n, has_trans, n;  // pal_n: channels after palette expansion (0 = no palette); n: channels handed out
+} stbi__png_stream;
+
+// finish the rows unfiltered since the last band (transparency, palette, channel conversion) and hand them out
+static int stbi__png_stream_flush(stbi__png_stream *st)
+{
+   stbi__uint32 count = st->u.j - st->band_y0, px = count * st->u.x;
+   stbi_uc *rows = st->band + st->u.stride;
+   int n = st->u.out_n;
+   if (!count) return 1;
+   if (st->has_trans) stbi__compute_transparency_px(rows, px, st->tc, n);
+   if (st->pal_n) {
+      stbi__expand_png_palette_px(st->pal, rows, px, st->palette, st->pal_n);
+      rows = st->pal;
+      n = st->pal_n;
+   }
+   if (n != st->n) {
+      if (!stbi__convert_format_rows(st->conv, rows, n, st->n, st->u.x, count)) return 0;
+      rows = st->conv;
+   }
+   if (!stbi__rowsink_rows(st->z->sink, rows, (int) st->band_y0, (int) count)) return 0;
+   memcpy(st->band, st->band + (size_t) st->u.stride * count, st->u.stride);
+   st->band_y0 = st->u.j;
+   return 1;
+}
+
+// zlib progress: unfilter every row that is complete in the output so far
+static int stbi__png_stream_progress(void *user, stbi_uc *out, stbi__uint32 len)
+{
+   stbi__png_stream *st = (stbi__png_stream *) user;
+   stbi__uint32 band_rows = (stbi__uint32) st->z->sink->band_rows;
+   stbi__uint32 avail = len / st->row_bytes;
+   if (avail > st->u.y) avail = st->u.y;
+   while (st->u.j < avail) {
+      stbi__uint32 room = st->band_y0 + band_rows - st->u.j;
+      stbi__uint32 count = avail - st->u.j < room ? avail - st->u.j : room;
+      if (!stbi__png_unfilter_rows(&st->u, out + (size_t) st->row_bytes * st->u.j,
+                                   st->band + (size_t) st->u.stride * (1 + st->u.j - st->band_y0), count)) return 0;
+      if (st->u.j - st->band_y0 == band_rows && !stbi__png_stream_flush(st)) return 0;
+   }
+   return 1;
+}
+
+// non-interlaced 8-bit-or-less image: inflate, unfilter and hand out rows as the data arrives,
+// with band-sized buffers instead of the full image (the inflated data is still whole, zlib
+// reads its window from it)
+static int stbi__png_stream_image(stbi__png *z, stbi__uint32 idata_len, int req_comp, int color, stbi_uc *palette, int pal_img_n, int has_trans, stbi_uc tc[3])
+{
+   stbi__context *s = z->s;
+   stbi__png_stream st;
+   stbi__zbuf *a;
+   stbi__uint32 raw_len, band_rows = (stbi__uint32) z->sink->band_rows;
+   int ok, out_n, comp;
+
+   if ((req_comp == s->img_n+1 && req_comp != 3 && !pal_img_n) || has_trans)
+      out_n = s->img_n+1;
+   else
+      out_n = s->img_n;
+   memset(&st, 0, sizeof(st));
+   st.z = z;
+   st.palette = palette;
+   st.tc = tc;
+   st.has_trans = has_trans;
+   st.pal_n = pal_img_n ? (req_comp >= 3 ? req_comp : pal_img_n) : 0;
+   comp = pal_img_n ? pal_img_n : s->img_n + (has_trans ? 1 : 0);
+   st.n = req_comp ? req_comp : st.pal_n ? st.pal_n : out_n;
+
+   a = (stbi__zbuf *) stbi__malloc(sizeof(stbi__zbuf));
+   if (!a) return stbi__err("outofmem", "Out of memory");
+   ok = stbi__png_unfilter_begin(&st.u, s->img_n, out_n, s->img_x, s->img_y, z->depth, color);
+   if (ok) {
+      st.row_bytes = st.u.img_width_bytes + 1;
+      st.band = (stbi_uc *) stbi__malloc_mad2(st.u.stride, band_rows + 1, 0);
+      if (st.pal_n) st.pal = (stbi_uc *) stbi__malloc_mad3(s->img_x, band_rows, st.pal_n, 0);
+      if (st.n != (st.pal_n ? st.pal_n : out_n)) st.conv = (stbi_uc *) stbi__malloc_mad3(s->img_x, band_rows, st.n, 0);
+      raw_len = stbi__png_raw_size(s->img_x, s->img_y, s->img_n, z->depth, 0) + STBI__ZFAST_OUT;
+      z->expanded = (stbi_uc *) stbi__malloc(raw_len);
+      if (!st.band || (st.pal_n && !st.pal) || (st.n != (st.pal_n ? st.pal_n : out_n) && !st.conv) || !z->expanded)
+         ok = stbi__err("outofmem", "Out of memory");
+   }
+   if (ok) ok = stbi__rowsink_begin(z->sink, s->img_x, s->img_y, comp, st.n);
+   if (ok) {
+      a->zbuffer = z->idata;
+      a->zbuffer_end = z->idata + idata_len;
+      a->zout_start = a->zout = (char *) z->expanded;
+      a->zout_end = (char *) z->expanded + raw_len;
+      a->z_expandable = 1;
+      a->progress = stbi__png_stream_progress;
+      a->progress_user = &st;
+      ok = stbi__parse_zlib(a, 1);
+      z->expanded = (stbi_uc *) a->zout_start; // may have grown for trailing data
+      if (ok && st.u.j < st.u.y) ok = stbi__err("not enough pixels","Corrupt PNG");
+      if (ok) ok = stbi__png_stream_flush(&st);
+   }
+   STBI_FREE(a);
+   STBI_FREE(st.u.filter_buf);
+   STBI_FREE(st.band);
+   STBI_FREE(st.pal);
+   STBI_FREE(st.conv);
+   if (ok) {
+      s->img_n = comp;
+      s->img_out_n = st.n;
+   }
+   return ok;
+}
+
 #define STBI__PNG_TYPE(a,b,c,d)  (((unsigned) (a) << 24) + ((unsigned) (b) << 16) + ((unsigned) (c) << 8) + (unsigned) (d))
 
 static int stbi__parse_png_file(stbi__png *z, int scan, int req_comp)
@@ -5197,13 +6191,20 @@ static int stbi__parse_png_file(stbi__png *z, int scan, int req_comp)
          }
 
          case STBI__PNG_TYPE('I','E','N','D'): {
-            stbi__uint32 raw_len, bpl;
+            stbi__uint32 raw_len;
             if (first) return stbi__err("first not IHDR", "Corrupt PNG");
             if (scan != STBI__SCAN_load) return 1;
             if (z->idata == NULL) return stbi__err("no IDAT","Corrupt PNG");
-            // initial guess for decoded data size to avoid unnecessary reallocs
-            bpl = (s->img_x * z->depth + 7) / 8; // bytes per line, per component
-            raw_len = bpl * s->img_y * s->img_n /* pixels */ + s->img_y /* filter mode per row */;
+            if (z->sink && !interlace && z->depth <= 8 && !is_iphone) {
+               if (!stbi__png_stream_image(z, ioff, req_comp, color, palette, pal_img_n, has_trans, tc)) return 0;
+               STBI_FREE(z->idata); z->idata = NULL;
+               STBI_FREE(z->expanded); z->expanded = NULL;
+               stbi__get32be(s);
+               return 1;
+            }
+            // exact decoded data size from IHDR, so valid files never realloc; the slack lets the
+            // fast inflate loop run to the end of the image. still expandable for trailing data
+            raw_len = stbi__png_raw_size(s->img_x, s->img_y, s->img_n, z->depth, interlace) + STBI__ZFAST_OUT;
             z->expanded = (stbi_uc *) stbi_zlib_decode_malloc_guesssize_headerflag((char *) z->idata, ioff, raw_len, (int *) &raw_len, !is_iphone);
             if (z->expanded == NULL) return 0; // zlib should set error
             STBI_FREE(z->idata); z->idata = NULL;
@@ -5296,9 +6297,43 @@ static void *stbi__png_load(stbi__context *s, int *x, int *y, int *comp, int req
 {
    stbi__png p;
    p.s = s;
+   p.sink = NULL;
    return stbi__do_png(&p, x,y,comp,req_comp, ri);
 }
 
+static int stbi__png_load_rows(stbi__context *s, stbi__rowsink *sink, int *x, int *y, int *comp, int req_comp)
+{
+   stbi__png p;
+   int ok;
+   if (req_comp < 0 || req_comp > 4) return stbi__err("bad req_comp", "Internal error");
+   p.s = s;
+   p.sink = sink;
+   ok = stbi__parse_png_file(&p, STBI__SCAN_load, req_comp);
+   if (ok && !sink->started) {
+      // interlaced, 16-bit or iphone: decoded whole, hand it out the same way
+      stbi_uc *result = p.out;
+      int n = p.s->img_out_n;
+      p.out = NULL;
+      if (req_comp && req_comp != n) {
+         result = p.depth == 16 ? (stbi_uc *) stbi__convert_format16((stbi__uint16 *) result, n, req_comp, s->img_x, s->img_y)
+                                : stbi__convert_format(result, n, req_comp, s->img_x, s->img_y);
+         n = req_comp;
+      }
+      if (result && p.depth == 16) result = stbi__convert_16_to_8((stbi__uint16 *) result, s->img_x, s->img_y, n);
+      ok = result && stbi__rowsink_image(sink, result, s->img_x, s->img_y, s->img_n, n);
+      STBI_FREE(result);
+   }
+   if (ok) {
+      *x = s->img_x;
+      *y = s->img_y;
+      if (comp) *comp = s->img_n;
+   }
+   STBI_FREE(p.out);      p.out      = NULL;
+   STBI_FREE(p.expanded); p.expanded = NULL;
+   STBI_FREE(p.idata);    p.idata    = NULL;
+   return ok;
+}
+
 static int stbi__png_test(stbi__context *s)
 {
    int r;
@@ -5323,6 +6358,7 @@ static int stbi__png_info(stbi__context *s, int *x, int *y, int *comp)
 {
    stbi__png p;
    p.s = s;
+   p.sink = NULL;
    return stbi__png_info_raw(&p, x, y, comp);
 }
 
@@ -5330,6 +6366,7 @@ static int stbi__png_is16(stbi__context *s)
 {
    stbi__png p;
    p.s = s;
+   p.sink = NULL;
    if (!stbi__png_info_raw(&p, NULL, NULL, NULL))
 	   return 0;
    if (p.depth != 16) {
@@ -7738,6 +8775,101 @@ STBIDEF int stbi_info_from_memory(stbi_uc const *buffer, int len, int *x, int *y
    return stbi__info_main(&s,x,y,comp);
 }
 
+STBIDEF int stbi_load_from_memory_into(stbi_uc const *buffer, int len, stbi_uc *out, int out_stride, int bottom_up, int *x, int *y, int *comp, int req_comp)
+{
+   stbi__context s;
+   stbi__result_info ri;
+   int w, h, n, j;
+   size_t row;
+   void *result;
+
+   if (req_comp < 1 || req_comp > 4) return stbi__err("bad req_comp", "Internal error");
+   if (!stbi_info_from_memory(buffer, len, &w, &h, &n)) return 0;
+   if (out_stride < w * req_comp) return stbi__err("bad stride", "Output stride smaller than a row");
+
+   #ifndef STBI_NO_JPEG
+   stbi__start_mem(&s,buffer,len);
+   if (stbi__jpeg_test(&s)) {
+      stbi_uc *decoded;
+      stbi__jpeg *z = (stbi__jpeg *) stbi__malloc(sizeof(stbi__jpeg));
+      if (!z) return stbi__err("outofmem", "Out of memory");
+      memset(z, 0, sizeof(stbi__jpeg));
+      z->s = &s;
+      stbi__setup_jpeg(z);
+      z->dst = out;
+      z->dst_stride = out_stride;
+      z->dst_bottom_up = bottom_up;
+      decoded = load_jpeg_image(z, x, y, comp, req_comp);
+      STBI_FREE(z);
+      return decoded != NULL;
+   }
+   #endif
+
+   // other formats: decode to a temporary, then one strided copy (which also does the flip)
+   stbi__start_mem(&s,buffer,len);
+   result = stbi__load_main(&s, x, y, comp, req_comp, &ri, 8);
+   if (result == NULL) return 0;
+   if (ri.bits_per_channel != 8) {
+      result = stbi__convert_16_to_8((stbi__uint16 *) result, *x, *y, req_comp);
+      if (result == NULL) return 0;
+   }
+   if (*x != w || *y != h) { STBI_FREE(result); return stbi__err("bad size", "Decoded size differs from header"); }
+   row = (size_t) w * req_comp;
+   for (j=0; j < h; ++j)
+      memcpy(out + (size_t) out_stride * (bottom_up ? h - 1 - j : j), (stbi_uc *) result + row * j, row);
+   STBI_FREE(result);
+   return 1;
+}
+
+static int stbi__load_rows_main(stbi__context *s, stbi_row_callbacks const *rows, void *rows_user, int band_rows, int *x, int *y, int *comp, int req_comp)
+{
+   stbi__rowsink sink;
+   stbi__result_info ri;
+   int w, h, n;
+   void *result;
+
+   if (req_comp < 0 || req_comp > 4) return stbi__err("bad req_comp", "Internal error");
+   sink.cb = *rows;
+   sink.user = rows_user;
+   sink.band_rows = band_rows > 0 ? band_rows : 1;
+   sink.started = 0;
+
+   #ifndef STBI_NO_JPEG
+   if (stbi__jpeg_test(s)) return stbi__jpeg_load_rows(s, &sink, x, y, comp, req_comp);
+   #endif
+   #ifndef STBI_NO_PNG
+   if (stbi__png_test(s)) return stbi__png_load_rows(s, &sink, x, y, comp, req_comp);
+   #endif
+
+   // other formats: decode whole, then hand out in bands
+   result = stbi__load_main(s, &w, &h, &n, req_comp, &ri, 8);
+   if (result == NULL) return 0;
+   if (ri.bits_per_channel != 8) {
+      result = stbi__convert_16_to_8((stbi__uint16 *) result, w, h, req_comp ? req_comp : n);
+      if (result == NULL) return 0;
+   }
+   if (!stbi__rowsink_image(&sink, (stbi_uc *) result, w, h, n, req_comp ? req_comp : n)) { STBI_FREE(result); return 0; }
+   STBI_FREE(result);
+   *x = w;
+   *y = h;
+   if (comp) *comp = n;
+   return 1;
+}
+
+STBIDEF int stbi_load_rows_from_memory(stbi_uc const *buffer, int len, stbi_row_callbacks const *rows, void *rows_user, int band_rows, int *x, int *y, int *comp, int req_comp)
+{
+   stbi__context s;
+   stbi__start_mem(&s,buffer,len);
+   return stbi__load_rows_main(&s, rows, rows_user, band_rows, x, y, comp, req_comp);
+}
+
+STBIDEF int stbi_load_rows_from_callbacks(stbi_io_callbacks const *clbk, void *user, stbi_row_callbacks const *rows, void *rows_user, int band_rows, int *x, int *y, int *comp, int req_comp)
+{
+   stbi__context s;
+   stbi__start_callbacks(&s, (stbi_io_callbacks *) clbk, user);
+   return stbi__load_rows_main(&s, rows, rows_user, band_rows, x, y, comp, req_comp);
+}
+
 STBIDEF int stbi_info_from_callbacks(stbi_io_callbacks const *c, void *user, int *x, int *y, int *comp)
 {
    stbi__context s;
@@ -0,0 +1,8 @@
+#pragma once
+// 손대지 않은 stb_image v2.30 (external/stb_baseline) 디코더. DecodeBench의 기준선 비교용
+//  - 그 TU 안에서 STB_IMAGE_STATIC으로 빌드하므로 이 프로젝트의 stb_image와 심볼이 겹치지 않음
+//  - 아레나/디코드 스레드/커널 선택 없이 기본 힙 + 원래 SIMD 경로
+// 반환한 픽셀은 BaselineStbiFree로 해제. 실패하면 nullptr
+unsigned char* BaselineStbiLoadFromMemory(const unsigned char* data, int size, int* x, int* y, int* channels,
+                                          int desiredChannels);
+void BaselineStbiFree(void* pixels);
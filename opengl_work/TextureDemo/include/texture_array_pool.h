@@ -0,0 +1,90 @@
+#pragma once
+// 텍스처 배열 풀: 같은 크기/포맷의 텍스처를 GL_TEXTURE_2D_ARRAY 레이어로 모음
+//  - 버킷 키 = (너비, 높이, 내부 포맷). 버킷마다 layersPerArray 레이어짜리 배열을 필요할 때 하나씩 추가
+//  - 재질은 (배열, 레이어)만 들고 있으면 됨 → 같은 배열을 쓰는 쿼드들은 인스턴스 속성의 레이어 번호만
+//    다르게 해서 그리기 한 번으로 끝 (유닛별 바인드/프로그램 전환 없음)
+//  - 저장소는 glTexStorage3D (4.2+), 없으면 레벨마다 glTexImage3D + MAX_LEVEL
+//  - 밉은 mip_builder로 CPU에서 만들어 레이어별로 올림 (glGenerateMipmap은 배열 전체를 다시 만들어서 안 씀)
+//  - 3채널은 RGBA8로 넓혀 저장 (RGB/RGBA 이미지가 같은 배열을 쓰도록. GPU 내부도 어차피 4바이트)
+// 아틀라스와 달리 레이어마다 REPEAT가 그대로 됨. GL 스레드 전용
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class PixelUploadRing;
+
+struct TextureArrayPoolOptions {
+    int layersPerArray = 16;
+    int maxLevels = 16;         // 레벨 0 포함 (크기에 맞게 잘림)
+    bool srgbMips = true;
+    GLint wrap = GL_REPEAT;
+    GLint minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    GLint magFilter = GL_LINEAR;
+};
+
+// 재질이 참조하는 위치. array는 Arrays()의 인덱스
+struct ArrayLayer {
+    int array = -1;
+    int layer = -1;
+    explicit operator bool() const { return array >= 0; }
+};
+
+struct TextureArrayPoolStats {
+    unsigned added = 0;
+    unsigned removed = 0;
+    unsigned failed = 0;
+    unsigned arraysCreated = 0;
+    size_t   bytesAllocated = 0;    // 배열 저장소 (밉 포함)
+    size_t   bytesUploaded = 0;
+    double   mipMs = 0.0;
+    double   uploadMs = 0.0;
+};
+
+class TextureArrayPool {
+public:
+    struct Array {
+        GLuint tex = 0;
+        int width = 0, height = 0, levels = 0;
+        GLenum internalFormat = 0;
+        int capacity = 0;
+        std::vector<int> freeLayers;   // 뒤에서부터 꺼냄
+        int Used() const { return capacity - (int)freeLayers.size(); }
+    };
+
+    TextureArrayPool() = default;
+    ~TextureArrayPool() { Destroy(); }
+    TextureArrayPool(const TextureArrayPool&) = delete;
+    TextureArrayPool& operator=(const TextureArrayPool&) = delete;
+
+    // ring이 있으면 레이어 업로드가 PBO 링을 거침
+    void Init(const TextureArrayPoolOptions& options = {}, PixelUploadRing* ring = nullptr);
+    void Destroy();
+
+    // channels 1~4, 행은 아래에서 위 (GL 순서). 같은 이름이 있으면 먼저 지움
+    ArrayLayer Add(const std::string& name, const unsigned char* pixels, int w, int h, int channels);
+    // Vfs에서 읽어 디코드 (이름 = 경로)
+    ArrayLayer AddFile(const std::string& path, bool flipY = true);
+    // 레이어를 비움 (배열은 남겨 두고 다음 Add가 재사용)
+    bool Remove(const std::string& name);
+    ArrayLayer Find(const std::string& name) const;
+
+    // 그릴 때 array 인덱스로 GL 텍스처를 찾음 (GL_TEXTURE_2D_ARRAY로 바인드)
+    const std::vector<Array>& Arrays() const { return arrays_; }
+    GLuint Texture(const ArrayLayer& ref) const { return ref ? arrays_[ref.array].tex : 0; }
+    size_t Count() const { return names_.size(); }
+    const TextureArrayPoolStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    int CreateArray(int w, int h, GLenum internalFormat);
+
+    TextureArrayPoolOptions options_;
+    PixelUploadRing* ring_ = nullptr;
+    std::vector<Array> arrays_;
+    std::unordered_map<std::string, ArrayLayer> names_;
+    TextureArrayPoolStats stats_;
+};
@@ -0,0 +1,116 @@
+#pragma once
+// 텍스처 아틀라스: 작은 이미지 여러 장을 GL 텍스처 하나에 모아 바인드 한 번으로 그림
+//  - 배치는 MaxRects (Best Short Side Fit). 빈 공간을 겹치는 최대 사각형 목록으로 유지
+//  - 칸은 2^(mipLevels-1) 단위로 정렬 → 레벨 k에서도 칸 경계가 정수 텍셀에 걸려 박스 필터가 이웃과 섞이지 않음
+//  - 칸 둘레에 padding 픽셀만큼 가장자리를 복제 (거터). 레벨 k의 거터는 padding >> k
+//    → 바이리니어가 이웃 이미지를 읽지 않으려면 padding >= 2^(mipLevels-1) 권장
+//  - 밉은 칸 단위로 mip_builder가 만들어 glTexSubImage2D로 해당 위치에 올림 (glGenerateMipmap 없음)
+//  - 런타임에 Add/Remove 가능. Remove는 남은 칸으로 빈 사각형 목록을 다시 계산
+// UV는 AtlasRegion의 [u0,u1]x[v0,v1] (거터 제외한 원본 영역). GL 스레드 전용
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class PixelUploadRing;
+
+struct AtlasRect {
+    int x = 0, y = 0, w = 0, h = 0;
+};
+
+// 배치만 담당 (GL 없음). 크기는 호출자가 정렬해서 넘김
+class MaxRectsPacker {
+public:
+    void Reset(int width, int height);
+    // 자리가 없으면 false
+    bool Insert(int w, int h, AtlasRect* out);
+    // Insert로 받은 사각형을 돌려줌
+    bool Remove(const AtlasRect& r);
+
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+    size_t UsedArea() const { return usedArea_; }
+    size_t FreeArea() const { return (size_t)width_ * height_ - usedArea_; }
+    size_t LargestFreeArea() const;
+    size_t FreeRectCount() const { return free_.size(); }
+    size_t UsedRectCount() const { return used_.size(); }
+
+private:
+    // free_의 각 사각형에서 r과 겹치는 부분을 잘라내고 포함 관계인 것을 정리
+    void SplitFree(const AtlasRect& r);
+    void Prune();
+
+    int width_ = 0, height_ = 0;
+    size_t usedArea_ = 0;
+    std::vector<AtlasRect> free_;
+    std::vector<AtlasRect> used_;
+};
+
+struct AtlasOptions {
+    int size = 2048;            // 정사각형 한 변
+    int padding = 4;            // 거터 (레벨 0 픽셀)
+    int mipLevels = 3;          // 레벨 0 포함. 1이면 밉 없음
+    bool srgbMips = true;       // 밉 평균을 sRGB 선형으로 (mip_builder)
+};
+
+struct AtlasRegion {
+    int x = 0, y = 0, w = 0, h = 0;     // 원본 이미지가 놓인 텍셀 영역 (레벨 0)
+    float u0 = 0, v0 = 0, u1 = 0, v1 = 0;
+    AtlasRect slot;                     // 거터/정렬 포함 칸
+
+    // 원래 [0,1] UV를 아틀라스 UV로
+    void Remap(float& u, float& v) const { u = u0 + u * (u1 - u0); v = v0 + v * (v1 - v0); }
+};
+
+struct TextureAtlasStats {
+    unsigned inserted = 0;
+    unsigned removed = 0;
+    unsigned failed = 0;        // 자리가 없어 넣지 못한 이미지
+    size_t   bytesUploaded = 0; // 밉 포함
+    double   packMs = 0.0;      // 배치 + 거터/밉 생성 (CPU)
+    double   uploadMs = 0.0;
+};
+
+class TextureAtlas {
+public:
+    TextureAtlas() = default;
+    ~TextureAtlas() { Destroy(); }
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // RGBA8 텍스처 생성. ring이 있으면 칸 업로드가 PBO 링을 거침
+    bool Init(const AtlasOptions& options = {}, PixelUploadRing* ring = nullptr);
+    void Destroy();
+
+    // channels 1~4, 행은 아래에서 위 (GL 순서). 같은 이름이 있으면 먼저 지움. 자리가 없으면 nullptr
+    const AtlasRegion* Add(const std::string& name, const unsigned char* pixels, int w, int h, int channels);
+    // Vfs에서 읽어 디코드 (이름 = 경로)
+    const AtlasRegion* AddFile(const std::string& path, bool flipY = true);
+    bool Remove(const std::string& name);
+    const AtlasRegion* Find(const std::string& name) const;
+
+    // 정점 배열의 UV를 region 영역으로 바꿈. stride/uvOffset은 float 단위
+    static void RemapUVs(float* vertices, size_t vertexCount, size_t stride, size_t uvOffset, const AtlasRegion& region);
+
+    GLuint Texture() const { return tex_; }
+    int Size() const { return options_.size; }
+    size_t Count() const { return regions_.size(); }
+    const MaxRectsPacker& Packer() const { return packer_; }
+    // 남은 빈 공간 중 가장 큰 사각형이 차지하지 못하는 비율 (0 = 한 덩어리, 1에 가까울수록 조각남)
+    float Fragmentation() const;
+    float Occupancy() const;
+    const TextureAtlasStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    AtlasOptions options_;
+    PixelUploadRing* ring_ = nullptr;
+    GLuint tex_ = 0;
+    int align_ = 1;
+    MaxRectsPacker packer_;
+    std::unordered_map<std::string, AtlasRegion> regions_;
+    TextureAtlasStats stats_;
+};
@@ -0,0 +1,168 @@
+#pragma once
+// 비동기 텍스처 로더
+//  - Load()는 1x1 플레이스홀더가 들어간 텍스처 이름을 바로 돌려줌
+//  - 디코드(Vfs 매핑 + stbi_load_from_memory_into)는 워커 스레드 풀에서 수행
+//    stb 내부 할당은 워커별 아레나(image_arena)에서, 출력은 로더가 잡은 버퍼로 받음
+//  - Update()가 GL 스레드에서 프레임당 업로드 바이트 예산 안에서 실제 이미지로 교체
+// 뒤집기는 stbi_load_from_memory_into의 bottom_up 인자로 요청마다 넘김 (스트리밍은 밴드 행을 뒤집어 복사)
+// PBO 링이 persistent 매핑이면 Load() 때 헤더만 읽어 링 구간을 예약하고, 워커가 그 구간에
+// 바로 디코드함 (stbi_load_from_memory_into: stb 출력 버퍼/뒤집기/링 복사가 모두 없어짐)
+// 밉맵은 기본으로 워커가 CPU에서 만듦 (mip_builder: sRGB 선형 평균, 드라이버마다 다른 glGenerateMipmap 대신).
+// 이때 예약 구간에는 레벨 0을 바로 디코드할 수 없으므로(쓰기 전용 매핑) 워커가 모든 레벨을 이어서 복사해 둠
+// .gtex(미리 구운 텍스처)는 디코드가 없으므로 Load() 안에서 바로 모든 레벨을 올림
+// SetStreaming(true)면 워커가 stbi_load_rows_from_memory로 행 밴드 단위로 디코드하고, Update()가 밴드마다
+// glTexSubImage2D로 올림 (아래 밴드를 디코드하는 동안 위 밴드가 이미 보임, 대기 중인 픽셀도 밴드 크기로 줄어듦).
+// 밉이 다 채워질 때까지 MAX_LEVEL 0으로 둠. 스트리밍 요청은 링 예약을 쓰지 않고, 레벨 0 전체를 워커에
+// 모아 두지 않도록 CPU 밉 대신 마지막 밴드 뒤 glGenerateMipmap
+#include <glad/glad.h>
+
+#include "mip_builder.h"
+#include "pixel_upload_ring.h"
+#include "vfs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct TextureDesc {
+    bool   flipY = true;
+    bool   mipmaps = true;
+    GLint  wrap = GL_REPEAT;
+    GLint  minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    GLint  magFilter = GL_LINEAR;
+};
+
+struct TextureLoaderStats {
+    unsigned requested = 0;
+    unsigned uploaded = 0;
+    unsigned failed = 0;
+    unsigned cancelled = 0;
+    unsigned bandsUploaded = 0;     // 스트리밍 밴드 업로드 수
+    size_t   bytesUploaded = 0;
+    size_t   peakQueuedBytes = 0;   // 디코드가 끝나고 업로드를 기다리던 픽셀 바이트 최대치
+    double   decodeMs = 0.0;        // 워커 스레드 디코드 시간 합
+    double   mipMs = 0.0;           // 워커 스레드 CPU 밉 생성 시간 합
+    double   uploadMs = 0.0;        // GL 스레드 업로드 시간 합
+    double   maxFrameUploadMs = 0.0;
+    double   firstPixelMs = 0.0;    // Load()부터 첫 픽셀(스트리밍이면 첫 밴드) 업로드까지 합
+    double   maxFirstPixelMs = 0.0;
+    size_t   stbAllocs = 0;         // 워커 디코드 중 stb malloc/realloc 호출 수 (image_arena)
+    size_t   stbHeapAllocs = 0;     // 그중 힙까지 간 수 (아레나가 처음 잡히거나 자랄 때만)
+};
+
+class TextureLoader {
+public:
+    TextureLoader() = default;
+    ~TextureLoader() { Shutdown(); }
+    TextureLoader(const TextureLoader&) = delete;
+    TextureLoader& operator=(const TextureLoader&) = delete;
+
+    // workers = 0이면 (코어 수 - 1). budget은 Update() 한 번에 올릴 최대 바이트
+    void Init(int workers = 0, size_t uploadBudgetBytes = 8u << 20);
+    void Shutdown();
+
+    // GL 스레드에서 호출. 실패해도 플레이스홀더 텍스처는 유효
+    // 호출자가 이미 연 파일이 있으면 file로 넘겨 다시 열지 않게 함
+    GLuint Load(const std::string& path, const TextureDesc& desc = {}, FileView file = {});
+    // 아직 끝나지 않은 요청을 취소 (텍스처를 지우기 전에 호출). 이미 업로드됐으면 아무 일 없음
+    void Cancel(GLuint tex);
+    // 프레임마다 GL 스레드에서 호출. 예산을 넘겨도 최소 한 장은 올림 (큰 텍스처가 굶지 않도록)
+    void Update();
+    // 남은 요청을 모두 끝낼 때까지 대기 (로딩 화면 등)
+    void Flush();
+
+    size_t Pending() const;
+    void SetUploadCallback(std::function<void(GLuint tex, int w, int h)> cb) { onUpload_ = std::move(cb); }
+    void SetUploadBudget(size_t bytes) { budget_ = bytes; }
+    // 설정하면 업로드가 PBO 링을 거침 (없으면 클라이언트 메모리에서 바로 glTexImage2D)
+    void SetUploadRing(PixelUploadRing* ring) { ring_ = ring; }
+    // false면 레벨 0만 올리고 glGenerateMipmap. Load() 전에 설정할 것
+    void SetCpuMips(bool enabled, const MipOptions& options = {}) { cpuMips_ = enabled; mipOptions_ = options; }
+    // 행 밴드 스트리밍 디코드/업로드. 켜면 SetCpuMips와 관계없이 밉은 glGenerateMipmap. Load() 전에 설정할 것
+    void SetStreaming(bool enabled, int bandRows = 64) { stream_ = enabled; bandRows_ = std::max(1, bandRows); }
+
+    const TextureLoaderStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    struct Job {
+        GLuint tex;
+        uint64_t request = 0;             // Load()마다 새 번호 (텍스처 이름은 지운 뒤 재사용될 수 있음)
+        std::string path;
+        TextureDesc desc;
+        FileView file;                    // 예약했을 때만 (헤더를 읽느라 이미 열었음)
+        PixelUploadRing::Slice slice;     // 디코드 대상 PBO 구간 (없으면 stb가 할당)
+        int w = 0, h = 0, channels = 0;
+        bool cpuMips = false;             // 워커가 밉 체인을 만듦 (slice는 전체 체인 크기)
+        bool stream = false;              // 행 밴드 단위로 디코드
+    };
+    struct Decoded {
+        GLuint tex;
+        uint64_t request = 0;
+        std::string path;
+        TextureDesc desc;
+        int w = 0, h = 0, channels = 0;
+        std::unique_ptr<unsigned char, void (*)(void*)> pixels{ nullptr, nullptr };
+        std::vector<MipLevel> mips;       // 레벨 1..n (slice에 복사했으면 크기만 남음)
+        size_t bytes = 0;                 // 모든 레벨 합 (업로드 예산 계산용)
+        PixelUploadRing::Slice slice;
+        bool ok = false;
+        const char* error = nullptr;   // stb 실패 사유 (스레드별이라 워커에서 받아 둠)
+        double decodeMs = 0.0;
+        double mipMs = 0.0;
+        size_t stbAllocs = 0, stbHeapAllocs = 0;
+        // 스트리밍 밴드 (band면 마지막 항목이 아님 → inFlight_를 줄이지 않음)
+        bool band = false;
+        bool stream = false;              // 스트리밍 요청의 마지막 항목 (레벨 0은 밴드로만 옴, pixels 없음)
+        bool first = false;               // 이 텍스처의 첫 밴드 → 레벨 0 저장소를 잡음
+        int y0 = 0, rows = 0;             // GL 행 순서 (뒤집기 반영)
+        std::vector<unsigned char> rowData;
+    };
+    struct BandSink;
+
+    void WorkerMain();
+    void DecodeStreamed(const FileView& file, Decoded& d);
+    void PushDone(Decoded&& d);
+    void Upload(const Decoded& d);
+    void UploadBand(const Decoded& d);
+    void FinishStreamed(const Decoded& d);
+    void NoteFirstPixel(uint64_t request);
+
+    std::vector<std::thread> workers_;
+    mutable std::mutex m_;
+    std::condition_variable cv_;
+    std::condition_variable doneCv_;
+    std::deque<Job> jobs_;
+    std::deque<Decoded> done_;
+    size_t inFlight_ = 0;     // 요청 후 아직 업로드되지 않은 수
+    size_t queuedBytes_ = 0;  // done_에 쌓인 픽셀 바이트
+    size_t peakQueuedBytes_ = 0;
+    // 아래는 모두 GL 스레드 전용. 요청 번호로 구분 (취소한 텍스처를 지우면 드라이버가 이름을 바로 재사용함)
+    uint64_t nextRequest_ = 0;
+    std::unordered_map<uint64_t, std::chrono::steady_clock::time_point> pending_;   // 아직 업로드 전 → 요청 시각
+    std::unordered_map<GLuint, uint64_t> requestOf_;   // 텍스처 → 진행 중인 요청 (Cancel용)
+    std::unordered_set<uint64_t> cancelled_;   // 디코드 중에 취소됨 → Update()에서 버림
+    std::unordered_set<uint64_t> streamed_;    // 첫 밴드를 올린 스트리밍 요청
+    bool stop_ = false;
+
+    size_t budget_ = 8u << 20;
+    PixelUploadRing* ring_ = nullptr;
+    bool cpuMips_ = true;
+    MipOptions mipOptions_;
+    bool stream_ = false;
+    int bandRows_ = 64;
+    std::function<void(GLuint, int, int)> onUpload_;
+    TextureLoaderStats stats_;
+};
@@ -0,0 +1,82 @@
+#pragma once
+// 참조 카운트 텍스처 레지스트리
+//  - 키 = 원본 파일 바이트의 빠른 해시 + 샘플링 파라미터(TextureDesc)
+//    → 경로가 달라도 내용이 같으면 같은 GL 텍스처를 공유 (디코드/업로드 한 번)
+//  - Acquire()는 TextureHandle을 돌려주고, 마지막 핸들이 사라지면 GL 텍스처를 삭제
+//  - 같은 경로+파라미터의 재요청은 해시도 다시 계산하지 않음
+// 핸들은 레지스트리보다 먼저 정리할 것 (GL 스레드 전용)
+#include <glad/glad.h>
+
+#include "texture_loader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TextureRegistry;
+
+class TextureHandle {
+public:
+    TextureHandle() = default;
+    TextureHandle(const TextureHandle& o);
+    TextureHandle(TextureHandle&& o) noexcept;
+    TextureHandle& operator=(TextureHandle o) noexcept;
+    ~TextureHandle();
+
+    GLuint Id() const { return id_; }
+    explicit operator bool() const { return id_ != 0; }
+
+private:
+    friend class TextureRegistry;
+    TextureHandle(TextureRegistry* reg, uint64_t key, GLuint id) : reg_(reg), key_(key), id_(id) {}
+
+    TextureRegistry* reg_ = nullptr;
+    uint64_t key_ = 0;
+    GLuint id_ = 0;
+};
+
+struct TextureRegistryStats {
+    unsigned requests = 0;
+    unsigned loads = 0;         // 실제로 로더에 넘긴 (고유한) 텍스처
+    unsigned pathHits = 0;      // 같은 경로 재요청
+    unsigned contentHits = 0;   // 다른 경로지만 내용이 같아 공유
+    unsigned released = 0;      // 참조가 0이 되어 삭제된 텍스처
+    size_t   savedBytes = 0;    // 공유 덕분에 올리지 않은 픽셀 바이트
+    size_t   liveBytes = 0;
+    double   hashMs = 0.0;
+};
+
+class TextureRegistry {
+public:
+    explicit TextureRegistry(TextureLoader& loader) : loader_(loader) {}
+    ~TextureRegistry();
+    TextureRegistry(const TextureRegistry&) = delete;
+    TextureRegistry& operator=(const TextureRegistry&) = delete;
+
+    // 파일을 열 수 없으면 빈 핸들
+    TextureHandle Acquire(const std::string& path, const TextureDesc& desc = {});
+
+    size_t Count() const { return entries_.size(); }
+    const TextureRegistryStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    friend class TextureHandle;
+    void AddRef(uint64_t key);
+    void Release(uint64_t key);
+
+    struct Entry {
+        GLuint tex = 0;
+        unsigned refs = 0;
+        size_t bytes = 0;
+        std::vector<std::string> pathKeys;   // 이 텍스처를 가리키는 byPath_ 키 (삭제할 때 같이 정리)
+    };
+
+    TextureLoader& loader_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    std::unordered_map<std::string, uint64_t> byPath_;   // 경로 + 파라미터 → 내용 키
+    TextureRegistryStats stats_;
+};
@@ -0,0 +1,38 @@
+#version 330 core
+// 텍스처 데모 공용 셰이더. 기능은 ShaderVariants가 주입하는 #define으로 켬
+//  TEX_MIX        : uTex0, uTex1을 uMix 비율로 섞음 (예전 tex_mix.frag)
+//  VERTEX_COLOR   : 정점 색을 곱함
+//  WRAP_EMULATION : 샘플러 wrap 대신 셰이더에서 fract()로 반복
+//  TEX_ARRAY      : uTex0 대신 uTexArray의 vLayer 레이어 (정점 셰이더의 인스턴스 속성)
+out vec4 FragColor;
+in vec2 vUV;
+#ifdef VERTEX_COLOR
+in vec3 vColor;
+#endif
+uniform sampler2D uTex0;
+#ifdef TEX_ARRAY
+uniform sampler2DArray uTexArray;
+flat in float vLayer;
+#endif
+#ifdef TEX_MIX
+uniform sampler2D uTex1;
+uniform float uMix;
+#endif
+void main() {
+    vec2 uv = vUV;
+#ifdef WRAP_EMULATION
+    uv = fract(uv);
+#endif
+#ifdef TEX_ARRAY
+    vec4 c = texture(uTexArray, vec3(uv, vLayer));
+#else
+    vec4 c = texture(uTex0, uv);
+#endif
+#ifdef TEX_MIX
+    c = mix(c, texture(uTex1, uv), uMix);
+#endif
+#ifdef VERTEX_COLOR
+    c.rgb *= vColor;
+#endif
+    FragColor = c;
+}
@@ -0,0 +1,32 @@
+#version 330 core
+// 텍스처 데모 공용 셰이더. 기능은 ShaderVariants가 주입하는 #define으로 켬
+//  VERTEX_COLOR : 정점 색을 프래그먼트로 넘김
+//  UV_TILING    : UV를 2배로 늘리고 밀어서 wrap 모드가 보이게 함 (예전 tex_mix.vert)
+//  TEX_ARRAY    : 인스턴스마다 위치/크기와 배열 레이어를 받음 (TextureArrayPool, 그리기 한 번에 여러 재질)
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aColor;
+layout(location = 2) in vec2 aUV;
+out vec2 vUV;
+#ifdef TEX_ARRAY
+layout(location = 3) in vec4 aInstance;   // xy: 오프셋, z: 크기, w: 레이어
+flat out float vLayer;
+#endif
+#ifdef VERTEX_COLOR
+out vec3 vColor;
+#endif
+void main() {
+#ifdef TEX_ARRAY
+    gl_Position = vec4(aPos * aInstance.z + vec3(aInstance.xy, 0.0), 1.0);
+    vLayer = aInstance.w;
+#else
+    gl_Position = vec4(aPos, 1.0);
+#endif
+#ifdef UV_TILING
+    vUV = aUV * 2.0 + vec2(0.3, 0);
+#else
+    vUV = aUV;
+#endif
+#ifdef VERTEX_COLOR
+    vColor = aColor;
+#endif
+}
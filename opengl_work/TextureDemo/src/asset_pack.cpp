@@ -0,0 +1,18 @@
+// 에셋 패커: 폴더를 Vfs 팩 아카이브(.pak) 하나로 묶음 (TextureMix가 있으면 assets/ 대신 마운트)
+// 사용법: AssetPack <dir> <out.pak>
+#include "vfs.h"
+
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <dir> <out.pak>\n", argv[0]);
+        return 2;
+    }
+    if (!Vfs::WriteArchive(argv[1], argv[2])) {
+        fprintf(stderr, "[AssetPack] failed: %s -> %s\n", argv[1], argv[2]);
+        return 1;
+    }
+    printf("[AssetPack] %s -> %s\n", argv[1], argv[2]);
+    return 0;
+}
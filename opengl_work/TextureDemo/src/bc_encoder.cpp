@@ -0,0 +1,458 @@
+#include "bc_encoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BC_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define BC_USE_SSE2 0
+#endif
+
+namespace {
+// 4x4 블록을 채널별(SoA)로 펼친 것 → SSE로 4픽셀씩 비교
+struct Block {
+    alignas(16) float c[4][16];
+};
+
+void LoadBlock(const unsigned char* rgba, int w, int h, int bx, int by, Block& b) {
+    for (int y = 0; y < 4; ++y) {
+        const int sy = std::min(by * 4 + y, h - 1);
+        for (int x = 0; x < 4; ++x) {
+            const unsigned char* p = rgba + ((size_t)sy * w + std::min(bx * 4 + x, w - 1)) * 4;
+            for (int ch = 0; ch < 4; ++ch) b.c[ch][y * 4 + x] = p[ch];
+        }
+    }
+}
+
+// 픽셀마다 가장 가까운 팔레트 항목 (앞 channels개 채널만 비교). 제곱 오차 합 반환
+float FitIndices(const Block& b, const float (*pal)[4], int count, int channels, uint8_t idx[16]) {
+    float total = 0.0f;
+#if BC_USE_SSE2
+    for (int g = 0; g < 16; g += 4) {
+        __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i bestIdx = _mm_setzero_si128();
+        for (int p = 0; p < count; ++p) {
+            __m128 d = _mm_setzero_ps();
+            for (int ch = 0; ch < channels; ++ch) {
+                const __m128 diff = _mm_sub_ps(_mm_load_ps(&b.c[ch][g]), _mm_set1_ps(pal[p][ch]));
+                d = _mm_add_ps(d, _mm_mul_ps(diff, diff));
+            }
+            // 같으면 앞 항목 유지
+            const __m128i less = _mm_castps_si128(_mm_cmplt_ps(d, best));
+            best = _mm_min_ps(d, best);
+            bestIdx = _mm_or_si128(_mm_and_si128(less, _mm_set1_epi32(p)), _mm_andnot_si128(less, bestIdx));
+        }
+        alignas(16) float e[4];
+        alignas(16) int32_t i4[4];
+        _mm_store_ps(e, best);
+        _mm_store_si128(reinterpret_cast<__m128i*>(i4), bestIdx);
+        for (int k = 0; k < 4; ++k) { total += e[k]; idx[g + k] = (uint8_t)i4[k]; }
+    }
+#else
+    for (int i = 0; i < 16; ++i) {
+        float best = std::numeric_limits<float>::max();
+        for (int p = 0; p < count; ++p) {
+            float d = 0.0f;
+            for (int ch = 0; ch < channels; ++ch) { const float diff = b.c[ch][i] - pal[p][ch]; d += diff * diff; }
+            if (d < best) { best = d; idx[i] = (uint8_t)p; }
+        }
+        total += best;
+    }
+#endif
+    return total;
+}
+
+// 주성분 축 위로 투영한 양 끝을 초기 끝점으로 (평평한 블록이면 두 끝점 모두 평균)
+void PrincipalEndpoints(const Block& b, int channels, BcQuality quality, float e0[4], float e1[4]) {
+    float mean[4] = {}, lo[4], hi[4];
+    for (int ch = 0; ch < channels; ++ch) {
+        lo[ch] = hi[ch] = b.c[ch][0];
+        for (int i = 0; i < 16; ++i) {
+            mean[ch] += b.c[ch][i];
+            lo[ch] = std::min(lo[ch], b.c[ch][i]);
+            hi[ch] = std::max(hi[ch], b.c[ch][i]);
+        }
+        mean[ch] /= 16.0f;
+    }
+    float cov[4][4] = {};
+    for (int i = 0; i < 16; ++i)
+        for (int a = 0; a < channels; ++a)
+            for (int c = 0; c < channels; ++c)
+                cov[a][c] += (b.c[a][i] - mean[a]) * (b.c[c][i] - mean[c]);
+
+    // 바운딩 박스 대각선에서 시작해 공분산 거듭제곱으로 주성분 축에 수렴
+    float axis[4] = {};
+    for (int ch = 0; ch < channels; ++ch) axis[ch] = hi[ch] - lo[ch];
+    const int iterations = quality == BcQuality::Fast ? 1 : 8;
+    for (int it = 0; it < iterations; ++it) {
+        float v[4] = {}, m = 0.0f;
+        for (int a = 0; a < channels; ++a) {
+            for (int c = 0; c < channels; ++c) v[a] += cov[a][c] * axis[c];
+            m = std::max(m, std::fabs(v[a]));
+        }
+        if (m < 1e-6f) break;
+        for (int a = 0; a < channels; ++a) axis[a] = v[a] / m;
+    }
+    float len = 0.0f;
+    for (int ch = 0; ch < channels; ++ch) len += axis[ch] * axis[ch];
+    len = std::sqrt(len);
+
+    float tmin = 0.0f, tmax = 0.0f;
+    if (len > 1e-6f) {
+        for (int ch = 0; ch < channels; ++ch) axis[ch] /= len;
+        tmin = std::numeric_limits<float>::max(); tmax = -tmin;
+        for (int i = 0; i < 16; ++i) {
+            float t = 0.0f;
+            for (int ch = 0; ch < channels; ++ch) t += (b.c[ch][i] - mean[ch]) * axis[ch];
+            tmin = std::min(tmin, t);
+            tmax = std::max(tmax, t);
+        }
+    }
+    for (int ch = 0; ch < 4; ++ch) {
+        const float a = ch < channels ? axis[ch] : 0.0f, m = ch < channels ? mean[ch] : 255.0f;
+        e0[ch] = std::clamp(m + a * tmin, 0.0f, 255.0f);
+        e1[ch] = std::clamp(m + a * tmax, 0.0f, 255.0f);
+    }
+}
+
+// 인덱스를 고정하고 두 끝점을 최소제곱으로 다시 구함 (모든 픽셀이 한 끝점에 몰리면 false)
+bool LeastSquares(const Block& b, int channels, const uint8_t idx[16], const float* t, float e0[4], float e1[4]) {
+    float aa = 0, ab = 0, bb = 0, ax[4] = {}, bx[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        const float w1 = t[idx[i]], w0 = 1.0f - w1;
+        aa += w0 * w0; ab += w0 * w1; bb += w1 * w1;
+        for (int ch = 0; ch < channels; ++ch) { ax[ch] += w0 * b.c[ch][i]; bx[ch] += w1 * b.c[ch][i]; }
+    }
+    const float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) return false;
+    for (int ch = 0; ch < channels; ++ch) {
+        e0[ch] = std::clamp((bb * ax[ch] - ab * bx[ch]) / det, 0.0f, 255.0f);
+        e1[ch] = std::clamp((aa * bx[ch] - ab * ax[ch]) / det, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// BC1 색 끝점 (RGB565). 팔레트: e0, e1, 2/3 e0 + 1/3 e1, 1/3 e0 + 2/3 e1 (4색 모드)
+struct Bc1Codec {
+    static constexpr int kCount = 4, kChannels = 3;
+    static constexpr float kT[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+    uint16_t q0 = 0, q1 = 0;
+
+    static uint16_t Pack(const float e[4]) {
+        const int r = (int)std::lround(e[0] * 31.0f / 255.0f);
+        const int g = (int)std::lround(e[1] * 63.0f / 255.0f);
+        const int b = (int)std::lround(e[2] * 31.0f / 255.0f);
+        return (uint16_t)((r << 11) | (g << 5) | b);
+    }
+    static void Unpack(uint16_t c, float out[4]) {
+        const int r = c >> 11, g = (c >> 5) & 63, b = c & 31;
+        out[0] = (float)((r << 3) | (r >> 2));
+        out[1] = (float)((g << 2) | (g >> 4));
+        out[2] = (float)((b << 3) | (b >> 2));
+        out[3] = 255.0f;
+    }
+    void Quantize(const float e0[4], const float e1[4]) { q0 = Pack(e0); q1 = Pack(e1); }
+    void Palette(float pal[4][4]) const {
+        Unpack(q0, pal[0]);
+        Unpack(q1, pal[1]);
+        for (int ch = 0; ch < 4; ++ch) {
+            pal[2][ch] = std::floor((2.0f * pal[0][ch] + pal[1][ch] + 1.0f) / 3.0f);
+            pal[3][ch] = std::floor((pal[0][ch] + 2.0f * pal[1][ch] + 1.0f) / 3.0f);
+        }
+    }
+};
+
+// BC7 모드 6 끝점 (RGBA 7비트 + 끝점별 p비트 → 8비트). 16단계 보간
+struct Bc7Codec {
+    static constexpr int kCount = 16, kChannels = 4;
+    static constexpr int kWeights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+    static constexpr float kT[16] = { 0 / 64.f, 4 / 64.f, 9 / 64.f, 13 / 64.f, 17 / 64.f, 21 / 64.f, 26 / 64.f, 30 / 64.f,
+                                      34 / 64.f, 38 / 64.f, 43 / 64.f, 47 / 64.f, 51 / 64.f, 55 / 64.f, 60 / 64.f, 64 / 64.f };
+    uint8_t q[2][4] = {};
+    uint8_t p[2] = {};
+
+    // p비트는 끝점마다 따로 → 각 끝점에서 양자화 오차가 작은 쪽을 고르면 최적
+    void Quantize(const float e0[4], const float e1[4]) {
+        const float* e[2] = { e0, e1 };
+        for (int k = 0; k < 2; ++k) {
+            float bestErr = std::numeric_limits<float>::max();
+            for (int pb = 0; pb < 2; ++pb) {
+                uint8_t qq[4];
+                float err = 0.0f;
+                for (int ch = 0; ch < 4; ++ch) {
+                    qq[ch] = (uint8_t)std::clamp((int)std::lround((e[k][ch] - pb) / 2.0f), 0, 127);
+                    const float d = (float)((qq[ch] << 1) | pb) - e[k][ch];
+                    err += d * d;
+                }
+                if (err < bestErr) { bestErr = err; p[k] = (uint8_t)pb; std::memcpy(q[k], qq, 4); }
+            }
+        }
+    }
+    void Palette(float pal[16][4]) const {
+        for (int ch = 0; ch < 4; ++ch) {
+            const int a = (q[0][ch] << 1) | p[0], b = (q[1][ch] << 1) | p[1];
+            for (int i = 0; i < 16; ++i)
+                pal[i][ch] = (float)(((64 - kWeights[i]) * a + kWeights[i] * b + 32) >> 6);
+        }
+    }
+};
+
+// 주성분 끝점 → 인덱스 → 최소제곱 재계산을 quality만큼 반복 (나빠지면 멈춤)
+template <typename Codec>
+float FitBlock(const Block& b, BcQuality quality, Codec& codec, float pal[][4], uint8_t idx[16]) {
+    float e0[4], e1[4];
+    PrincipalEndpoints(b, Codec::kChannels, quality, e0, e1);
+    codec.Quantize(e0, e1);
+    codec.Palette(pal);
+    float err = FitIndices(b, pal, Codec::kCount, Codec::kChannels, idx);
+
+    const int iterations = quality == BcQuality::Fast ? 0 : quality == BcQuality::Normal ? 1 : 4;
+    for (int it = 0; it < iterations && err > 0.0f; ++it) {
+        if (!LeastSquares(b, Codec::kChannels, idx, Codec::kT, e0, e1)) break;
+        Codec trial = codec;
+        trial.Quantize(e0, e1);
+        float trialPal[Codec::kCount][4];
+        trial.Palette(trialPal);
+        uint8_t trialIdx[16];
+        const float trialErr = FitIndices(b, trialPal, Codec::kCount, Codec::kChannels, trialIdx);
+        if (trialErr >= err) break;
+        codec = trial;
+        err = trialErr;
+        std::memcpy(pal, trialPal, sizeof(trialPal));
+        std::memcpy(idx, trialIdx, 16);
+    }
+    return err;
+}
+
+// 이미지 안쪽 픽셀만 (가장자리 블록에서 반복해 채운 픽셀은 제외)
+double SqError(const Block& b, int srcCh, const float (*pal)[4], int palCh, int channels,
+               const uint8_t idx[16], int vw, int vh) {
+    double sum = 0.0;
+    for (int y = 0; y < vh; ++y)
+        for (int x = 0; x < vw; ++x) {
+            const int i = y * 4 + x;
+            for (int ch = 0; ch < channels; ++ch) {
+                const double d = b.c[srcCh + ch][i] - pal[idx[i]][palCh + ch];
+                sum += d * d;
+            }
+        }
+    return sum;
+}
+
+void WriteBc1(Bc1Codec c, uint8_t idx[16], unsigned char* out) {
+    // 4색 모드는 c0 > c1이어야 함. 뒤바꾸면 인덱스 0↔1, 2↔3
+    if (c.q0 < c.q1) {
+        std::swap(c.q0, c.q1);
+        for (int i = 0; i < 16; ++i) idx[i] ^= 1;
+    } else if (c.q0 == c.q1) {
+        std::memset(idx, 0, 16);   // 3색 모드가 되므로 전부 c0
+    }
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= (uint32_t)idx[i] << (2 * i);
+    out[0] = (unsigned char)(c.q0 & 0xff); out[1] = (unsigned char)(c.q0 >> 8);
+    out[2] = (unsigned char)(c.q1 & 0xff); out[3] = (unsigned char)(c.q1 >> 8);
+    for (int k = 0; k < 4; ++k) out[4 + k] = (unsigned char)(bits >> (8 * k));
+}
+
+// BC4 알파 블록. a0 > a1이면 8단계, 아니면 6단계 + 0/255
+void AlphaPalette(int a0, int a1, float pal[8][4]) {
+    pal[0][0] = (float)a0;
+    pal[1][0] = (float)a1;
+    if (a0 > a1) {
+        for (int i = 2; i < 8; ++i) pal[i][0] = (float)(((8 - i) * a0 + (i - 1) * a1 + 3) / 7);
+    } else {
+        for (int i = 2; i < 6; ++i) pal[i][0] = (float)(((6 - i) * a0 + (i - 1) * a1 + 2) / 5);
+        pal[6][0] = 0.0f;
+        pal[7][0] = 255.0f;
+    }
+}
+
+// 알파를 인코딩하고 블록 오차 계산용 팔레트/인덱스를 돌려줌
+void EncodeAlpha(const Block& b, BcQuality quality, unsigned char* out, float pal[8][4], uint8_t idx[16]) {
+    Block ab;
+    std::memcpy(ab.c[0], b.c[3], sizeof(ab.c[0]));
+    int lo = 255, hi = 0, innerLo = 255, innerHi = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int a = (int)b.c[3][i];
+        lo = std::min(lo, a); hi = std::max(hi, a);
+        if (a != 0 && a != 255) { innerLo = std::min(innerLo, a); innerHi = std::max(innerHi, a); }
+    }
+
+    // 8단계: a0=최대, a1=최소 (같으면 6단계 해석이지만 인덱스 0 = a0이라 그대로 정확)
+    int a0 = hi, a1 = lo;
+    AlphaPalette(a0, a1, pal);
+    float err = FitIndices(ab, pal, 8, 1, idx);
+
+    // 6단계 + 0/255: 완전 투명/불투명 픽셀과 중간값이 섞인 블록(안티앨리어싱 가장자리)에 유리
+    if (quality != BcQuality::Fast && err > 0.0f && (lo == 0 || hi == 255)) {
+        const int c0 = innerLo <= innerHi ? innerLo : 0, c1 = innerLo <= innerHi ? innerHi : 255;
+        float pal6[8][4];
+        uint8_t idx6[16];
+        AlphaPalette(c0, c1, pal6);
+        const float err6 = FitIndices(ab, pal6, 8, 1, idx6);
+        if (err6 < err) {
+            a0 = c0; a1 = c1;
+            std::memcpy(pal, pal6, sizeof(pal6));
+            std::memcpy(idx, idx6, 16);
+        }
+    }
+
+    out[0] = (unsigned char)a0;
+    out[1] = (unsigned char)a1;
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i) bits |= (uint64_t)idx[i] << (3 * i);
+    for (int k = 0; k < 6; ++k) out[2 + k] = (unsigned char)(bits >> (8 * k));
+}
+
+// 128비트 블록에 LSB부터 채움
+struct BitWriter {
+    unsigned char* out;
+    int pos = 0;
+    void Put(uint32_t v, int n) {
+        for (int i = 0; i < n; ++i, ++pos)
+            if (v >> i & 1) out[pos >> 3] |= (unsigned char)(1u << (pos & 7));
+    }
+};
+
+void WriteBc7Mode6(Bc7Codec c, uint8_t idx[16], unsigned char* out) {
+    // 첫 픽셀(앵커) 인덱스의 최상위 비트는 저장하지 않음 → 0이 되도록 끝점을 뒤집음
+    // (가중치가 대칭이라 인덱스 i ↔ 15 - i로 같은 색)
+    if (idx[0] >= 8) {
+        std::swap(c.q[0], c.q[1]);
+        std::swap(c.p[0], c.p[1]);
+        for (int i = 0; i < 16; ++i) idx[i] = (uint8_t)(15 - idx[i]);
+    }
+    std::memset(out, 0, 16);
+    BitWriter bw{ out };
+    bw.Put(1u << 6, 7);   // 모드 6
+    for (int ch = 0; ch < 4; ++ch) { bw.Put(c.q[0][ch], 7); bw.Put(c.q[1][ch], 7); }
+    bw.Put(c.p[0], 1);
+    bw.Put(c.p[1], 1);
+    bw.Put(idx[0], 3);
+    for (int i = 1; i < 16; ++i) bw.Put(idx[i], 4);
+}
+
+void EncodeBlock(const Block& b, const BcEncodeOptions& options, int vw, int vh, unsigned char* out, BcEncodeStats& stats) {
+    uint8_t idx[16];
+    switch (options.format) {
+    case BcFormat::BC1: {
+        Bc1Codec codec;
+        float pal[4][4];
+        FitBlock(b, options.quality, codec, pal, idx);
+        stats.sqErrRgb += SqError(b, 0, pal, 0, 3, idx, vw, vh);
+        stats.sqErrAlpha += SqError(b, 3, pal, 3, 1, idx, vw, vh);   // 알파는 항상 255로 디코드됨
+        WriteBc1(codec, idx, out);
+        break;
+    }
+    case BcFormat::BC3: {
+        float apal[8][4];
+        EncodeAlpha(b, options.quality, out, apal, idx);
+        stats.sqErrAlpha += SqError(b, 3, apal, 0, 1, idx, vw, vh);
+        Bc1Codec codec;
+        float pal[4][4];
+        FitBlock(b, options.quality, codec, pal, idx);
+        stats.sqErrRgb += SqError(b, 0, pal, 0, 3, idx, vw, vh);
+        WriteBc1(codec, idx, out + 8);
+        break;
+    }
+    case BcFormat::BC7: {
+        Bc7Codec codec;
+        float pal[16][4];
+        FitBlock(b, options.quality, codec, pal, idx);
+        stats.sqErrRgb += SqError(b, 0, pal, 0, 3, idx, vw, vh);
+        stats.sqErrAlpha += SqError(b, 3, pal, 3, 1, idx, vw, vh);
+        WriteBc7Mode6(codec, idx, out);
+        break;
+    }
+    }
+    stats.pixels += (size_t)vw * vh;
+    ++stats.blocks;
+}
+
+double Psnr(double sqErr, size_t samples) {
+    if (samples == 0 || sqErr <= 0.0) return std::numeric_limits<double>::infinity();
+    return 10.0 * std::log10(255.0 * 255.0 / (sqErr / (double)samples));
+}
+
+size_t BlockBytes(BcFormat format) { return format == BcFormat::BC1 ? 8 : 16; }
+}
+
+double BcEncodeStats::PsnrRgb() const { return Psnr(sqErrRgb, pixels * 3); }
+double BcEncodeStats::PsnrAlpha() const { return Psnr(sqErrAlpha, pixels); }
+
+void BcEncodeStats::Add(const BcEncodeStats& o) {
+    blocks += o.blocks;
+    pixels += o.pixels;
+    sqErrRgb += o.sqErrRgb;
+    sqErrAlpha += o.sqErrAlpha;
+    ms += o.ms;
+}
+
+size_t BcCompressedSize(BcFormat format, int w, int h) {
+    return (size_t)((w + 3) / 4) * ((h + 3) / 4) * BlockBytes(format);
+}
+
+GLenum BcInternalFormat(BcFormat format) {
+    switch (format) {
+    case BcFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case BcFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case BcFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    }
+    return 0;
+}
+
+const char* BcFormatName(BcFormat format) {
+    switch (format) {
+    case BcFormat::BC1: return "BC1";
+    case BcFormat::BC3: return "BC3";
+    case BcFormat::BC7: return "BC7";
+    }
+    return "?";
+}
+
+void EncodeBc(const unsigned char* rgba, int w, int h, const BcEncodeOptions& options,
+              unsigned char* out, BcEncodeStats* stats) {
+    auto t0 = std::chrono::steady_clock::now();
+    const int bw = (w + 3) / 4, bh = (h + 3) / 4;
+    const size_t blockBytes = BlockBytes(options.format);
+    int threads = options.threads > 0 ? options.threads : (int)std::thread::hardware_concurrency();
+    threads = std::clamp(threads, 1, bh);
+
+    // 블록 행을 번갈아 나눠 가짐 (이미지 위아래의 복잡도 차이가 한 스레드에 몰리지 않도록)
+    std::vector<BcEncodeStats> parts(threads);
+    auto work = [&](int t) {
+        Block b;
+        for (int by = t; by < bh; by += threads) {
+            const int vh = std::min(4, h - by * 4);
+            for (int bx = 0; bx < bw; ++bx) {
+                LoadBlock(rgba, w, h, bx, by, b);
+                EncodeBlock(b, options, std::min(4, w - bx * 4), vh, out + ((size_t)by * bw + bx) * blockBytes, parts[t]);
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (std::thread& th : pool) th.join();
+
+    if (stats) {
+        BcEncodeStats total;
+        for (const BcEncodeStats& p : parts) total.Add(p);
+        total.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        stats->Add(total);
+    }
+}
+
+void PrintBcStats(FILE* out, const char* name, BcFormat format, const BcEncodeStats& stats) {
+    const double mpps = stats.ms > 0.0 ? stats.pixels / (stats.ms * 1000.0) : 0.0;
+    fprintf(out, "[BcEncoder] %s %s | %zu blocks, %.2f ms (%.1f MPix/s) | PSNR rgb %.2f dB, alpha %.2f dB\n",
+            name, BcFormatName(format), stats.blocks, stats.ms, mpps, stats.PsnrRgb(), stats.PsnrAlpha());
+}
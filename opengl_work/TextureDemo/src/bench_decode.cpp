@@ -0,0 +1,349 @@
+// 이미지 디코드 벤치마크 (GL 없음)
+//  - JPEG 커널(IDCT / 4:2:0 업샘플 / YCbCr→RGB)을 스칼라·SSE2·AVX2·AVX-512별로 재고 스칼라 결과와 비교
+//  - 파일마다 커널별 디코드 결과를 스칼라 커널 디코드와 비교
+//  - 파일마다 디코드 스레드 1/2/4/8개로 stbi_load_from_memory 시간을 재고, 1스레드 결과와 바이트 단위로 비교
+//  - JPEG가 아닌 파일(PNG 등)은 커널/스레드 비교 없이 1스레드 디코드 시간만
+//  - 손대지 않은 stb_image v2.30(stb_image_baseline)과 1스레드 디코드 속도 비교, 결과 일치 확인
+//    (PNG는 목표 x2 달성 여부도 표시. PNG 모음으로 재려면 파일을 인자로 넘김)
+//  - 행 밴드 스트리밍 디코드(stbi_load_rows_from_memory)의 첫 밴드까지 시간 / 전체 시간, 1스레드 결과와 비교
+//  - 스레드별 아레나(image_arena) 안/밖 stbi_load_from_memory_into 시간과 디코드당 stb 할당 수 (첫 회 / 이후)
+//  - 행 끝에 패딩이 있는 stride로 stbi_load_from_memory_into (위→아래 / 아래→위): 픽셀이 같고 패딩이 그대로인지
+// 사용법: DecodeBench [반복 횟수] [이미지 ...]   (이미지를 주지 않으면 assets/container.jpg, awesomeface.png)
+#include "image_arena.h"
+#include "image_decode_pool.h"
+#include "jpeg_simd.h"
+#include "stb_image.h"
+#include "stb_image_baseline.h"
+#include "vfs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+struct Decoded {
+    std::vector<unsigned char> pixels;
+    int w = 0, h = 0, channels = 0;
+    double ms = 0.0;
+};
+
+bool Decode(const FileView& file, int iterations, Decoded* out) {
+    double total = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        unsigned char* px = stbi_load_from_memory(file.data(), (int)file.size(), &out->w, &out->h, &out->channels, 0);
+        total += MsSince(t0);
+        if (!px) return false;
+        if (i == 0) out->pixels.assign(px, px + (size_t)out->w * out->h * out->channels);
+        stbi_image_free(px);
+    }
+    out->ms = total / iterations;
+    return true;
+}
+
+// Decode()와 같은 방식으로 기준선 stb 디코드
+bool DecodeBaseline(const FileView& file, int iterations, Decoded* out) {
+    double total = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        unsigned char* px = BaselineStbiLoadFromMemory(file.data(), (int)file.size(), &out->w, &out->h, &out->channels, 0);
+        total += MsSince(t0);
+        if (!px) return false;
+        if (i == 0) out->pixels.assign(px, px + (size_t)out->w * out->h * out->channels);
+        BaselineStbiFree(px);
+    }
+    out->ms = total / iterations;
+    return true;
+}
+
+// 밴드를 이어 붙여 전체 이미지로. firstMs는 첫 밴드가 나온 시각
+struct Streamed {
+    Decoded* out;
+    std::chrono::steady_clock::time_point t0;
+    double firstMs = -1.0;
+};
+
+bool DecodeStreamed(const FileView& file, int iterations, int bandRows, Decoded* out, double* firstMs) {
+    const stbi_row_callbacks cb = {
+        [](void* user, int x, int y, int, int channels) {
+            Decoded* d = ((Streamed*)user)->out;
+            d->w = x; d->h = y; d->channels = channels;
+            d->pixels.resize((size_t)x * y * channels);
+            return 1;
+        },
+        [](void* user, const stbi_uc* data, int y0, int count) {
+            Streamed* s = (Streamed*)user;
+            if (s->firstMs < 0) s->firstMs = MsSince(s->t0);
+            const size_t stride = (size_t)s->out->w * s->out->channels;
+            std::memcpy(s->out->pixels.data() + stride * y0, data, stride * count);
+            return 1;
+        },
+    };
+    double total = 0.0, first = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        Streamed s{ out, std::chrono::steady_clock::now() };
+        int w, h, c;
+        if (!stbi_load_rows_from_memory(file.data(), (int)file.size(), &cb, &s, bandRows, &w, &h, &c, 0)) return false;
+        total += MsSince(s.t0);
+        first += s.firstMs;
+    }
+    out->ms = total / iterations;
+    *firstMs = first / iterations;
+    return true;
+}
+
+// 같은 이미지를 아레나 스코프 밖(힙)과 안에서 디코드. 출력은 호출자 버퍼 (스코프 밖으로 안 나감)
+struct ArenaRun {
+    std::vector<unsigned char> pixels;
+    double heapMs = 0.0, arenaMs = 0.0;
+    size_t firstAllocs = 0, firstHeap = 0, allocs = 0, heap = 0;   // 첫 디코드 / 마지막 디코드
+};
+
+bool DecodeArena(const FileView& file, int iterations, ArenaRun* out) {
+    int w, h, c;
+    if (!stbi_info_from_memory(file.data(), (int)file.size(), &w, &h, &c)) return false;
+    out->pixels.resize((size_t)w * h * c);
+    auto decode = [&] {
+        return stbi_load_from_memory_into(file.data(), (int)file.size(), out->pixels.data(), w * c, 0, &w, &h, &c, c) != 0;
+    };
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        if (!decode()) return false;
+        out->heapMs += MsSince(t0);
+    }
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        ImageArenaScope arena(ImageArenaEstimate(file.data(), file.size()));
+        if (!decode()) return false;
+        out->arenaMs += MsSince(t0);
+        if (i == 0) { out->firstAllocs = arena.Allocations(); out->firstHeap = arena.HeapAllocations(); }
+        out->allocs = arena.Allocations();
+        out->heap = arena.HeapAllocations();
+    }
+    out->heapMs /= iterations;
+    out->arenaMs /= iterations;
+    return true;
+}
+
+// 행마다 kPad바이트 패딩을 둔 버퍼로 디코드. 패딩을 건드렸거나 픽셀이 base와 다르면 false
+constexpr size_t kPad = 5;
+constexpr unsigned char kPadByte = 0xA5;
+
+bool CheckPaddedStride(const FileView& file, const Decoded& base, int bottomUp) {
+    const size_t row = (size_t)base.w * base.channels, stride = row + kPad;
+    std::vector<unsigned char> buf(stride * base.h, kPadByte);
+    int w, h, c;
+    if (!stbi_load_from_memory_into(file.data(), (int)file.size(), buf.data(), (int)stride, bottomUp, &w, &h, &c,
+                                    base.channels))
+        return false;
+    for (int y = 0; y < base.h; ++y) {
+        const unsigned char* p = buf.data() + stride * (bottomUp ? base.h - 1 - y : y);
+        if (std::memcmp(p, base.pixels.data() + row * y, row) != 0) return false;
+        for (size_t i = row; i < stride; ++i)
+            if (p[i] != kPadByte) return false;
+    }
+    return true;
+}
+
+bool IsJpeg(const FileView& file) {
+    return file.size() >= 2 && file.data()[0] == 0xFF && file.data()[1] == 0xD8;
+}
+
+constexpr JpegKernel kKernels[] = { JpegKernel::Scalar, JpegKernel::Sse2, JpegKernel::Avx2, JpegKernel::Avx512 };
+
+// 커널 하나를 iterations번 돌린 평균 ms. run()은 출력 버퍼를 채움
+template <typename Fn>
+double TimeKernel(int iterations, Fn run) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) run();
+    return MsSince(t0) / iterations;
+}
+
+void PrintKernel(const char* what, JpegKernel kernel, double ms, double baseMs, double units, const char* unit,
+                 bool exact) {
+    printf("[DecodeBench] kernel %-8s %-6s %8.4f ms (x%.2f, %.1f %s/s) %s\n", what, JpegKernelName(kernel), ms,
+           ms > 0 ? baseMs / ms : 0.0, ms > 0 ? units / (ms * 1000.0) : 0.0, unit, exact ? "bit-exact" : "MISMATCH");
+}
+
+// 커널 단위 마이크로벤치. 입력은 고정 시드 난수, 너비는 벡터 폭으로 나누어떨어지지 않게 (끝 처리까지 비교)
+int BenchKernels(int iterations) {
+    unsigned seed = 12345;
+    auto rnd = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    int failed = 0;
+
+    // IDCT: 역양자화된 계수 블록. DC는 넓게, AC는 고주파일수록 작게 (실제 이미지와 비슷한 분포)
+    constexpr int kBlocks = 4096;
+    std::vector<short> coeff((size_t)kBlocks * 64 + 8);
+    short* blocks = coeff.data() + ((16 - ((uintptr_t)coeff.data() & 15)) & 15) / sizeof(short);   // 16바이트 정렬
+    for (int b = 0; b < kBlocks; ++b)
+        for (int k = 0; k < 64; ++k) {
+            const int range = k == 0 ? 2048 : 1024 >> std::min(9, (k / 8 + k % 8));
+            blocks[b * 64 + k] = (short)((int)(rnd() % (2 * range + 1)) - range);
+        }
+
+    // 업샘플 / 색 변환: 한 행
+    constexpr int kWidth = 1021;
+    std::vector<unsigned char> nearRow(kWidth + 64), farRow(kWidth + 64), yRow(2 * kWidth), cbRow(2 * kWidth), crRow(2 * kWidth);
+    for (auto* v : { &nearRow, &farRow, &yRow, &cbRow, &crRow })
+        for (unsigned char& c : *v) c = (unsigned char)rnd();
+
+    std::vector<unsigned char> idctBase, hvBase, rgbBase[2];
+    double idctMs = 0, hvMs = 0, rgbMs[2] = {};
+    for (JpegKernel kernel : kKernels) {
+        stbi_jpeg_kernels k;
+        if (!GetJpegKernels(kernel, &k)) continue;
+        const bool base = kernel == JpegKernel::Scalar;
+
+        std::vector<unsigned char> idctOut((size_t)kBlocks * 64);
+        double ms = TimeKernel(iterations, [&] {
+            for (int b = 0; b < kBlocks; ++b) k.idct_block(idctOut.data() + b * 64, 8, blocks + b * 64);
+        });
+        if (base) { idctBase = idctOut; idctMs = ms; }
+        if (idctOut != idctBase) ++failed;
+        PrintKernel("idct", kernel, ms, idctMs, kBlocks, "Mblock", idctOut == idctBase);
+
+        std::vector<unsigned char> hvOut(2 * kWidth);
+        ms = TimeKernel(iterations * 64, [&] { k.resample_row_hv_2(hvOut.data(), nearRow.data(), farRow.data(), kWidth, 2); });
+        if (base) { hvBase = hvOut; hvMs = ms; }
+        if (hvOut != hvBase) ++failed;
+        PrintKernel("hv2", kernel, ms, hvMs, 2 * kWidth, "MPix", hvOut == hvBase);
+
+        for (int step = 3; step <= 4; ++step) {
+            // step 3은 마지막 픽셀 뒤 1바이트까지 씀
+            std::vector<unsigned char> rgbOut((size_t)kWidth * step + 1);
+            ms = TimeKernel(iterations * 64, [&] {
+                k.YCbCr_to_RGB(rgbOut.data(), yRow.data(), cbRow.data(), crRow.data(), kWidth, step);
+            });
+            rgbOut.resize((size_t)kWidth * step);
+            if (base) { rgbBase[step - 3] = rgbOut; rgbMs[step - 3] = ms; }
+            if (rgbOut != rgbBase[step - 3]) ++failed;
+            PrintKernel(step == 3 ? "ycc-rgb" : "ycc-rgba", kernel, ms, rgbMs[step - 3], kWidth, "MPix",
+                        rgbOut == rgbBase[step - 3]);
+        }
+    }
+    return failed;
+}
+}
+
+int main(int argc, char** argv) {
+    int iterations = 20;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (i == 1 && std::atoi(argv[i]) > 0) iterations = std::atoi(argv[i]);
+        else files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        files.push_back(std::string(ASSET_SOURCE_DIR) + "/container.jpg");
+        files.push_back(std::string(ASSET_SOURCE_DIR) + "/awesomeface.png");
+    }
+
+    int failed = BenchKernels(iterations);
+    for (const std::string& path : files) {
+        FileView file = GetVfs().Open(path);
+        if (!file) { ++failed; continue; }
+        const bool jpeg = IsJpeg(file);
+
+        // 커널별 전체 디코드 (1스레드). 스칼라 커널 결과와 비교
+        SetImageDecodeThreads(1);
+        Decoded scalar;
+        for (JpegKernel kernel : kKernels) {
+            if (!jpeg) break;
+            if (!IsJpegKernelSupported(kernel)) continue;
+            SetJpegKernel(kernel);
+            Decoded d;
+            if (!Decode(file, iterations, &d)) break;
+            if (kernel == JpegKernel::Scalar) scalar = d;
+            const bool exact = d.pixels == scalar.pixels;
+            if (!exact) ++failed;
+            printf("[DecodeBench] %s %dx%dx%d | kernel %-6s %.3f ms (x%.2f) %s\n", path.c_str(), d.w, d.h, d.channels,
+                   JpegKernelName(kernel), d.ms, d.ms > 0 ? scalar.ms / d.ms : 0.0, exact ? "bit-exact" : "MISMATCH");
+        }
+        SetJpegKernel(JpegKernel::Auto);
+
+        Decoded base;
+        for (int threads : { 1, 2, 4, 8 }) {
+            if (!jpeg && threads > 1) break;
+            SetImageDecodeThreads(threads);
+            Decoded d;
+            if (!Decode(file, iterations, &d)) {
+                fprintf(stderr, "[DecodeBench] %s: %s\n", path.c_str(), stbi_failure_reason());
+                ++failed;
+                break;
+            }
+            if (threads == 1) base = d;
+            const bool exact = d.pixels == base.pixels;
+            if (!exact) ++failed;
+            printf("[DecodeBench] %s %dx%dx%d | %d threads %.3f ms (x%.2f, %.1f MPix/s) %s\n", path.c_str(), d.w, d.h,
+                   d.channels, threads, d.ms, d.ms > 0 ? base.ms / d.ms : 0.0, d.ms > 0 ? d.w * d.h / (d.ms * 1000.0) : 0.0,
+                   exact ? "bit-exact" : "MISMATCH");
+        }
+
+        // 기준선 stb와 비교 (둘 다 1스레드)
+        Decoded baseline;
+        if (!base.pixels.empty() && DecodeBaseline(file, iterations, &baseline)) {
+            const bool exact = baseline.pixels == base.pixels && baseline.w == base.w && baseline.h == base.h;
+            if (!exact) ++failed;
+            const double speedup = base.ms > 0 ? baseline.ms / base.ms : 0.0;
+            printf("[DecodeBench] %s %dx%dx%d | baseline stb %.3f ms (%.1f MPix/s) vs %.3f ms: x%.2f%s %s\n", path.c_str(),
+                   base.w, base.h, base.channels, baseline.ms, baseline.ms > 0 ? base.w * base.h / (baseline.ms * 1000.0) : 0.0,
+                   base.ms, speedup, jpeg ? "" : speedup >= 2.0 ? " (PNG target x2 met)" : " (PNG target x2 NOT met)",
+                   exact ? "bit-exact" : "MISMATCH");
+        } else if (!base.pixels.empty()) {
+            fprintf(stderr, "[DecodeBench] %s: baseline stb failed\n", path.c_str());
+            ++failed;
+        }
+
+        // 스트리밍 (1스레드, 64행 밴드): 첫 밴드가 업로드를 시작할 수 있는 시점
+        SetImageDecodeThreads(1);
+        Decoded streamed;
+        double firstMs = 0.0;
+        if (!base.pixels.empty() && DecodeStreamed(file, iterations, 64, &streamed, &firstMs)) {
+            const bool exact = streamed.pixels == base.pixels;
+            if (!exact) ++failed;
+            printf("[DecodeBench] %s %dx%dx%d | streamed 64-row bands: first band %.3f ms, all %.3f ms (whole %.3f ms) %s\n",
+                   path.c_str(), streamed.w, streamed.h, streamed.channels, firstMs, streamed.ms, base.ms,
+                   exact ? "bit-exact" : "MISMATCH");
+        } else if (!base.pixels.empty()) {
+            fprintf(stderr, "[DecodeBench] %s: streamed: %s\n", path.c_str(), stbi_failure_reason());
+            ++failed;
+        }
+
+        ArenaRun arena;
+        if (!base.pixels.empty() && DecodeArena(file, iterations, &arena)) {
+            const bool exact = arena.pixels == base.pixels;
+            if (!exact) ++failed;
+            printf("[DecodeBench] %s %dx%dx%d | arena %.3f ms vs heap %.3f ms | stb allocs/decode %zu (heap %zu), first %zu (heap %zu) %s\n",
+                   path.c_str(), base.w, base.h, base.channels, arena.arenaMs, arena.heapMs, arena.allocs, arena.heap,
+                   arena.firstAllocs, arena.firstHeap, exact ? "bit-exact" : "MISMATCH");
+        } else if (!base.pixels.empty()) {
+            fprintf(stderr, "[DecodeBench] %s: arena: %s\n", path.c_str(), stbi_failure_reason());
+            ++failed;
+        }
+
+        // 커널마다 행 끝 여분 바이트 처리가 달라서 (스칼라는 RGB 뒤에 1바이트를 씀) 커널별로
+        for (JpegKernel kernel : kKernels) {
+            if (base.pixels.empty() || (jpeg ? !IsJpegKernelSupported(kernel) : kernel != JpegKernel::Scalar)) continue;
+            SetJpegKernel(kernel);
+            for (int bottomUp = 0; bottomUp <= 1; ++bottomUp) {
+                const bool ok = CheckPaddedStride(file, base, bottomUp);
+                if (!ok) ++failed;
+                printf("[DecodeBench] %s %dx%dx%d | into stride +%zu %-9s kernel %-6s %s\n", path.c_str(), base.w,
+                       base.h, base.channels, kPad, bottomUp ? "bottom-up" : "top-down",
+                       jpeg ? JpegKernelName(kernel) : "-", ok ? "bit-exact, padding intact" : "MISMATCH");
+            }
+        }
+        SetJpegKernel(JpegKernel::Auto);
+    }
+    SetImageDecodeThreads(1);
+    PrintImageArenaStats(stdout);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,191 @@
+// 텍스처 로딩 벤치마크 (숨긴 창 + GL 컨텍스트)
+//  - stb:    Vfs 매핑 + stbi_load_from_memory(뒤집기) + glTexImage2D + glGenerateMipmap (main_single과 같은 경로)
+//  - cooked: Vfs 매핑 + .gtex 레벨 업로드 (디코드/밉 생성 없음)
+//  - bc:     블록 압축된 .bc.gtex (컨텍스트가 포맷을 지원할 때만)
+//  - mips:   glGenerateMipmap 대 CPU 밉 생성 (커널 x 필터별 MPix/s)
+//  - atlas:  작은 스프라이트 여러 장을 텍스처 하나에 채우고 절반을 빼고 다시 넣었을 때의 점유율/조각화
+// 각 반복은 glFinish까지 포함한 시간. 사용법: TextureBench [반복 횟수]
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "cooked_texture.h"
+#include "gl_state.h"
+#include "mip_builder.h"
+#include "stb_image.h"
+#include "texture_atlas.h"
+#include "vfs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// main_single의 업로드 경로
+GLuint LoadWithStb(const std::string& path) {
+    FileView file = GetVfs().Open(path);
+    if (!file) return 0;
+    stbi_set_flip_vertically_on_load(true);
+    int w, h, nc = 0;
+    unsigned char* data = stbi_load_from_memory(file.data(), (int)file.size(), &w, &h, &nc, 0);
+    if (!data) return 0;
+    GLuint tex;
+    glGenTextures(1, &tex);
+    GetGlState().BindTexture(0, GL_TEXTURE_2D, tex);
+    const GLenum fmt = (nc == 4) ? GL_RGBA : GL_RGB;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, fmt, w, h, 0, fmt, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    stbi_image_free(data);
+    return tex;
+}
+
+// 레벨 0이 올라간 텍스처에서 glGenerateMipmap만 잰 시간
+double TimeGpuMips(const unsigned char* px, int w, int h, int nc, int iterations) {
+    const GLenum fmt = (nc == 4) ? GL_RGBA : GL_RGB;
+    double total = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        GLuint tex;
+        glGenTextures(1, &tex);
+        GetGlState().BindTexture(0, GL_TEXTURE_2D, tex);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, fmt, w, h, 0, fmt, GL_UNSIGNED_BYTE, px);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glFinish();
+        auto t0 = std::chrono::steady_clock::now();
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glFinish();
+        total += MsSince(t0);
+        GetGlState().ForgetTexture(tex);
+        glDeleteTextures(1, &tex);
+    }
+    return total / iterations;
+}
+
+void BenchMips(const char* name, const std::string& path, int iterations) {
+    FileView file = GetVfs().Open(path);
+    int w, h, nc;
+    unsigned char* px = file ? stbi_load_from_memory(file.data(), (int)file.size(), &w, &h, &nc, 0) : nullptr;
+    if (!px) return;
+    const double gpuMs = TimeGpuMips(px, w, h, nc, iterations);
+    printf("  %-12s mips: glGenerateMipmap %.3f ms (%.1f MPix/s)\n", name, gpuMs, gpuMs > 0 ? w * h / (gpuMs * 1000.0) : 0.0);
+    for (MipKernel kernel : { MipKernel::Scalar, MipKernel::Sse2, MipKernel::Avx2 }) {
+        if (!IsMipKernelSupported(kernel)) continue;
+        for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser }) {
+            MipOptions options;
+            options.kernel = kernel;
+            options.filter = filter;
+            MipStats stats;
+            for (int i = 0; i < iterations; ++i) BuildMipChain(px, w, h, nc, options, &stats);
+            printf("  %-12s mips: cpu %-6s %-6s %.3f ms (%.1f MPix/s, %d threads)\n", name, stats.kernel,
+                   filter == MipFilter::Box ? "box" : "kaiser", stats.ms / iterations, stats.MPixPerSec(),
+                   std::max(1, (int)std::thread::hardware_concurrency()));
+        }
+    }
+    stbi_image_free(px);
+}
+
+// 16~128px 스프라이트(크기는 고정 시드)를 가득 채운 뒤 절반을 빼고 다른 크기로 다시 채움
+void BenchAtlas() {
+    TextureAtlas atlas;
+    if (!atlas.Init()) return;
+    unsigned seed = 12345;
+    auto next = [&](int lo, int hi) { seed = seed * 1664525u + 1013904223u; return lo + (int)((seed >> 16) % (unsigned)(hi - lo + 1)); };
+    std::vector<unsigned char> px(128 * 128 * 4, 200);
+    auto fill = [&](const char* prefix) {
+        int added = 0;
+        for (int i = 0, misses = 0; misses < 8; ++i) {
+            const int w = next(16, 128), h = next(16, 128);
+            if (atlas.Add(prefix + std::to_string(i), px.data(), w, h, 4)) ++added;
+            else ++misses;
+        }
+        return added;
+    };
+    auto t0 = std::chrono::steady_clock::now();
+    const int first = fill("a");
+    glFinish();
+    printf("  atlas fill:   %d sprites in %.3f ms, occupancy %.1f%% fragmentation %.2f\n", first, MsSince(t0),
+           atlas.Occupancy() * 100.0f, atlas.Fragmentation());
+    for (int i = 0; i < first; i += 2) atlas.Remove("a" + std::to_string(i));
+    printf("  atlas remove: %zu sprites left, occupancy %.1f%% fragmentation %.2f (%zu free rects)\n", atlas.Count(),
+           atlas.Occupancy() * 100.0f, atlas.Fragmentation(), atlas.Packer().FreeRectCount());
+    t0 = std::chrono::steady_clock::now();
+    const int refill = fill("b");
+    glFinish();
+    printf("  atlas refill: %d sprites in %.3f ms, occupancy %.1f%% fragmentation %.2f | %zu binds -> 1\n", refill, MsSince(t0),
+           atlas.Occupancy() * 100.0f, atlas.Fragmentation(), atlas.Count());
+    atlas.PrintStats(stdout);
+}
+
+template <typename F>
+double TimeLoads(int iterations, F&& load) {
+    double total = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        GLuint tex = load();
+        glFinish();
+        total += MsSince(t0);
+        if (!tex) return -1.0;
+        GetGlState().ForgetTexture(tex);
+        glDeleteTextures(1, &tex);
+    }
+    return total / iterations;
+}
+}
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* win = glfwCreateWindow(64, 64, "TextureBench", nullptr, nullptr);
+    if (!win) { fprintf(stderr, "[TextureBench] no GL context\n"); glfwTerminate(); return 1; }
+    glfwMakeContextCurrent(win);
+    gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+    printf("[TextureBench] %s | %s | glTexStorage2D %s | %d iterations\n", (const char*)glGetString(GL_RENDERER),
+           (const char*)glGetString(GL_VERSION), glTexStorage2D ? "yes" : "no", iterations);
+
+    const char* names[] = { "container", "awesomeface" };
+    const char* exts[] = { ".jpg", ".png" };
+    for (int i = 0; i < 2; ++i) {
+        const std::string src = std::string("assets/") + names[i] + exts[i];
+        const std::string cookedPath = std::string("assets/") + names[i] + ".gtex";
+        // 빌드 단계에서 구워 두지 않았으면 여기서 구움
+        if (!GetVfs().Exists(cookedPath) && !CookTexture(src, cookedPath)) continue;
+
+        const double stbMs = TimeLoads(iterations, [&] { return LoadWithStb(src); });
+        CookedTextureInfo info;
+        const double cookedMs = TimeLoads(iterations, [&] { return LoadCookedTexture(cookedPath, nullptr, &info); });
+        printf("  %-12s %dx%d %d levels | stb+glGenerateMipmap %.3f ms | cooked %.3f ms (x%.2f), %zu bytes\n",
+               names[i], info.width, info.height, info.levels, stbMs, cookedMs, cookedMs > 0 ? stbMs / cookedMs : 0.0, info.bytes);
+        BenchMips(names[i], src, iterations);
+
+        const std::string bcPath = std::string("assets/") + names[i] + ".bc.gtex";
+        CookedTextureInfo bcInfo;
+        if (!ReadCookedTextureInfo(GetVfs().Open(bcPath), &bcInfo) || !IsCompressedFormatSupported(bcInfo.internalFormat)) {
+            printf("  %-12s bc: not available\n", names[i]);
+            continue;
+        }
+        const double bcMs = TimeLoads(iterations, [&] { return LoadCookedTexture(bcPath); });
+        printf("  %-12s bc 0x%X %.3f ms (x%.2f), %zu bytes (%.1f%% of uncompressed)\n", names[i], bcInfo.internalFormat,
+               bcMs, bcMs > 0 ? stbMs / bcMs : 0.0, bcInfo.bytes, 100.0 * bcInfo.bytes / std::max<size_t>(1, info.bytes));
+    }
+
+    BenchAtlas();
+
+    GetVfs().PrintStats(stdout);
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
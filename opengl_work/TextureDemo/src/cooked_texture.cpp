@@ -0,0 +1,314 @@
+#include "cooked_texture.h"
+#include "gl_state.h"
+#include "jpeg_simd.h"
+#include "mip_builder.h"
+#include "pixel_upload_ring.h"
+#include "stb_image.h"
+#include "vfs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+// 업로드 전용 유닛 (TextureLoader와 같은 유닛)
+constexpr int kUploadUnit = GlState::kMaxTextureUnits - 1;
+
+void FormatsFor(int channels, GLenum& internal, GLenum& format) {
+    switch (channels) {
+    case 1:  internal = GL_R8;    format = GL_RED;  break;
+    case 2:  internal = GL_RG8;   format = GL_RG;   break;
+    case 3:  internal = GL_RGB8;  format = GL_RGB;  break;
+    default: internal = GL_RGBA8; format = GL_RGBA; break;
+    }
+}
+
+// 블록 압축 입력은 RGBA8
+std::vector<unsigned char> ToRgba(const std::vector<unsigned char>& src, int w, int h, int c) {
+    if (c == 4) return src;
+    std::vector<unsigned char> dst((size_t)w * h * 4);
+    for (size_t i = 0, n = (size_t)w * h; i < n; ++i) {
+        const unsigned char* s = &src[i * c];
+        unsigned char* d = &dst[i * 4];
+        d[0] = s[0];
+        d[1] = c >= 3 ? s[1] : s[0];
+        d[2] = c >= 3 ? s[2] : s[0];
+        d[3] = c == 2 ? s[1] : 255;
+    }
+    return dst;
+}
+
+bool HasAlpha(const std::vector<unsigned char>& px, int c) {
+    if (c != 2 && c != 4) return false;
+    for (size_t i = c - 1; i < px.size(); i += c)
+        if (px[i] != 255) return true;
+    return false;
+}
+
+const cooked::Level* LevelTable(const FileView& file) {
+    return reinterpret_cast<const cooked::Level*>(file.data() + sizeof(cooked::Header));
+}
+
+// 헤더의 포맷으로 w x h 레벨 하나의 바이트 수 (압축은 4x4 블록 단위). 알 수 없는 조합이면 0
+uint64_t LevelBytes(const cooked::Header& hdr, uint32_t w, uint32_t h) {
+    if (hdr.flags & cooked::kCompressed) {
+        if (hdr.format != 0 || hdr.type != 0) return 0;
+        for (BcFormat f : { BcFormat::BC1, BcFormat::BC3, BcFormat::BC7 })
+            if (BcInternalFormat(f) == hdr.internalFormat) return BcCompressedSize(f, (int)w, (int)h);
+        return 0;
+    }
+    if (hdr.type != GL_UNSIGNED_BYTE) return 0;
+    for (int c = 1; c <= 4; ++c) {
+        GLenum internal, format;
+        FormatsFor(c, internal, format);
+        if (internal == hdr.internalFormat && format == hdr.format) return (uint64_t)w * h * c;
+    }
+    return 0;
+}
+}
+
+bool CookTexture(const std::string& srcPath, const std::string& dstPath, const CookOptions& options,
+                 BcEncodeStats* bcStats, BcFormat* bcFormat, MipStats* mipStats) {
+    FileView file = GetVfs().Open(srcPath);
+    if (!file) return false;
+    InstallDefaultJpegKernels();
+    stbi_set_flip_vertically_on_load_thread(options.flipY);
+    int w = 0, h = 0, c = 0;
+    unsigned char* px = stbi_load_from_memory(file.data(), (int)file.size(), &w, &h, &c, 0);
+    if (!px) {
+        fprintf(stderr, "[CookTexture] decode failed: %s (%s)\n", srcPath.c_str(), stbi_failure_reason());
+        return false;
+    }
+
+    // 레벨 0 + (mipmaps면) 1x1까지
+    std::vector<std::vector<unsigned char>> levels;
+    std::vector<std::pair<int, int>> dims;
+    levels.emplace_back(px, px + (size_t)w * h * c);
+    dims.emplace_back(w, h);
+    stbi_image_free(px);
+    if (options.mipmaps) {
+        MipOptions mip = options.mip;
+        mip.maxLevels = std::min<int>(mip.maxLevels, cooked::kMaxLevels);
+        for (MipLevel& lv : BuildMipChain(levels[0].data(), w, h, c, mip, mipStats)) {
+            dims.emplace_back(lv.width, lv.height);
+            levels.push_back(std::move(lv.pixels));
+        }
+    }
+
+    GLenum internal, format;
+    FormatsFor(c, internal, format);
+    GLenum type = GL_UNSIGNED_BYTE;
+    uint32_t flags = options.flipY ? uint32_t(cooked::kFlippedRows) : 0u;
+    if (options.compression != CookCompression::None) {
+        BcEncodeOptions bc;
+        bc.quality = options.quality;
+        bc.threads = options.threads;
+        switch (options.compression) {
+        case CookCompression::BC1: bc.format = BcFormat::BC1; break;
+        case CookCompression::BC3: bc.format = BcFormat::BC3; break;
+        case CookCompression::BC7: bc.format = BcFormat::BC7; break;
+        default:
+            bc.format = !HasAlpha(levels[0], c) ? BcFormat::BC1
+                      : options.compression == CookCompression::AutoBc7 ? BcFormat::BC7 : BcFormat::BC3;
+            break;
+        }
+        for (size_t i = 0; i < levels.size(); ++i) {
+            auto [lw, lh] = dims[i];
+            const std::vector<unsigned char> rgba = ToRgba(levels[i], lw, lh, c);
+            levels[i].assign(BcCompressedSize(bc.format, lw, lh), 0);
+            // 오차(PSNR)는 원본과 같은 해상도인 레벨 0만, 시간은 모든 레벨
+            BcEncodeStats levelStats;
+            EncodeBc(rgba.data(), lw, lh, bc, levels[i].data(), &levelStats);
+            if (!bcStats) continue;
+            if (i == 0) bcStats->Add(levelStats);
+            else bcStats->ms += levelStats.ms;
+        }
+        internal = BcInternalFormat(bc.format);
+        format = type = 0;
+        flags |= cooked::kCompressed;
+        if (bcFormat) *bcFormat = bc.format;
+    }
+
+    cooked::Header hdr{};
+    hdr.magic = cooked::kMagic;
+    hdr.version = cooked::kVersion;
+    hdr.width = (uint32_t)w;
+    hdr.height = (uint32_t)h;
+    hdr.levels = (uint32_t)levels.size();
+    hdr.internalFormat = internal;
+    hdr.format = format;
+    hdr.type = type;
+    hdr.flags = flags;
+
+    // 목차 크기를 먼저 알고 있으므로 데이터 오프셋을 바로 확정
+    std::vector<cooked::Level> table;
+    uint64_t offset = sizeof(hdr) + sizeof(cooked::Level) * levels.size();
+    for (size_t i = 0; i < levels.size(); ++i) {
+        offset = (offset + 15) & ~uint64_t(15);
+        table.push_back({ offset, levels[i].size(), (uint32_t)dims[i].first, (uint32_t)dims[i].second });
+        offset += levels[i].size();
+    }
+
+    // 같은 출력을 여러 쿠커가 동시에 구워도 서로의 임시 파일을 덮거나 옮기지 않게 이름을 매번 다르게
+    const std::string tmp = dstPath + "." + std::to_string(std::random_device{}() ^
+                                                           (unsigned)std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) { fprintf(stderr, "[CookTexture] cannot write %s\n", tmp.c_str()); return false; }
+        out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        out.write(reinterpret_cast<const char*>(table.data()), sizeof(cooked::Level) * table.size());
+        for (size_t i = 0; i < levels.size(); ++i) {
+            static const char zeros[16] = {};
+            out.write(zeros, table[i].offset - (uint64_t)out.tellp());
+            out.write(reinterpret_cast<const char*>(levels[i].data()), levels[i].size());
+        }
+        if (!out) return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp, dstPath, ec);
+    if (ec) { fs::remove(tmp, ec); return false; }
+    return true;
+}
+
+bool ReadCookedTextureInfo(const FileView& file, CookedTextureInfo* info) {
+    if (!file || file.size() < sizeof(cooked::Header)) return false;
+    const auto* hdr = reinterpret_cast<const cooked::Header*>(file.data());
+    if (hdr->magic != cooked::kMagic || hdr->version != cooked::kVersion ||
+        hdr->levels == 0 || hdr->levels > cooked::kMaxLevels ||
+        sizeof(cooked::Header) + sizeof(cooked::Level) * hdr->levels > file.size())
+        return false;
+    // 크기는 GL 최대 텍스처 크기 언저리까지만, 레벨 수는 1x1까지의 체인을 넘지 않게
+    constexpr uint32_t kMaxSize = 1u << 15;
+    if (hdr->width == 0 || hdr->height == 0 || hdr->width > kMaxSize || hdr->height > kMaxSize ||
+        (hdr->flags & ~uint32_t(cooked::kFlippedRows | cooked::kCompressed)) ||
+        (int)hdr->levels > MipLevelCount((int)hdr->width, (int)hdr->height, cooked::kMaxLevels))
+        return false;
+
+    // GL은 헤더의 크기/포맷으로 읽을 바이트를 정하므로 레벨마다 (밉 체인 크기, 포맷으로 계산한 바이트)가 맞아야 함
+    size_t bytes = 0;
+    const cooked::Level* table = LevelTable(file);
+    for (uint32_t i = 0; i < hdr->levels; ++i) {
+        const cooked::Level& lv = table[i];
+        if (lv.width != std::max(1u, hdr->width >> i) || lv.height != std::max(1u, hdr->height >> i)) return false;
+        const uint64_t expected = LevelBytes(*hdr, lv.width, lv.height);
+        if (expected == 0 || lv.size != expected) return false;
+        if (lv.offset > file.size() || lv.size > file.size() - lv.offset) return false;
+        bytes += (size_t)lv.size;
+    }
+    if (info) {
+        info->width = (int)hdr->width;
+        info->height = (int)hdr->height;
+        info->levels = (int)hdr->levels;
+        info->internalFormat = hdr->internalFormat;
+        info->compressed = (hdr->flags & cooked::kCompressed) != 0;
+        info->bytes = bytes;
+    }
+    return true;
+}
+
+bool IsCompressedFormatSupported(GLenum internalFormat) {
+    static std::unordered_map<GLenum, bool> cache;
+    auto it = cache.find(internalFormat);
+    if (it != cache.end()) return it->second;
+
+    auto hasExtension = [](const char* name) {
+        GLint n = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+        for (GLint i = 0; i < n; ++i)
+            if (!std::strcmp(reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i)), name)) return true;
+        return false;
+    };
+    bool ok = true;
+    switch (internalFormat) {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        ok = hasExtension("GL_EXT_texture_compression_s3tc");
+        break;
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        ok = GLAD_GL_VERSION_4_2 || hasExtension("GL_ARB_texture_compression_bptc");
+        break;
+    }
+    cache.emplace(internalFormat, ok);
+    return ok;
+}
+
+bool UploadCookedTexture(const FileView& file, PixelUploadRing* ring, CookedTextureInfo* info) {
+    CookedTextureInfo ci;
+    if (!ReadCookedTextureInfo(file, &ci)) {
+        fprintf(stderr, "[CookedTexture] invalid container (%zu bytes)\n", file.size());
+        return false;
+    }
+    if (ci.compressed && !IsCompressedFormatSupported(ci.internalFormat)) {
+        fprintf(stderr, "[CookedTexture] compressed format 0x%X not supported\n", ci.internalFormat);
+        return false;
+    }
+    const auto* hdr = reinterpret_cast<const cooked::Header*>(file.data());
+    const cooked::Level* table = LevelTable(file);
+
+    // 레벨 행은 1바이트 단위로 붙어 있음 (RGB 등)
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    // 4.2+: 불변 저장소를 한 번에 잡음. 3.3이면 레벨마다 glTexImage2D + MAX_LEVEL로 완전성 보장
+    const bool storage = glTexStorage2D != nullptr;
+    if (storage) glTexStorage2D(GL_TEXTURE_2D, ci.levels, ci.internalFormat, ci.width, ci.height);
+    for (int i = 0; i < ci.levels; ++i) {
+        const cooked::Level& lv = table[i];
+        const unsigned char* px = file.data() + lv.offset;
+        const GLsizei w = (GLsizei)lv.width, h = (GLsizei)lv.height;
+        if (ci.compressed) {
+            if (storage) glCompressedTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, w, h, ci.internalFormat, (GLsizei)lv.size, px);
+            else glCompressedTexImage2D(GL_TEXTURE_2D, i, ci.internalFormat, w, h, 0, (GLsizei)lv.size, px);
+        } else if (storage) {
+            if (ring) ring->TexSubImage2D(GL_TEXTURE_2D, i, 0, 0, w, h, hdr->format, hdr->type, px, (size_t)lv.size);
+            else glTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, w, h, hdr->format, hdr->type, px);
+        } else {
+            if (ring) ring->TexImage2D(GL_TEXTURE_2D, i, ci.internalFormat, w, h, hdr->format, hdr->type, px, (size_t)lv.size);
+            else glTexImage2D(GL_TEXTURE_2D, i, ci.internalFormat, w, h, 0, hdr->format, hdr->type, px);
+        }
+    }
+    if (!storage) glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, ci.levels - 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (info) *info = ci;
+    return true;
+}
+
+GLuint LoadCookedTexture(const std::string& path, PixelUploadRing* ring, CookedTextureInfo* info) {
+    FileView file = GetVfs().Open(path);
+    if (!file) return 0;
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    GetGlState().BindTexture(kUploadUnit, GL_TEXTURE_2D, tex);
+    if (!UploadCookedTexture(file, ring, info)) {
+        GetGlState().ForgetTexture(tex);
+        glDeleteTextures(1, &tex);
+        return 0;
+    }
+    return tex;
+}
+
+bool IsCookedTexturePath(const std::string& path) {
+    return path.size() > 5 && path.compare(path.size() - 5, 5, ".gtex") == 0;
+}
+
+std::string PreferCookedTexture(const std::string& path) {
+    const size_t dot = path.find_last_of('.');
+    const size_t slash = path.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return path;
+    const std::string base = path.substr(0, dot);
+    const std::string bcPath = base + ".bc.gtex";
+    if (GetVfs().Exists(bcPath)) {
+        CookedTextureInfo info;
+        if (ReadCookedTextureInfo(GetVfs().Open(bcPath), &info) && IsCompressedFormatSupported(info.internalFormat))
+            return bcPath;
+    }
+    std::string cookedPath = base + ".gtex";
+    return GetVfs().Exists(cookedPath) ? cookedPath : path;
+}
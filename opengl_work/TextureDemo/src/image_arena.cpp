@@ -0,0 +1,230 @@
+#include "image_arena.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+// 블록마다 16바이트 헤더 (STBI_REALLOC은 옛 크기를 안 넘겨 줌 + free가 아레나/힙을 구분해야 함)
+struct Header {
+    size_t size;
+    uint32_t tag;
+    uint32_t pad;
+};
+static_assert(sizeof(Header) == 16, "header keeps 16-byte alignment");
+
+constexpr uint32_t kArenaTag = 0x414E5241;   // "ARNA"
+constexpr uint32_t kHeapTag = 0x50414548;    // "HEAP"
+constexpr size_t kMinChunk = 256u << 10;
+
+size_t RoundUp(size_t n) { return (n + 15) & ~size_t(15); }
+
+struct Chunk {
+    unsigned char* base;
+    size_t size;
+};
+
+struct ThreadArena {
+    std::vector<Chunk> chunks;   // 마지막 청크에서 할당
+    size_t used = 0;             // 마지막 청크 사용량
+    size_t usedBefore = 0;       // 앞 청크들에 쓴 바이트 (통계용)
+    size_t want = 0;             // 여러 청크로 자랐을 때 다음 스코프에 잡을 크기
+    size_t peak = 0;             // 이번 스코프의 최대 사용량 (free로 되감기 전 기준)
+    Header* top = nullptr;       // 마지막 청크의 맨 위 블록 (되감기/제자리 realloc)
+    int depth = 0;
+    size_t allocs = 0, heapAllocs = 0;
+
+    ~ThreadArena() { for (const Chunk& c : chunks) std::free(c.base); }
+
+    void NoteUsed() { peak = std::max(peak, usedBefore + used); }
+    size_t Capacity() const {
+        size_t n = 0;
+        for (const Chunk& c : chunks) n += c.size;
+        return n;
+    }
+    void FreeChunks() {
+        for (const Chunk& c : chunks) std::free(c.base);
+        chunks.clear();
+        used = usedBefore = 0;
+        top = nullptr;
+    }
+    bool AddChunk(size_t bytes) {
+        unsigned char* base = (unsigned char*)std::malloc(bytes);
+        ++heapAllocs;
+        if (!base) return false;
+        usedBefore += used;
+        used = 0;
+        top = nullptr;
+        chunks.push_back({ base, bytes });
+        return true;
+    }
+};
+
+thread_local ThreadArena t_arena;
+
+std::atomic<size_t> g_retainLimit{ 64u << 20 };
+std::atomic<size_t> g_scopes{ 0 }, g_allocs{ 0 }, g_heapAllocs{ 0 }, g_unscoped{ 0 }, g_peakBytes{ 0 };
+
+void* HeapAlloc(size_t size) {
+    Header* h = (Header*)std::malloc(sizeof(Header) + size);
+    if (!h) return nullptr;
+    h->size = size;
+    h->tag = kHeapTag;
+    return h + 1;
+}
+
+void* ArenaAlloc(ThreadArena& a, size_t size) {
+    const size_t need = sizeof(Header) + RoundUp(size);
+    if (a.chunks.empty() || a.used + need > a.chunks.back().size) {
+        const size_t last = a.chunks.empty() ? 0 : a.chunks.back().size;
+        // 실패해도 AddChunk가 이미 힙 할당 1회로 셈
+        if (!a.AddChunk(std::max({ need, last * 2, kMinChunk }))) return HeapAlloc(size);
+    }
+    Header* h = (Header*)(a.chunks.back().base + a.used);
+    h->size = size;
+    h->tag = kArenaTag;
+    a.top = h;
+    a.used += need;
+    a.NoteUsed();
+    return h + 1;
+}
+}
+
+ImageArenaScope::ImageArenaScope(size_t expectedBytes) {
+    ThreadArena& a = t_arena;
+    // 처음 잡는 블록도 이 스코프의 힙 할당으로 셈
+    allocs0_ = a.allocs;
+    heap0_ = a.heapAllocs;
+    if (a.depth++ == 0) {
+        // 비어 있는 상태이므로 한 블록으로 다시 잡아도 됨
+        const size_t bytes = RoundUp(std::max(expectedBytes, a.want));
+        a.want = 0;
+        if (bytes && (a.chunks.empty() || a.chunks.back().size < bytes)) {
+            a.FreeChunks();
+            a.AddChunk(std::max(bytes, kMinChunk));
+        }
+    }
+}
+
+ImageArenaScope::~ImageArenaScope() {
+    ThreadArena& a = t_arena;
+    if (--a.depth > 0) return;
+    const size_t bytes = a.peak;
+    a.peak = 0;
+    g_scopes.fetch_add(1, std::memory_order_relaxed);
+    g_allocs.fetch_add(a.allocs, std::memory_order_relaxed);
+    g_heapAllocs.fetch_add(a.heapAllocs, std::memory_order_relaxed);
+    size_t peak = g_peakBytes.load(std::memory_order_relaxed);
+    while (bytes > peak && !g_peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {}
+    a.allocs = a.heapAllocs = 0;
+
+    // 되감기. 여러 청크로 자랐으면 다음 스코프에서 합친 크기 하나로
+    const size_t capacity = a.Capacity();
+    if (a.chunks.size() > 1 || capacity > g_retainLimit.load(std::memory_order_relaxed)) {
+        a.want = capacity <= g_retainLimit.load(std::memory_order_relaxed) ? capacity : 0;
+        a.FreeChunks();
+    }
+    a.used = a.usedBefore = 0;
+    a.top = nullptr;
+}
+
+size_t ImageArenaScope::Allocations() const { return t_arena.allocs - allocs0_; }
+size_t ImageArenaScope::HeapAllocations() const { return t_arena.heapAllocs - heap0_; }
+
+size_t ImageArenaEstimate(const unsigned char* data, size_t size) {
+    int w = 0, h = 0, c = 0;
+    if (!data || !stbi_info_from_memory(data, (int)size, &w, &h, &c)) return 0;
+    // JPEG: 성분 평면 (+ 프로그레시브면 계수), PNG: 모은 IDAT + 풀린 행. 그 밖의 포맷은 임시 출력
+    return (size_t)w * h * c * 2 + size + (64u << 10);
+}
+
+void SetImageArenaRetainLimit(size_t bytes) { g_retainLimit = bytes; }
+
+ImageArenaStats GetImageArenaStats() {
+    ImageArenaStats s;
+    s.scopes = g_scopes.load();
+    s.allocs = g_allocs.load();
+    s.heapAllocs = g_heapAllocs.load();
+    s.unscopedAllocs = g_unscoped.load();
+    s.peakBytes = g_peakBytes.load();
+    return s;
+}
+
+void ResetImageArenaStats() {
+    g_scopes = 0;
+    g_allocs = 0;
+    g_heapAllocs = 0;
+    g_unscoped = 0;
+    g_peakBytes = 0;
+}
+
+void PrintImageArenaStats(FILE* out) {
+    const ImageArenaStats s = GetImageArenaStats();
+    fprintf(out, "[ImageArena] scopes=%zu | stb allocs %zu (%.1f/scope), heap %zu (%.2f/scope), unscoped %zu | peak %zu bytes\n",
+            s.scopes, s.allocs, s.scopes ? (double)s.allocs / s.scopes : 0.0, s.heapAllocs,
+            s.scopes ? (double)s.heapAllocs / s.scopes : 0.0, s.unscopedAllocs, s.peakBytes);
+}
+
+void* ImageArenaMalloc(size_t size) {
+    ThreadArena& a = t_arena;
+    if (a.depth == 0) {
+        g_unscoped.fetch_add(1, std::memory_order_relaxed);
+        return HeapAlloc(size);
+    }
+    ++a.allocs;
+    return ArenaAlloc(a, size);
+}
+
+void* ImageArenaRealloc(void* p, size_t size) {
+    if (!p) return ImageArenaMalloc(size);
+    Header* h = (Header*)p - 1;
+    ThreadArena& a = t_arena;
+    if (h->tag == kHeapTag) {
+        if (a.depth == 0) {
+            g_unscoped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ++a.allocs;
+            ++a.heapAllocs;
+        }
+        Header* q = (Header*)std::realloc(h, sizeof(Header) + size);
+        if (!q) return nullptr;
+        q->size = size;
+        return q + 1;
+    }
+    if (a.depth > 0 && h == a.top) {
+        // 맨 위 블록: 청크에 자리가 있으면 제자리에서 늘림 (zlib 출력, PNG IDAT 모으기)
+        const size_t at = (unsigned char*)h - a.chunks.back().base;
+        const size_t need = sizeof(Header) + RoundUp(size);
+        if (at + need <= a.chunks.back().size) {
+            ++a.allocs;
+            a.used = at + need;
+            a.NoteUsed();
+            h->size = size;
+            return p;
+        }
+    }
+    void* q = ImageArenaMalloc(size);
+    if (!q) return nullptr;
+    std::memcpy(q, p, std::min(h->size, size));
+    ImageArenaFree(p);
+    return q;
+}
+
+void ImageArenaFree(void* p) {
+    if (!p) return;
+    Header* h = (Header*)p - 1;
+    if (h->tag == kHeapTag) {
+        std::free(h);
+        return;
+    }
+    // 아레나 블록: 맨 위면 되감고, 아니면 스코프가 끝날 때 한꺼번에
+    ThreadArena& a = t_arena;
+    if (a.depth > 0 && h == a.top) {
+        a.used = (unsigned char*)h - a.chunks.back().base;
+        a.top = nullptr;
+    }
+}
@@ -0,0 +1,111 @@
+#include "image_decode_pool.h"
+#include "image_arena.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+class DecodePool {
+public:
+    explicit DecodePool(int threads) {
+        for (int i = 1; i < threads; ++i) threads_.emplace_back([this] { WorkerMain(); });
+    }
+    ~DecodePool() {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (std::thread& t : threads_) t.join();
+    }
+
+    // stbi_parallel_for: task(arg, 0..count-1)을 나눠 돌리고 모두 끝나면 반환
+    static void ParallelFor(void* user, int count, void (*task)(void*, int), void* arg) {
+        static_cast<DecodePool*>(user)->Run(count, task, arg);
+    }
+
+private:
+    struct Batch {
+        void (*task)(void*, int);
+        void* arg;
+        int count;
+        std::atomic<int> next{ 0 };
+        std::atomic<int> done{ 0 };
+        int users = 0;   // 이 배치를 잡고 있는 워커 수 (m_ 보호). 0이 될 때까지 호출자가 반환하지 않음
+    };
+
+    void Run(int count, void (*task)(void*, int), void* arg) {
+        Batch b;
+        b.task = task;
+        b.arg = arg;
+        b.count = count;
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            queue_.push_back(&b);
+        }
+        cv_.notify_all();
+        Work(b);
+        std::unique_lock<std::mutex> lock(m_);
+        doneCv_.wait(lock, [&] { return b.done.load() == b.count && b.users == 0; });
+        queue_.erase(std::remove(queue_.begin(), queue_.end(), &b), queue_.end());
+    }
+
+    void Work(Batch& b) {
+        for (int i; (i = b.next.fetch_add(1)) < b.count;) {
+            b.task(b.arg, i);
+            if (b.done.fetch_add(1) + 1 == b.count) {
+                std::lock_guard<std::mutex> lock(m_);
+                doneCv_.notify_all();
+            }
+        }
+    }
+
+    void WorkerMain() {
+        std::unique_lock<std::mutex> lock(m_);
+        for (;;) {
+            cv_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+            if (stop_) return;
+            Batch* b = queue_.front();
+            if (b->next.load() >= b->count) { queue_.pop_front(); continue; }   // 남은 몫 없음 (호출자가 마무리)
+            ++b->users;
+            lock.unlock();
+            {
+                // JPEG 재시작 구간 작업이 이 스레드에서 하는 stb 할당도 아레나로
+                ImageArenaScope arena;
+                Work(*b);
+            }
+            lock.lock();
+            if (--b->users == 0) doneCv_.notify_all();
+        }
+    }
+
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::condition_variable doneCv_;
+    std::deque<Batch*> queue_;
+    std::vector<std::thread> threads_;
+    bool stop_ = false;
+};
+
+std::unique_ptr<DecodePool> g_pool;
+int g_threads = 1;
+}
+
+void SetImageDecodeThreads(int threads) {
+    if (threads <= 0) threads = std::max(1, (int)std::thread::hardware_concurrency());
+    stbi_set_parallel_for(nullptr, nullptr, 1);
+    g_pool.reset();
+    g_threads = threads;
+    if (threads <= 1) return;
+    g_pool = std::make_unique<DecodePool>(threads);
+    stbi_set_parallel_for(&DecodePool::ParallelFor, g_pool.get(), threads);
+}
+
+int ImageDecodeThreads() { return g_threads; }
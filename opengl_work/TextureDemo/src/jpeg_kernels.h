@@ -0,0 +1,48 @@
+#pragma once
+// jpeg_simd 내부용. AVX2/AVX-512 커널은 각자 플래그로 빌드하는 파일에 있고, 빌드하지 않았으면 nullptr
+// 벡터로 못 채우는 끝부분은 아래 스칼라 식으로 처리 (stb의 stbi__YCbCr_to_RGB_row /
+// stbi__resample_row_hv_2와 같은 식이어야 바이트가 맞음). static이라 파일마다 따로 생김
+#include "stb_image.h"
+
+const stbi_jpeg_kernels* Avx2JpegKernels();
+const stbi_jpeg_kernels* Avx512JpegKernels();   // IDCT는 AVX2 것을 씀
+
+namespace jpeg_scalar {
+static inline stbi_uc Clamp(int x) { return (unsigned)x > 255 ? (x < 0 ? 0 : 255) : (stbi_uc)x; }
+
+// 20비트 고정소수 (stbi__float2fixed). g의 cb 항은 SIMD 16비트 곱과 맞추려고 아래 16비트를 버림
+static inline void YCbCrToRgb(stbi_uc* out, const stbi_uc* y, const stbi_uc* pcb, const stbi_uc* pcr, int begin,
+                              int count, int step) {
+    auto fix = [](float x) { return ((int)(x * 4096.0f + 0.5f)) << 8; };
+    for (int i = begin; i < count; ++i) {
+        const int yf = (y[i] << 20) + (1 << 19);
+        const int cr = pcr[i] - 128;
+        const int cb = pcb[i] - 128;
+        const int r = yf + cr * fix(1.40200f);
+        const int g = yf + cr * -fix(0.71414f) + ((cb * -fix(0.34414f)) & 0xffff0000);
+        const int b = yf + cb * fix(1.77200f);
+        out[0] = Clamp(r >> 20);
+        out[1] = Clamp(g >> 20);
+        out[2] = Clamp(b >> 20);
+        out[3] = 255;
+        out += step;
+    }
+}
+
+// hv_2에서 벡터 루프가 처리하지 못한 입력 [i, w). t1 = 3*near[i-1] + far[i-1] (i == 0이면 3*near[0] + far[0])
+static inline stbi_uc* ResampleHv2Tail(stbi_uc* out, const stbi_uc* in_near, const stbi_uc* in_far, int w, int i,
+                                       int t1) {
+    int t0 = t1;
+    t1 = 3 * in_near[i] + in_far[i];
+    if (i == 0) out[0] = (stbi_uc)((t1 + 2) >> 2);
+    else out[i * 2] = (stbi_uc)((3 * t1 + t0 + 8) >> 4);
+    for (++i; i < w; ++i) {
+        t0 = t1;
+        t1 = 3 * in_near[i] + in_far[i];
+        out[i * 2 - 1] = (stbi_uc)((3 * t0 + t1 + 8) >> 4);
+        out[i * 2] = (stbi_uc)((3 * t1 + t0 + 8) >> 4);
+    }
+    out[w * 2 - 1] = (stbi_uc)((t1 + 2) >> 2);
+    return out;
+}
+}
@@ -0,0 +1,87 @@
+#include "jpeg_simd.h"
+#include "cpu_features.h"
+#include "jpeg_kernels.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+
+namespace {
+std::atomic<int> g_active{ -1 };   // 설치된 JpegKernel (-1 = 아직 안 고름 → stb 기본)
+std::once_flag g_defaultOnce;
+
+// Auto → 이 CPU/빌드에서 쓸 수 있는 가장 넓은 커널
+JpegKernel Resolve(JpegKernel kernel) {
+    if (kernel != JpegKernel::Auto) return kernel;
+    if (IsJpegKernelSupported(JpegKernel::Avx512)) return JpegKernel::Avx512;
+    if (IsJpegKernelSupported(JpegKernel::Avx2)) return JpegKernel::Avx2;
+    return IsJpegKernelSupported(JpegKernel::Sse2) ? JpegKernel::Sse2 : JpegKernel::Scalar;
+}
+
+bool HasBuiltinSimd() {
+    stbi_jpeg_kernels scalar, simd;
+    stbi_jpeg_builtin_kernels(&scalar, 0);
+    stbi_jpeg_builtin_kernels(&simd, 1);
+    return simd.idct_block != scalar.idct_block;
+}
+}
+
+bool IsJpegKernelSupported(JpegKernel kernel) {
+    const CpuFeatures& cpu = GetCpuFeatures();
+    switch (kernel) {
+    case JpegKernel::Avx512: return cpu.avx512 && Avx512JpegKernels() != nullptr;
+    case JpegKernel::Avx2: return cpu.avx2 && Avx2JpegKernels() != nullptr;
+    case JpegKernel::Sse2: return HasBuiltinSimd();
+    default: return true;
+    }
+}
+
+bool GetJpegKernels(JpegKernel kernel, stbi_jpeg_kernels* out) {
+    kernel = Resolve(kernel);
+    if (!IsJpegKernelSupported(kernel)) return false;
+    switch (kernel) {
+    case JpegKernel::Avx512: *out = *Avx512JpegKernels(); break;
+    case JpegKernel::Avx2: *out = *Avx2JpegKernels(); break;
+    default: stbi_jpeg_builtin_kernels(out, kernel == JpegKernel::Sse2); break;
+    }
+    // 비워 둔 칸은 stb 기본 (SSE2)
+    stbi_jpeg_kernels builtin;
+    stbi_jpeg_builtin_kernels(&builtin, 1);
+    if (!out->idct_block) out->idct_block = builtin.idct_block;
+    if (!out->YCbCr_to_RGB) out->YCbCr_to_RGB = builtin.YCbCr_to_RGB;
+    if (!out->resample_row_hv_2) out->resample_row_hv_2 = builtin.resample_row_hv_2;
+    return true;
+}
+
+bool SetJpegKernel(JpegKernel kernel) {
+    kernel = Resolve(kernel);
+    stbi_jpeg_kernels k;
+    if (!GetJpegKernels(kernel, &k)) {
+        fprintf(stderr, "[JpegSimd] kernel not supported here: %s\n", JpegKernelName(kernel));
+        return false;
+    }
+    stbi_set_jpeg_kernels(&k);
+    g_active = (int)kernel;
+    return true;
+}
+
+void InstallDefaultJpegKernels() {
+    std::call_once(g_defaultOnce, [] {
+        if (g_active < 0) SetJpegKernel(JpegKernel::Auto);
+    });
+}
+
+const char* JpegKernelName(JpegKernel kernel) {
+    switch (Resolve(kernel)) {
+    case JpegKernel::Avx512: return "avx512";
+    case JpegKernel::Avx2: return "avx2";
+    case JpegKernel::Sse2: return "sse2";
+    default: return "scalar";
+    }
+}
+
+const char* ActiveJpegKernelName() {
+    const int active = g_active;
+    if (active < 0) return HasBuiltinSimd() ? "sse2" : "scalar";
+    return JpegKernelName((JpegKernel)active);
+}
@@ -0,0 +1,230 @@
+// AVX2 JPEG 커널. 이 파일만 -mavx2 (MSVC: /arch:AVX2)로 빌드되므로 GetCpuFeatures().avx2를 확인한 뒤에만 호출할 것
+// 연산 순서와 비트 폭은 stb의 SSE2 커널과 같고 너비만 두 배 → 스칼라 경로와 바이트 단위로 같음
+#include "jpeg_kernels.h"
+
+#if defined(JPEG_HAVE_AVX2)
+#include <immintrin.h>
+
+namespace {
+// ── 8x8 IDCT ──
+// stbi__idct_simd와 같은 계산. 16비트 행 두 개를 열마다 엇갈려 YMM 하나에 넣어
+// 32비트 곱합/덧셈을 열 8개 한 번에 처리 (SSE2는 열 4개씩 두 번)
+
+inline short F2f(float x) { return (short)(int)(x * 4096.0f + 0.5f); }
+
+// madd 상수: 짝수 워드 = x 계수, 홀수 워드 = y 계수
+inline __m256i DctConst(int x, int y) {
+    return _mm256_set1_epi32((int)(((unsigned)(unsigned short)y << 16) | (unsigned short)x));
+}
+
+// [x0 y0 x1 y1 x2 y2 x3 y3 | x4 y4 ... x7 y7]
+inline __m256i Interleave(__m128i x, __m128i y) {
+    return _mm256_set_m128i(_mm_unpackhi_epi16(x, y), _mm_unpacklo_epi16(x, y));
+}
+
+// in << 12 (16 → 32비트)
+inline __m256i Widen(__m128i in) { return _mm256_slli_epi32(_mm256_cvtepi16_epi32(in), 12); }
+
+// (a + bias ± b) >> S → 16비트 두 행
+template <int S>
+inline void Butterfly(__m256i a, __m256i b, __m256i bias, __m128i& out0, __m128i& out1) {
+    const __m256i ab = _mm256_add_epi32(a, bias);
+    const __m256i sum = _mm256_srai_epi32(_mm256_add_epi32(ab, b), S);
+    const __m256i dif = _mm256_srai_epi32(_mm256_sub_epi32(ab, b), S);
+    // 레인별 묶음 [sum 0-3, dif 0-3 | sum 4-7, dif 4-7] → [sum 0-7 | dif 0-7]
+    const __m256i p = _mm256_permute4x64_epi64(_mm256_packs_epi32(sum, dif), 0xD8);
+    out0 = _mm256_castsi256_si128(p);
+    out1 = _mm256_extracti128_si256(p, 1);
+}
+
+template <int S>
+void IdctPass(__m128i r[8], __m256i bias) {
+    const __m256i rot0_0 = DctConst(F2f(0.5411961f), F2f(0.5411961f) + F2f(-1.847759065f));
+    const __m256i rot0_1 = DctConst(F2f(0.5411961f) + F2f(0.765366865f), F2f(0.5411961f));
+    const __m256i rot1_0 = DctConst(F2f(1.175875602f) + F2f(-0.899976223f), F2f(1.175875602f));
+    const __m256i rot1_1 = DctConst(F2f(1.175875602f), F2f(1.175875602f) + F2f(-2.562915447f));
+    const __m256i rot2_0 = DctConst(F2f(-1.961570560f) + F2f(0.298631336f), F2f(-1.961570560f));
+    const __m256i rot2_1 = DctConst(F2f(-1.961570560f), F2f(-1.961570560f) + F2f(3.072711026f));
+    const __m256i rot3_0 = DctConst(F2f(-0.390180644f) + F2f(2.053119869f), F2f(-0.390180644f));
+    const __m256i rot3_1 = DctConst(F2f(-0.390180644f), F2f(-0.390180644f) + F2f(1.501321110f));
+
+    // 짝수 부분
+    const __m256i r26 = Interleave(r[2], r[6]);
+    const __m256i t2e = _mm256_madd_epi16(r26, rot0_0);
+    const __m256i t3e = _mm256_madd_epi16(r26, rot0_1);
+    const __m256i t0e = Widen(_mm_add_epi16(r[0], r[4]));
+    const __m256i t1e = Widen(_mm_sub_epi16(r[0], r[4]));
+    const __m256i x0 = _mm256_add_epi32(t0e, t3e);
+    const __m256i x3 = _mm256_sub_epi32(t0e, t3e);
+    const __m256i x1 = _mm256_add_epi32(t1e, t2e);
+    const __m256i x2 = _mm256_sub_epi32(t1e, t2e);
+
+    // 홀수 부분
+    const __m256i r73 = Interleave(r[7], r[3]);
+    const __m256i r51 = Interleave(r[5], r[1]);
+    const __m256i s = Interleave(_mm_add_epi16(r[1], r[7]), _mm_add_epi16(r[3], r[5]));
+    const __m256i y0o = _mm256_madd_epi16(r73, rot2_0);
+    const __m256i y2o = _mm256_madd_epi16(r73, rot2_1);
+    const __m256i y1o = _mm256_madd_epi16(r51, rot3_0);
+    const __m256i y3o = _mm256_madd_epi16(r51, rot3_1);
+    const __m256i y4o = _mm256_madd_epi16(s, rot1_0);
+    const __m256i y5o = _mm256_madd_epi16(s, rot1_1);
+    const __m256i x4 = _mm256_add_epi32(y0o, y4o);
+    const __m256i x5 = _mm256_add_epi32(y1o, y5o);
+    const __m256i x6 = _mm256_add_epi32(y2o, y5o);
+    const __m256i x7 = _mm256_add_epi32(y3o, y4o);
+
+    Butterfly<S>(x0, x7, bias, r[0], r[7]);
+    Butterfly<S>(x1, x6, bias, r[1], r[6]);
+    Butterfly<S>(x2, x5, bias, r[2], r[5]);
+    Butterfly<S>(x3, x4, bias, r[3], r[4]);
+}
+
+inline void Interleave16(__m128i& a, __m128i& b) {
+    const __m128i t = a;
+    a = _mm_unpacklo_epi16(a, b);
+    b = _mm_unpackhi_epi16(t, b);
+}
+
+inline void Interleave8(__m128i& a, __m128i& b) {
+    const __m128i t = a;
+    a = _mm_unpacklo_epi8(a, b);
+    b = _mm_unpackhi_epi8(t, b);
+}
+
+void IdctAvx2(stbi_uc* out, int out_stride, short data[64]) {
+    __m128i r[8];
+    for (int i = 0; i < 8; ++i) r[i] = _mm_loadu_si128((const __m128i*)(data + i * 8));
+
+    // 열 → 전치 → 행. 반올림 바이어스는 stbi__idct_block과 같음 (행 패스에 +128 레벨 시프트 포함)
+    IdctPass<10>(r, _mm256_set1_epi32(512));
+    Interleave16(r[0], r[4]); Interleave16(r[1], r[5]); Interleave16(r[2], r[6]); Interleave16(r[3], r[7]);
+    Interleave16(r[0], r[2]); Interleave16(r[1], r[3]); Interleave16(r[4], r[6]); Interleave16(r[5], r[7]);
+    Interleave16(r[0], r[1]); Interleave16(r[2], r[3]); Interleave16(r[4], r[5]); Interleave16(r[6], r[7]);
+    IdctPass<17>(r, _mm256_set1_epi32(65536 + (128 << 17)));
+
+    // 8비트로 묶어 다시 전치
+    __m128i p0 = _mm_packus_epi16(r[0], r[1]);
+    __m128i p1 = _mm_packus_epi16(r[2], r[3]);
+    __m128i p2 = _mm_packus_epi16(r[4], r[5]);
+    __m128i p3 = _mm_packus_epi16(r[6], r[7]);
+    Interleave8(p0, p2); Interleave8(p1, p3);
+    Interleave8(p0, p1); Interleave8(p2, p3);
+    Interleave8(p0, p2); Interleave8(p1, p3);
+
+    const __m128i rows[4] = { p0, p2, p1, p3 };
+    for (int i = 0; i < 4; ++i) {
+        _mm_storel_epi64((__m128i*)out, rows[i]); out += out_stride;
+        _mm_storel_epi64((__m128i*)out, _mm_shuffle_epi32(rows[i], 0x4e)); out += out_stride;
+    }
+}
+
+// ── 4:2:0 크로마 업샘플 (2x2) ──
+// stbi__resample_row_hv_2_simd와 같은 식. 입력 16픽셀 → 출력 32바이트
+stbi_uc* ResampleHv2Avx2(stbi_uc* out, stbi_uc* in_near, stbi_uc* in_far, int w, int hs) {
+    (void)hs;
+    if (w == 1) {
+        out[0] = out[1] = (stbi_uc)((3 * in_near[0] + in_far[0] + 2) >> 2);
+        return out;
+    }
+    int i = 0;
+    int t1 = 3 * in_near[0] + in_far[0];
+    const __m256i bias = _mm256_set1_epi16(8);
+    // 마지막 입력 픽셀은 경계 처리가 달라서 벡터 루프에 넣지 않음
+    for (; i < ((w - 1) & ~15); i += 16) {
+        const __m256i farw = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(in_far + i)));
+        const __m256i nearw = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(in_near + i)));
+        // 3*near + far = 4*near + (far - near)
+        const __m256i curr = _mm256_add_epi16(_mm256_slli_epi16(nearw, 2), _mm256_sub_epi16(farw, nearw));
+
+        // 한 픽셀씩 밀고 빈 자리에 이전 블록 끝 / 다음 블록 첫 픽셀
+        __m256i prev = _mm256_alignr_epi8(curr, _mm256_permute2x128_si256(curr, curr, 0x08), 14);
+        __m256i next = _mm256_alignr_epi8(_mm256_permute2x128_si256(curr, curr, 0x81), curr, 2);
+        prev = _mm256_insert_epi16(prev, (short)t1, 0);
+        next = _mm256_insert_epi16(next, (short)(3 * in_near[i + 16] + in_far[i + 16]), 15);
+
+        // 짝수 = 3*cur + prev, 홀수 = 3*cur + next (4배 스케일, +8 반올림)
+        const __m256i curb = _mm256_add_epi16(_mm256_slli_epi16(curr, 2), bias);
+        const __m256i even = _mm256_add_epi16(_mm256_sub_epi16(prev, curr), curb);
+        const __m256i odd = _mm256_add_epi16(_mm256_sub_epi16(next, curr), curb);
+
+        // 레인 안에서 짝/홀을 엇갈리면 출력 순서 그대로
+        const __m256i de0 = _mm256_srli_epi16(_mm256_unpacklo_epi16(even, odd), 4);
+        const __m256i de1 = _mm256_srli_epi16(_mm256_unpackhi_epi16(even, odd), 4);
+        _mm256_storeu_si256((__m256i*)(out + i * 2), _mm256_packus_epi16(de0, de1));
+
+        t1 = 3 * in_near[i + 15] + in_far[i + 15];
+    }
+    return jpeg_scalar::ResampleHv2Tail(out, in_near, in_far, w, i, t1);
+}
+
+// ── YCbCr → RGB(A) ──
+// stbi__YCbCr_to_RGB_simd와 같은 16비트 고정소수 계산. 16픽셀씩, step 3도 벡터로 처리
+void YCbCrToRgbAvx2(stbi_uc* out, const stbi_uc* y, const stbi_uc* pcb, const stbi_uc* pcr, int count, int step) {
+    int i = 0;
+    if (step == 3 || step == 4) {
+        const __m128i signflip = _mm_set1_epi8(-0x80);
+        const __m256i cr_const0 = _mm256_set1_epi16((short)(1.40200f * 4096.0f + 0.5f));
+        const __m256i cr_const1 = _mm256_set1_epi16(-(short)(0.71414f * 4096.0f + 0.5f));
+        const __m256i cb_const0 = _mm256_set1_epi16(-(short)(0.34414f * 4096.0f + 0.5f));
+        const __m256i cb_const1 = _mm256_set1_epi16((short)(1.77200f * 4096.0f + 0.5f));
+        const __m256i y_bias = _mm256_set1_epi16(128);
+        const __m256i xw = _mm256_set1_epi16(255);
+        // RGBX 4픽셀(16바이트) → RGB 12바이트 (레인마다)
+        const __m256i pack3 = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                               0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        const __m256i gather3 = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+        // step 3은 블록마다 32바이트를 써서 다음 픽셀 8바이트까지 덮으므로 뒤에 3픽셀이 남아 있어야 함
+        const int tail = step == 3 ? 3 : 0;
+
+        for (; i + 16 + tail <= count; i += 16) {
+            // (y << 8) | 128, (cr - 128) << 8, (cb - 128) << 8
+            const __m256i yw = _mm256_or_si256(
+                _mm256_slli_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(y + i))), 8), y_bias);
+            const __m256i crw = _mm256_slli_epi16(
+                _mm256_cvtepu8_epi16(_mm_xor_si128(_mm_loadu_si128((const __m128i*)(pcr + i)), signflip)), 8);
+            const __m256i cbw = _mm256_slli_epi16(
+                _mm256_cvtepu8_epi16(_mm_xor_si128(_mm_loadu_si128((const __m128i*)(pcb + i)), signflip)), 8);
+
+            const __m256i yws = _mm256_srli_epi16(yw, 4);
+            const __m256i cr0 = _mm256_mulhi_epi16(cr_const0, crw);
+            const __m256i cb0 = _mm256_mulhi_epi16(cb_const0, cbw);
+            const __m256i cb1 = _mm256_mulhi_epi16(cbw, cb_const1);
+            const __m256i cr1 = _mm256_mulhi_epi16(crw, cr_const1);
+            const __m256i rw = _mm256_srai_epi16(_mm256_add_epi16(cr0, yws), 4);
+            const __m256i bw = _mm256_srai_epi16(_mm256_add_epi16(yws, cb1), 4);
+            const __m256i gw = _mm256_srai_epi16(_mm256_add_epi16(_mm256_add_epi16(cb0, yws), cr1), 4);
+
+            // 레인 k: 픽셀 8k..8k+7 → o0 = 8k..8k+3, o1 = 8k+4..8k+7 (RGBX)
+            const __m256i brb = _mm256_packus_epi16(rw, bw);
+            const __m256i gxb = _mm256_packus_epi16(gw, xw);
+            const __m256i t0 = _mm256_unpacklo_epi8(brb, gxb);
+            const __m256i t1 = _mm256_unpackhi_epi8(brb, gxb);
+            const __m256i o0 = _mm256_unpacklo_epi16(t0, t1);
+            const __m256i o1 = _mm256_unpackhi_epi16(t0, t1);
+            const __m256i lo = _mm256_permute2x128_si256(o0, o1, 0x20);   // 픽셀 0-7
+            const __m256i hi = _mm256_permute2x128_si256(o0, o1, 0x31);   // 픽셀 8-15
+
+            if (step == 4) {
+                _mm256_storeu_si256((__m256i*)out, lo);
+                _mm256_storeu_si256((__m256i*)(out + 32), hi);
+                out += 64;
+            } else {
+                const __m256i l3 = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(lo, pack3), gather3);
+                const __m256i h3 = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(hi, pack3), gather3);
+                _mm256_storeu_si256((__m256i*)out, l3);
+                _mm256_storeu_si256((__m256i*)(out + 24), h3);
+                out += 48;
+            }
+        }
+    }
+    jpeg_scalar::YCbCrToRgb(out, y, pcb, pcr, i, count, step);
+}
+
+const stbi_jpeg_kernels kAvx2 = { IdctAvx2, YCbCrToRgbAvx2, ResampleHv2Avx2 };
+}
+
+const stbi_jpeg_kernels* Avx2JpegKernels() { return &kAvx2; }
+#else
+const stbi_jpeg_kernels* Avx2JpegKernels() { return nullptr; }
+#endif
@@ -0,0 +1,119 @@
+// AVX-512 (F + BW) JPEG 커널. 이 파일만 -mavx512f -mavx512bw (MSVC: /arch:AVX512)로 빌드되므로
+// GetCpuFeatures().avx512를 확인한 뒤에만 호출할 것
+// 업샘플/색 변환만 32픽셀 폭으로 넓힘. IDCT는 블록 하나가 YMM 폭이라 AVX2 것을 그대로 씀
+#include "jpeg_kernels.h"
+
+#if defined(JPEG_HAVE_AVX512)
+#include <immintrin.h>
+
+namespace {
+// stbi__resample_row_hv_2_simd와 같은 식. 입력 32픽셀 → 출력 64바이트
+stbi_uc* ResampleHv2Avx512(stbi_uc* out, stbi_uc* in_near, stbi_uc* in_far, int w, int hs) {
+    (void)hs;
+    if (w == 1) {
+        out[0] = out[1] = (stbi_uc)((3 * in_near[0] + in_far[0] + 2) >> 2);
+        return out;
+    }
+    int i = 0;
+    int t1 = 3 * in_near[0] + in_far[0];
+    const __m512i bias = _mm512_set1_epi16(8);
+    // 워드 하나씩 밀기: prev[k] = curr[k-1], next[k] = curr[k+1] (빈 자리는 아래에서 채움)
+    const __m512i prevIdx = _mm512_set_epi16(30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15,
+                                             14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 0);
+    const __m512i nextIdx = _mm512_set_epi16(31, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                                             16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    for (; i < ((w - 1) & ~31); i += 32) {
+        const __m512i farw = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(in_far + i)));
+        const __m512i nearw = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(in_near + i)));
+        const __m512i curr = _mm512_add_epi16(_mm512_slli_epi16(nearw, 2), _mm512_sub_epi16(farw, nearw));
+
+        const __m512i prev = _mm512_mask_set1_epi16(_mm512_permutexvar_epi16(prevIdx, curr), 1u, (short)t1);
+        const __m512i next = _mm512_mask_set1_epi16(_mm512_permutexvar_epi16(nextIdx, curr), 1u << 31,
+                                                    (short)(3 * in_near[i + 32] + in_far[i + 32]));
+
+        const __m512i curb = _mm512_add_epi16(_mm512_slli_epi16(curr, 2), bias);
+        const __m512i even = _mm512_add_epi16(_mm512_sub_epi16(prev, curr), curb);
+        const __m512i odd = _mm512_add_epi16(_mm512_sub_epi16(next, curr), curb);
+
+        const __m512i de0 = _mm512_srli_epi16(_mm512_unpacklo_epi16(even, odd), 4);
+        const __m512i de1 = _mm512_srli_epi16(_mm512_unpackhi_epi16(even, odd), 4);
+        _mm512_storeu_si512((void*)(out + i * 2), _mm512_packus_epi16(de0, de1));
+
+        t1 = 3 * in_near[i + 31] + in_far[i + 31];
+    }
+    return jpeg_scalar::ResampleHv2Tail(out, in_near, in_far, w, i, t1);
+}
+
+// stbi__YCbCr_to_RGB_simd와 같은 16비트 고정소수 계산. 32픽셀씩, step 3은 마스크 저장
+void YCbCrToRgbAvx512(stbi_uc* out, const stbi_uc* y, const stbi_uc* pcb, const stbi_uc* pcr, int count, int step) {
+    int i = 0;
+    if (step == 3 || step == 4) {
+        const __m256i signflip = _mm256_set1_epi8(-0x80);
+        const __m512i cr_const0 = _mm512_set1_epi16((short)(1.40200f * 4096.0f + 0.5f));
+        const __m512i cr_const1 = _mm512_set1_epi16(-(short)(0.71414f * 4096.0f + 0.5f));
+        const __m512i cb_const0 = _mm512_set1_epi16(-(short)(0.34414f * 4096.0f + 0.5f));
+        const __m512i cb_const1 = _mm512_set1_epi16((short)(1.77200f * 4096.0f + 0.5f));
+        const __m512i y_bias = _mm512_set1_epi16(128);
+        const __m512i xw = _mm512_set1_epi16(255);
+        // o0/o1의 레인 k = 픽셀 8k..8k+3 / 8k+4..8k+7 → 순서대로 16픽셀씩
+        const __m512i order0 = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+        const __m512i order1 = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+        // RGBX → RGB: 16바이트마다 12바이트로 모은 뒤 dword 단위로 붙임 (48바이트 = 16픽셀)
+        // 레인마다 바이트 0,1,2,4,5,6,8,9,10,12,13,14 + 0xFF(0으로 채움). GCC 12는 _mm512_broadcast_i32x4 /
+        // _mm512_permutexvar_epi32 안의 _mm512_undefined_epi32()에 -Wmaybe-uninitialized를 내므로
+        // 상수는 set4로, 치환은 전체 마스크 maskz로 (같은 vpermd)
+        const __m512i pack3 = _mm512_set4_epi32(-1, 0x0E0D0C0A, 0x09080605, 0x04020100);
+        const __m512i gather3 = _mm512_setr_epi32(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 15, 15, 15, 15);
+        const __mmask64 rgb48 = 0x0000FFFFFFFFFFFFull;
+
+        for (; i + 32 <= count; i += 32) {
+            const __m512i yw = _mm512_or_si512(
+                _mm512_slli_epi16(_mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(y + i))), 8), y_bias);
+            const __m512i crw = _mm512_slli_epi16(
+                _mm512_cvtepu8_epi16(_mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(pcr + i)), signflip)), 8);
+            const __m512i cbw = _mm512_slli_epi16(
+                _mm512_cvtepu8_epi16(_mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(pcb + i)), signflip)), 8);
+
+            const __m512i yws = _mm512_srli_epi16(yw, 4);
+            const __m512i cr0 = _mm512_mulhi_epi16(cr_const0, crw);
+            const __m512i cb0 = _mm512_mulhi_epi16(cb_const0, cbw);
+            const __m512i cb1 = _mm512_mulhi_epi16(cbw, cb_const1);
+            const __m512i cr1 = _mm512_mulhi_epi16(crw, cr_const1);
+            const __m512i rw = _mm512_srai_epi16(_mm512_add_epi16(cr0, yws), 4);
+            const __m512i bw = _mm512_srai_epi16(_mm512_add_epi16(yws, cb1), 4);
+            const __m512i gw = _mm512_srai_epi16(_mm512_add_epi16(_mm512_add_epi16(cb0, yws), cr1), 4);
+
+            const __m512i brb = _mm512_packus_epi16(rw, bw);
+            const __m512i gxb = _mm512_packus_epi16(gw, xw);
+            const __m512i t0 = _mm512_unpacklo_epi8(brb, gxb);
+            const __m512i t1 = _mm512_unpackhi_epi8(brb, gxb);
+            const __m512i o0 = _mm512_unpacklo_epi16(t0, t1);
+            const __m512i o1 = _mm512_unpackhi_epi16(t0, t1);
+            const __m512i lo = _mm512_permutex2var_epi64(o0, order0, o1);   // 픽셀 0-15
+            const __m512i hi = _mm512_permutex2var_epi64(o0, order1, o1);   // 픽셀 16-31
+
+            if (step == 4) {
+                _mm512_storeu_si512((void*)out, lo);
+                _mm512_storeu_si512((void*)(out + 64), hi);
+                out += 128;
+            } else {
+                _mm512_mask_storeu_epi8(out, rgb48, _mm512_maskz_permutexvar_epi32(0xFFFF, gather3, _mm512_shuffle_epi8(lo, pack3)));
+                _mm512_mask_storeu_epi8(out + 48, rgb48, _mm512_maskz_permutexvar_epi32(0xFFFF, gather3, _mm512_shuffle_epi8(hi, pack3)));
+                out += 96;
+            }
+        }
+    }
+    jpeg_scalar::YCbCrToRgb(out, y, pcb, pcr, i, count, step);
+}
+}
+
+const stbi_jpeg_kernels* Avx512JpegKernels() {
+    // IDCT는 AVX2 (AVX-512가 되면 AVX2도 됨). AVX2 파일을 빌드하지 않았으면 stb 기본값
+    static const stbi_jpeg_kernels kernels = {
+        Avx2JpegKernels() ? Avx2JpegKernels()->idct_block : nullptr, YCbCrToRgbAvx512, ResampleHv2Avx512
+    };
+    return &kernels;
+}
+#else
+const stbi_jpeg_kernels* Avx512JpegKernels() { return nullptr; }
+#endif
@@ -2,10 +2,25 @@
 #include <GLFW/glfw3.h>
 
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <string>
+#include <vector>
 #include "stb_image.h" // 구현은 src/stb_image_impl.cpp
+#include "shader_util.h"
+#include "embedded_shaders.h"
+#include "program_cache.h"
+#include "shader_async.h"
+#include "shader_hot_reload.h"
+#include "shader_variants.h"
+#include "uniform_table.h"
+#include "vfs.h"
+#include "gl_state.h"
+#include "sampler_cache.h"
+#include "texture_loader.h"
+#include "image_arena.h"
+#include "texture_registry.h"
+#include "texture_array_pool.h"
+#include "pixel_upload_ring.h"
+#include "cooked_texture.h"
 
 // 창 크기 상수
 const unsigned int SCR_WIDTH = 800;
@@ -15,31 +30,29 @@ static float g_mix = 0.2f;
 static GLint  g_wrapModes[3] = { GL_REPEAT,GL_MIRRORED_REPEAT,GL_CLAMP_TO_EDGE };
 static int    g_wrapIdx = 0;
 static bool   g_linearFilter = true;
+static bool   g_arrayMode = false;
+static float  g_anisotropy = 1.0f;
 static GLuint tex0 = 0, tex1 = 0;
 
-static void applyTexParams(GLuint tex) {
-    glBindTexture(GL_TEXTURE_2D, tex);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, g_wrapModes[g_wrapIdx]);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, g_wrapModes[g_wrapIdx]);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, g_linearFilter ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, g_linearFilter ? GL_LINEAR : GL_NEAREST);
+// 필터/wrap은 텍스처가 아니라 유닛(0: tex0, 1: tex1, 2: 배열)에 묶인 샘플러로 바꿈
+// → 텍스처 수와 상관없이 glBindSampler 3번 (같은 설정의 샘플러는 캐시에서 재사용)
+static void bindSamplers() {
+    const SamplerDesc desc = MakeSamplerDesc(g_wrapModes[g_wrapIdx],
+                                             g_linearFilter ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST,
+                                             g_linearFilter ? GL_LINEAR : GL_NEAREST, g_anisotropy);
+    for (int unit = 0; unit < 3; ++unit) GetSamplerCache().Bind(unit, desc);
 }
-static GLuint makeTexture2D(const char* path) {
-    int w, h, nc; stbi_set_flip_vertically_on_load(true);
-    unsigned char* data = stbi_load(path, &w, &h, &nc, 0);
-    if (!data) { std::cerr << "Load fail: " << path << "\n"; return 0; }
-    GLuint t; glGenTextures(1, &t); glBindTexture(GL_TEXTURE_2D, t);
-    applyTexParams(t);
-    GLenum fmt = (nc == 4) ? GL_RGBA : GL_RGB;
-    glTexImage2D(GL_TEXTURE_2D, 0, fmt, w, h, 0, fmt, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    stbi_image_free(data);
-    return t;
+static TextureDesc currentTexDesc() {
+    TextureDesc d;
+    d.wrap = g_wrapModes[g_wrapIdx];
+    d.minFilter = g_linearFilter ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
+    d.magFilter = g_linearFilter ? GL_LINEAR : GL_NEAREST;
+    return d;
 }
 
 // 프레임버퍼 크기 변경 콜백: 창이 리사이즈될 때 실제 렌더링 영역(뷰포트)도 맞춰줌
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    GetGlState().Viewport(0, 0, width, height);
 }
 
 // 입력 처리 헬퍼: ESC를 누르면 창 닫기 플래그 세팅함
@@ -48,97 +61,12 @@ void processInput(GLFWwindow* window) {
         glfwSetWindowShouldClose(window, true);
 }
 
-static void CheckShaderCompile(GLuint shader, const char* name)
-{
-    GLint success = 0;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        GLint len = 0; glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &len);
-        std::string log(len, '\0');
-        glGetShaderInfoLog(shader, len, &len, log.data());
-        fprintf(stderr, "[Shader Compile Error] %s\n%s\n", name, log.c_str());
-    }
-}
-
-static void CheckProgramLink(GLuint prog)
-{
-    GLint success = 0; glGetProgramiv(prog, GL_LINK_STATUS, &success);
-    if (!success) {
-        GLint len = 0; glGetProgramiv(prog, GL_INFO_LOG_LENGTH, &len);
-        std::string log(len, '\0');
-        glGetProgramInfoLog(prog, len, &len, log.data());
-        fprintf(stderr, "[Program Link Error]\n%s\n", log.c_str());
-    }
-}
-
-GLuint CreateShaderProgram(const char* vs, const char* fs)
-{
-    GLuint v = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(v, 1, &vs, nullptr);
-    glCompileShader(v);
-    CheckShaderCompile(v, "Vertex");
-
-    GLuint f = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(f, 1, &fs, nullptr);
-    glCompileShader(f);
-    CheckShaderCompile(f, "Fragment");
-
-    GLuint p = glCreateProgram();
-    glAttachShader(p, v);
-    glAttachShader(p, f);
-    glLinkProgram(p);
-    CheckProgramLink(p);
-
-    glDeleteShader(v);
-    glDeleteShader(f);
-    return p;
-}
-
-
-static std::string ReadFile(const char* path) {
-    std::ifstream f(path, std::ios::binary);
-    if (!f) {
-        fprintf(stderr, "Failed to open %s", path);
-        return {};
-    }
-    std::ostringstream ss; ss << f.rdbuf();
-    return ss.str();
-}
-
-static GLuint CreateShaderProgramFromFiles(const char* vsPath, const char* fsPath) {
-    std::string vsCode = ReadFile(vsPath);
-    std::string fsCode = ReadFile(fsPath);
-    if (vsCode.empty() || fsCode.empty()) {
-        fprintf(stderr, "Shader source empty: %s or %s", vsPath, fsPath);
-        return 0;
-    }
-    const char* vsSrc = vsCode.c_str();
-    const char* fsSrc = fsCode.c_str();
-
-    GLuint v = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(v, 1, &vsSrc, nullptr);
-    glCompileShader(v); CheckShaderCompile(v, "Vertex");
-
-    GLuint f = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(f, 1, &fsSrc, nullptr);
-    glCompileShader(f); CheckShaderCompile(f, "Fragment");
-
-    GLuint p = glCreateProgram();
-    glAttachShader(p, v);
-    glAttachShader(p, f);
-    glLinkProgram(p); CheckProgramLink(p);
-
-    glDeleteShader(v); glDeleteShader(f);
-    return p;
-}
-
-
 int main() {
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    GLFWwindow* win = glfwCreateWindow(800, 600, "Two Textures (Z:Filter, X:Wrap, Up/Down:Mix)", nullptr, nullptr);
+    GLFWwindow* win = glfwCreateWindow(800, 600, "Two Textures (Z:Filter, X:Wrap, F:Aniso, Up/Down:Mix, A:Array)", nullptr, nullptr);
     glfwMakeContextCurrent(win);
     gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
     glfwSetFramebufferSizeCallback(win, framebuffer_size_callback);
@@ -163,21 +91,113 @@ int main() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float))); glEnableVertexAttribArray(1);
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float))); glEnableVertexAttribArray(2);
 
-    tex0 = makeTexture2D("assets/container.jpg");
-    tex1 = makeTexture2D("assets/awesomeface.png");
-
-    GLuint prog = CreateShaderProgramFromFiles("shaders/tex_mix.vert", "shaders/tex_mix.frag");
-    glUseProgram(prog);
-    glUniform1i(glGetUniformLocation(prog, "uTex0"), 0);
-    glUniform1i(glGetUniformLocation(prog, "uTex1"), 1);
+    // 셰이더를 먼저 제출해 두고 텍스처 로딩과 겹쳐서 컴파일 (상태 확인은 첫 바인드 때)
+    ShaderCompiler compiler;
+    compiler.Init(win);
+    ShaderVariants texShaders("shaders/textured.vert", "shaders/textured.frag",
+                              { "TEX_MIX", "VERTEX_COLOR", "WRAP_EMULATION", "UV_TILING", "TEX_ARRAY" });
+    const uint32_t mixMask = texShaders.Mask({ "TEX_MIX", "UV_TILING" });
+    const uint32_t arrayMask = texShaders.Mask({ "TEX_ARRAY" });
+    texShaders.Precompile({ mixMask, arrayMask }, &compiler); // 핫 셋: 시작 시 비동기로 제출
+
+    // assets.pak (빌드 후 AssetPack이 assets/를 묶어 둠)이 있으면 assets/ 폴더 대신 사용
+    if (GetVfs().Exists("assets.pak")) GetVfs().MountArchive("assets/", "assets.pak");
+    // 디코드는 워커에서, 업로드는 루프의 loader.Update()가 (그 전까지는 회색 플레이스홀더)
+    // 업로드는 PBO 링을 거쳐 드라이버가 복사를 기다리지 않게 함 (링 크기 >= 프레임 업로드 예산)
+    PixelUploadRing uploadRing;
+    uploadRing.Init(16u << 20);
+    TextureLoader loader;
+    loader.Init(0, 8u << 20);
+    loader.SetUploadRing(&uploadRing);
+    // 큰 이미지는 64행 밴드씩 올라와 디코드가 끝나기 전에 위쪽부터 보임
+    loader.SetStreaming(true, 64);
+    // 같은 이미지는 경로가 달라도 한 번만 올리고, 핸들이 모두 사라지면 삭제
+    TextureRegistry textures(loader);
+    // 빌드 때 구워 둔 .gtex가 있으면 디코드/밉 생성 없이 바로 올라감
+    TextureHandle texHandle0 = textures.Acquire(PreferCookedTexture("assets/container.jpg"), currentTexDesc());
+    TextureHandle texHandle1 = textures.Acquire(PreferCookedTexture("assets/awesomeface.png"), currentTexDesc());
+    tex0 = texHandle0.Id();
+    tex1 = texHandle1.Id();
+
+    // 배열 모드(A): 같은 크기 이미지를 TEXTURE_2D_ARRAY 레이어로 모아 4x4 쿼드를 배열마다 그리기 한 번으로
+    // 512x512 RGB/RGBA/체커가 모두 RGBA8 버킷 하나에 들어가므로 바인드 1번 + 드로우 1번
+    TextureArrayPool materials;
+    materials.Init({}, &uploadRing);
+    std::vector<ArrayLayer> layers = { materials.AddFile("assets/container.jpg"), materials.AddFile("assets/awesomeface.png") };
+    {
+        const unsigned char colors[4][3] = { { 230, 80, 70 }, { 80, 200, 90 }, { 70, 120, 230 }, { 230, 200, 60 } };
+        std::vector<unsigned char> px(512 * 512 * 4);
+        for (int m = 0; m < 4; ++m) {
+            for (int y = 0; y < 512; ++y)
+                for (int x = 0; x < 512; ++x) {
+                    unsigned char* p = &px[((size_t)y * 512 + x) * 4];
+                    const bool on = ((x / 64) + (y / 64)) & 1;
+                    for (int k = 0; k < 3; ++k) p[k] = on ? colors[m][k] : 40;
+                    p[3] = 255;
+                }
+            layers.push_back(materials.Add("checker" + std::to_string(m), px.data(), 512, 512, 4));
+        }
+    }
+    // 인스턴스 (오프셋 xy, 크기, 레이어)를 배열별로 모아 연속 구간으로
+    struct ArrayDraw { int array; GLsizei first, count; };
+    std::vector<float> instances;
+    std::vector<ArrayDraw> arrayDraws;
+    for (size_t a = 0; a < materials.Arrays().size(); ++a) {
+        ArrayDraw draw{ (int)a, (GLsizei)(instances.size() / 4), 0 };
+        for (int i = 0; i < 16; ++i) {
+            const ArrayLayer& ref = layers[i % layers.size()];
+            if (ref.array != (int)a) continue;
+            instances.insert(instances.end(), { -0.75f + 0.5f * (i % 4), 0.75f - 0.5f * (i / 4), 0.45f, (float)ref.layer });
+            ++draw.count;
+        }
+        if (draw.count) arrayDraws.push_back(draw);
+    }
+    GLuint instVbo;
+    glGenBuffers(1, &instVbo); glBindBuffer(GL_ARRAY_BUFFER, instVbo);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(float), instances.data(), GL_STATIC_DRAW);
+    glBindVertexArray(vao);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0); glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+
+    GLuint prog = texShaders.Get(mixMask);
+    GetProgramCache().PrintStats(stdout); // 두 번째 실행부터 hits가 올라가야 정상
+    PrintEmbeddedShaderStats(stdout);     // hits가 0이면 디스크에서 읽은 것
+    compiler.PrintStats(stdout);
+    // uniform 위치는 링크 후 한 번만 조회 (루프에서는 해시 키 + 값 캐시)
+    GlState& gl = GetGlState();
+    UniformTable uniforms(prog);
+    gl.UseProgram(prog);
+    uniforms.Set("uTex0"_u, 0);
+    uniforms.Set("uTex1"_u, 1);
+    GLuint arrayProg = texShaders.Get(arrayMask);
+    UniformTable arrayUniforms(arrayProg);
+    gl.UseProgram(arrayProg);
+    arrayUniforms.Set("uTexArray"_u, 2);
+    bindSamplers();
+
+    // 셰이더 핫 리로드: 빌드 폴더 복사본이 아니라 원본 shaders/ 를 감시
+    ShaderHotReloader reloader(compiler);
+    const std::string shaderDir = SHADER_SOURCE_DIR;
+    int progSlot = reloader.Register(shaderDir + "/textured.vert", shaderDir + "/textured.frag", prog,
+                                     texShaders.Defines(mixMask));
+    reloader.SetReloadCallback([&](int, GLuint p) {
+        texShaders.Replace(mixMask, p);
+        uniforms.Reflect(p);
+        gl.UseProgram(p);
+        uniforms.Set("uTex0"_u, 0);
+        uniforms.Set("uTex1"_u, 1);
+    });
+    reloader.Watch(shaderDir);
 
     // glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // 필요 시
 
     double last = glfwGetTime();
-    bool zPrev = false, xPrev = false;
+    bool zPrev = false, xPrev = false, fPrev = false, aPrev = false;
 
     while (!glfwWindowShouldClose(win)) {
         double now = glfwGetTime(); float dt = float(now - last); last = now;
+        reloader.Update(); prog = reloader.Program(progSlot);
+        loader.Update();
         if (glfwGetKey(win, GLFW_KEY_ESCAPE) == GLFW_PRESS) glfwSetWindowShouldClose(win, true);
         if (glfwGetKey(win, GLFW_KEY_UP) == GLFW_PRESS)   g_mix = std::min(1.0f, g_mix + 0.7f * dt);
         if (glfwGetKey(win, GLFW_KEY_DOWN) == GLFW_PRESS) g_mix = std::max(0.0f, g_mix - 0.7f * dt);
@@ -185,27 +205,69 @@ int main() {
         bool zNow = (glfwGetKey(win, GLFW_KEY_Z) == GLFW_PRESS);
         bool xNow = (glfwGetKey(win, GLFW_KEY_X) == GLFW_PRESS);
         if (zNow && !zPrev) {
-            g_linearFilter = !g_linearFilter; applyTexParams(tex0); applyTexParams(tex1);
+            g_linearFilter = !g_linearFilter; bindSamplers();
             std::cout << "Filter: " << (g_linearFilter ? "LINEAR" : "NEAREST") << "\n";
         }
         if (xNow && !xPrev) {
-            g_wrapIdx = (g_wrapIdx + 1) % 3; applyTexParams(tex0); applyTexParams(tex1);
+            g_wrapIdx = (g_wrapIdx + 1) % 3; bindSamplers();
             std::cout << "Wrap: " << (g_wrapIdx == 0 ? "REPEAT" : g_wrapIdx == 1 ? "MIRRORED_REPEAT" : "CLAMP_TO_EDGE") << "\n";
         }
-        zPrev = zNow; xPrev = xNow;
+        bool fNow = (glfwGetKey(win, GLFW_KEY_F) == GLFW_PRESS);
+        if (fNow && !fPrev) {
+            g_anisotropy = g_anisotropy >= 16.0f ? 1.0f : g_anisotropy * 4.0f; bindSamplers();
+            std::cout << "Anisotropy: " << std::min(g_anisotropy, GetSamplerCache().MaxAnisotropy()) << "x\n";
+        }
+        bool aNow = (glfwGetKey(win, GLFW_KEY_A) == GLFW_PRESS);
+        if (aNow && !aPrev) {
+            g_arrayMode = !g_arrayMode;
+            std::cout << "Mode: " << (g_arrayMode ? "TEXTURE_2D_ARRAY (instanced)" : "two textures") << "\n";
+        }
+        zPrev = zNow; xPrev = xNow; fPrev = fNow; aPrev = aNow;
 
         glClearColor(0.08f, 0.08f, 0.1f, 1); glClear(GL_COLOR_BUFFER_BIT);
-        glUseProgram(prog);
-        glUniform1f(glGetUniformLocation(prog, "uMix"), g_mix);
-
-        glActiveTexture(GL_TEXTURE0); glBindTexture(GL_TEXTURE_2D, tex0);
-        glActiveTexture(GL_TEXTURE1); glBindTexture(GL_TEXTURE_2D, tex1);
-
-        glBindVertexArray(vao);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        // 상태가 그대로면 GL 호출 없이 지나감 (GlState)
+        if (g_arrayMode) {
+            // 배열 하나당 바인드 1번 + 인스턴스 드로우 1번 (재질은 인스턴스의 레이어 번호로만 구분)
+            gl.UseProgram(arrayProg);
+            gl.BindVertexArray(vao);
+            for (const ArrayDraw& draw : arrayDraws) {
+                gl.BindTexture(2, GL_TEXTURE_2D_ARRAY, materials.Arrays()[draw.array].tex);
+                gl.BindBuffer(GL_ARRAY_BUFFER, instVbo);
+                glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(draw.first * 4 * sizeof(float)));
+                glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, draw.count);
+            }
+        } else {
+            gl.UseProgram(prog);
+            uniforms.Set("uMix"_u, g_mix); // 값이 그대로면 glUniform1f 생략
+
+            gl.BindTexture(0, GL_TEXTURE_2D, tex0);
+            gl.BindTexture(1, GL_TEXTURE_2D, tex1);
+
+            gl.BindVertexArray(vao);
+            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        }
 
         glfwSwapBuffers(win); glfwPollEvents();
     }
+    loader.PrintStats(stdout);
+    PrintImageArenaStats(stdout);
+    textures.PrintStats(stdout);
+    materials.PrintStats(stdout);
+    GetSamplerCache().PrintStats(stdout);
+    uploadRing.PrintStats(stdout);
+    reloader.PrintStats(stdout);
+    texShaders.PrintStats(stdout);
+    uniforms.PrintStats(stdout);
+    GetVfs().PrintStats(stdout);
+    gl.PrintStats(stdout);
+    reloader.Stop();
+    texHandle0 = {}; texHandle1 = {};   // 컨텍스트가 살아 있을 때 텍스처 해제
+    materials.Destroy();
+    GetSamplerCache().Clear();
+    texShaders.Clear();
+    loader.Shutdown();
+    uploadRing.Destroy();
+    compiler.Shutdown();
     glfwTerminate();
     return 0;
 }
@@ -0,0 +1,342 @@
+#include "mip_builder.h"
+#include "cpu_features.h"
+#include "mip_kernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIP_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define MIP_USE_SSE2 0
+#endif
+
+namespace {
+// ── 스칼라 커널 ──
+void BoxScalar(const float* r0, const float* r1, float* out, int n) {
+    for (int x = 0; x < n; ++x)
+        for (int k = 0; k < 4; ++k)
+            out[4 * x + k] = 0.25f * (r0[8 * x + k] + r0[8 * x + 4 + k] + r1[8 * x + k] + r1[8 * x + 4 + k]);
+}
+
+void KaiserHScalar(const float* src, float* out, int n, const float* w) {
+    for (int x = 0; x < n; ++x)
+        for (int k = 0; k < 4; ++k) {
+            float acc = 0.0f;
+            for (int i = 0; i < kKaiserTaps; ++i) acc += w[i] * src[4 * (2 * x - 3 + i) + k];
+            out[4 * x + k] = acc;
+        }
+}
+
+void KaiserVScalar(const float* const* rows, float* out, int count, const float* w) {
+    for (int j = 0; j < count; ++j) {
+        float acc = 0.0f;
+        for (int i = 0; i < kKaiserTaps; ++i) acc += w[i] * rows[i][j];
+        out[j] = acc;
+    }
+}
+
+const MipKernels kScalar = { "scalar", BoxScalar, KaiserHScalar, KaiserVScalar };
+
+// ── SSE2 커널: 픽셀 하나(RGBA) = __m128 하나 ──
+#if MIP_USE_SSE2
+void BoxSse2(const float* r0, const float* r1, float* out, int n) {
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    for (int x = 0; x < n; ++x) {
+        const __m128 s = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(r0 + 8 * x), _mm_loadu_ps(r0 + 8 * x + 4)),
+                                    _mm_add_ps(_mm_loadu_ps(r1 + 8 * x), _mm_loadu_ps(r1 + 8 * x + 4)));
+        _mm_storeu_ps(out + 4 * x, _mm_mul_ps(s, quarter));
+    }
+}
+
+void KaiserHSse2(const float* src, float* out, int n, const float* w) {
+    for (int x = 0; x < n; ++x) {
+        __m128 acc = _mm_setzero_ps();
+        for (int i = 0; i < kKaiserTaps; ++i)
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[i]), _mm_loadu_ps(src + 4 * (2 * x - 3 + i))));
+        _mm_storeu_ps(out + 4 * x, acc);
+    }
+}
+
+void KaiserVSse2(const float* const* rows, float* out, int count, const float* w) {
+    int j = 0;
+    for (; j + 4 <= count; j += 4) {
+        __m128 acc = _mm_setzero_ps();
+        for (int i = 0; i < kKaiserTaps; ++i)
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[i]), _mm_loadu_ps(rows[i] + j)));
+        _mm_storeu_ps(out + j, acc);
+    }
+    for (; j < count; ++j) {
+        float acc = 0.0f;
+        for (int i = 0; i < kKaiserTaps; ++i) acc += w[i] * rows[i][j];
+        out[j] = acc;
+    }
+}
+
+const MipKernels kSse2 = { "sse2", BoxSse2, KaiserHSse2, KaiserVSse2 };
+#endif
+
+const MipKernels& Select(MipKernel kernel) {
+    const CpuFeatures& cpu = GetCpuFeatures();
+    if ((kernel == MipKernel::Auto || kernel == MipKernel::Avx2) && cpu.avx2 && Avx2MipKernels())
+        return *Avx2MipKernels();
+    if (kernel == MipKernel::Scalar) return ScalarMipKernels();
+    return Sse2MipKernels();
+}
+
+// ── sRGB 변환표 ──
+constexpr int kEncodeBits = 14;   // 선형 → sRGB 표 크기 (어두운 쪽도 8비트 반올림과 어긋나지 않을 만큼)
+constexpr int kEncodeMax = (1 << kEncodeBits) - 1;
+
+struct SrgbTables {
+    float decode[256];
+    uint8_t encode[kEncodeMax + 1];
+    SrgbTables() {
+        for (int i = 0; i < 256; ++i) {
+            const double c = i / 255.0;
+            decode[i] = (float)(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+        }
+        for (int i = 0; i <= kEncodeMax; ++i) {
+            const double l = (double)i / kEncodeMax;
+            const double s = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+            encode[i] = (uint8_t)std::lround(std::clamp(s, 0.0, 1.0) * 255.0);
+        }
+    }
+};
+
+const SrgbTables& Srgb() {
+    static const SrgbTables t;
+    return t;
+}
+
+// Kaiser 창 sinc (2배 축소: 차단 주파수 = 새 나이퀴스트). 출력 중심 기준 입력 픽셀 거리 -3.5 .. 3.5
+const float* KaiserWeights() {
+    static const auto weights = [] {
+        struct W { float w[kKaiserTaps]; } r{};
+        auto bessel0 = [](double x) {
+            double sum = 1.0, term = 1.0;
+            for (int k = 1; k < 20; ++k) { term *= (x / (2.0 * k)) * (x / (2.0 * k)); sum += term; }
+            return sum;
+        };
+        const double pi = 3.14159265358979323846, beta = 4.0, radius = kKaiserTaps / 2.0;
+        double total = 0.0;
+        for (int i = 0; i < kKaiserTaps; ++i) {
+            const double d = i - (kKaiserTaps - 1) / 2.0;
+            const double x = d / 2.0;
+            const double sinc = x == 0.0 ? 1.0 : std::sin(pi * x) / (pi * x);
+            const double t = d / radius;
+            const double window = bessel0(beta * std::sqrt(std::max(0.0, 1.0 - t * t))) / bessel0(beta);
+            r.w[i] = (float)(sinc * window);
+            total += r.w[i];
+        }
+        for (float& v : r.w) v = (float)(v / total);
+        return r;
+    }();
+    return weights.w;
+}
+
+// 행 범위를 스레드로 나눔. 작은 레벨은 스레드 생성 비용이 더 커서 그냥 현재 스레드에서
+template <typename F>
+void ParallelRows(int rows, size_t pixelsPerRow, int threads, F&& fn) {
+    constexpr size_t kMinPixelsPerThread = 64 * 1024;
+    threads = (int)std::min<size_t>((size_t)threads, std::max<size_t>(1, rows * pixelsPerRow / kMinPixelsPerThread));
+    threads = std::clamp(threads, 1, std::max(1, rows));
+    if (threads == 1) { fn(0, rows); return; }
+    std::vector<std::thread> pool;
+    const int per = (rows + threads - 1) / threads;
+    for (int t = 1; t < threads; ++t) {
+        const int b = t * per, e = std::min(rows, b + per);
+        if (b < e) pool.emplace_back(fn, b, e);
+    }
+    fn(0, std::min(rows, per));
+    for (std::thread& th : pool) th.join();
+}
+
+struct Lanes {
+    int channels;
+    bool srgb[4];      // sRGB 곡선을 적용할 채널
+    int alpha;         // 알파 채널 (없으면 -1)
+};
+
+Lanes MakeLanes(int channels, bool srgb) {
+    Lanes l{ channels, {}, channels == 2 ? 1 : channels == 4 ? 3 : -1 };
+    for (int k = 0; k < channels; ++k) l.srgb[k] = srgb && k != l.alpha;
+    return l;
+}
+
+float Coverage(const float* px, size_t count, float cutoff) {
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) n += px[4 * i + 3] > cutoff;
+    return count ? (float)n / count : 0.0f;
+}
+
+// 알파 테스트 커버리지를 target에 맞추는 배율 (이 레벨의 알파 분포에서 기준값을 이분 탐색)
+float CoverageScale(const std::vector<float>& level, size_t count, float cutoff, float target) {
+    float lo = 0.0f, hi = 1.0f, ref = cutoff;
+    for (int it = 0; it < 12; ++it) {
+        ref = 0.5f * (lo + hi);
+        if (Coverage(level.data(), count, ref) > target) lo = ref; else hi = ref;
+    }
+    return ref > 0.0f ? cutoff / ref : 1.0f;
+}
+}
+
+const MipKernels& ScalarMipKernels() { return kScalar; }
+#if MIP_USE_SSE2
+const MipKernels& Sse2MipKernels() { return kSse2; }
+#else
+const MipKernels& Sse2MipKernels() { return kScalar; }
+#endif
+
+int MipLevelCount(int w, int h, int maxLevels) {
+    int levels = 1;
+    while ((w > 1 || h > 1) && levels < maxLevels) {
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+        ++levels;
+    }
+    return levels;
+}
+
+size_t MipChainBytes(int w, int h, int channels, int maxLevels) {
+    size_t bytes = 0;
+    for (int i = 0, n = MipLevelCount(w, h, maxLevels); i < n; ++i) {
+        bytes += (size_t)w * h * channels;
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    return bytes;
+}
+
+bool IsMipKernelSupported(MipKernel kernel) {
+    switch (kernel) {
+    case MipKernel::Avx2: return GetCpuFeatures().avx2 && Avx2MipKernels() != nullptr;
+    case MipKernel::Sse2: return MIP_USE_SSE2 != 0;
+    default: return true;
+    }
+}
+
+const char* MipKernelName(MipKernel kernel) { return Select(kernel).name; }
+
+std::vector<MipLevel> BuildMipChain(const unsigned char* src, int w, int h, int channels,
+                                    const MipOptions& options, MipStats* stats) {
+    auto t0 = std::chrono::steady_clock::now();
+    const MipKernels& k = Select(options.kernel);
+    const int threads = options.threads > 0 ? options.threads : std::max(1, (int)std::thread::hardware_concurrency());
+    const Lanes lanes = MakeLanes(channels, options.srgb);
+    const SrgbTables& srgb = Srgb();
+    const int levelCount = MipLevelCount(w, h, options.maxLevels);
+    std::vector<MipLevel> out;
+    if (levelCount <= 1) return out;
+    out.reserve(levelCount - 1);
+
+    // 레벨 0 → 선형 float RGBA (없는 채널은 0)
+    std::vector<float> cur((size_t)w * h * 4);
+    ParallelRows(h, w, threads, [&](int y0, int y1) {
+        for (size_t i = (size_t)y0 * w; i < (size_t)y1 * w; ++i)
+            for (int c = 0; c < 4; ++c)
+                cur[4 * i + c] = c >= channels ? 0.0f
+                               : lanes.srgb[c] ? srgb.decode[src[i * channels + c]] : src[i * channels + c] / 255.0f;
+    });
+
+    const bool keepCoverage = options.alphaCutoff > 0.0f && lanes.alpha >= 0;
+    float targetCoverage = 0.0f;
+    if (keepCoverage) {
+        const unsigned char cut = (unsigned char)std::lround(options.alphaCutoff * 255.0f);
+        size_t n = 0;
+        for (size_t i = 0, count = (size_t)w * h; i < count; ++i) n += src[i * channels + lanes.alpha] > cut;
+        targetCoverage = (float)n / ((size_t)w * h);
+    }
+    // 커버리지 계산이 채널 3을 보므로 2채널(회색+알파)은 알파를 3번에도 복사해 둠
+    auto mirrorAlpha = [&](std::vector<float>& px) {
+        if (keepCoverage && lanes.alpha != 3)
+            for (size_t i = 0; i < px.size(); i += 4) px[i + 3] = px[i + lanes.alpha];
+    };
+    mirrorAlpha(cur);
+
+    const float* weights = KaiserWeights();
+    size_t pixelsIn = 0;
+    int cw = w, ch = h;
+    std::vector<float> tmp;
+    for (int level = 1; level < levelCount; ++level) {
+        const int nw = std::max(1, cw / 2), nh = std::max(1, ch / 2);
+        std::vector<float> next((size_t)nw * nh * 4);
+        pixelsIn += (size_t)cw * ch;
+
+        if (options.filter == MipFilter::Box) {
+            ParallelRows(nh, (size_t)cw * 2, threads, [&](int y0, int y1) {
+                for (int y = y0; y < y1; ++y) {
+                    const float* r0 = &cur[(size_t)std::min(2 * y, ch - 1) * cw * 4];
+                    const float* r1 = &cur[(size_t)std::min(2 * y + 1, ch - 1) * cw * 4];
+                    float* o = &next[(size_t)y * nw * 4];
+                    if (cw == 1) {
+                        for (int c = 0; c < 4; ++c) o[c] = 0.5f * (r0[c] + r1[c]);
+                    } else {
+                        k.box(r0, r1, o, nw);   // 홀수 폭의 마지막 열은 버림 (GL 구현과 같은 관례)
+                    }
+                }
+            });
+        } else {
+            // 가로 8탭 → tmp (nw x ch), 세로 8탭 → next. 가장자리는 끝 픽셀 반복
+            tmp.resize((size_t)nw * ch * 4);
+            ParallelRows(ch, (size_t)cw, threads, [&](int y0, int y1) {
+                std::vector<float> padded((size_t)(cw + 2 * kMipRowPad) * 4);
+                for (int y = y0; y < y1; ++y) {
+                    const float* row = &cur[(size_t)y * cw * 4];
+                    for (int x = -kMipRowPad; x < cw + kMipRowPad; ++x) {
+                        const float* p = row + 4 * std::clamp(x, 0, cw - 1);
+                        std::copy(p, p + 4, &padded[(size_t)(x + kMipRowPad) * 4]);
+                    }
+                    k.kaiserH(&padded[kMipRowPad * 4], &tmp[(size_t)y * nw * 4], nw, weights);
+                }
+            });
+            ParallelRows(nh, (size_t)nw * 2, threads, [&](int y0, int y1) {
+                const float* rows[kKaiserTaps];
+                for (int y = y0; y < y1; ++y) {
+                    for (int i = 0; i < kKaiserTaps; ++i)
+                        rows[i] = &tmp[(size_t)std::clamp(2 * y - 3 + i, 0, ch - 1) * nw * 4];
+                    k.kaiserV(rows, &next[(size_t)y * nw * 4], nw * 4, weights);
+                }
+            });
+        }
+        mirrorAlpha(next);
+
+        // float → 8비트 (음의 로브 때문에 범위를 벗어날 수 있어 잘라냄)
+        const float alphaScale = keepCoverage ? CoverageScale(next, (size_t)nw * nh, options.alphaCutoff, targetCoverage) : 1.0f;
+        MipLevel lv;
+        lv.width = nw;
+        lv.height = nh;
+        lv.pixels.resize((size_t)nw * nh * channels);
+        ParallelRows(nh, nw, threads, [&](int y0, int y1) {
+            for (size_t i = (size_t)y0 * nw; i < (size_t)y1 * nw; ++i)
+                for (int c = 0; c < channels; ++c) {
+                    float v = next[4 * i + c];
+                    if (c == lanes.alpha) v *= alphaScale;
+                    v = std::clamp(v, 0.0f, 1.0f);
+                    lv.pixels[i * channels + c] = lanes.srgb[c] ? srgb.encode[(int)(v * kEncodeMax + 0.5f)]
+                                                                : (unsigned char)(v * 255.0f + 0.5f);
+                }
+        });
+        out.push_back(std::move(lv));
+        cur.swap(next);
+        cw = nw;
+        ch = nh;
+    }
+
+    if (stats) {
+        stats->levels += (unsigned)out.size();
+        stats->pixelsIn += pixelsIn;
+        stats->ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        stats->kernel = k.name;
+    }
+    return out;
+}
+
+void PrintMipStats(FILE* out, const char* name, const MipStats& stats) {
+    fprintf(out, "[MipBuilder] %s %s | %u levels, %.2f ms (%.1f MPix/s)\n",
+            name, stats.kernel, stats.levels, stats.ms, stats.MPixPerSec());
+}
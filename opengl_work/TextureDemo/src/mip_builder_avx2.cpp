@@ -0,0 +1,69 @@
+// AVX2 + FMA 행 커널. 이 파일만 -mavx2 -mfma (MSVC: /arch:AVX2)로 빌드되므로
+// GetCpuFeatures().avx2를 확인한 뒤에만 호출할 것
+#include "mip_kernels.h"
+
+#if defined(MIP_HAVE_AVX2)
+#include <immintrin.h>
+
+namespace {
+void BoxAvx2(const float* r0, const float* r1, float* out, int n) {
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+    int x = 0;
+    // 출력 2픽셀 = 입력 4픽셀 (위아래 행)
+    for (; x + 2 <= n; x += 2) {
+        const __m256 a = _mm256_add_ps(_mm256_loadu_ps(r0 + 8 * x), _mm256_loadu_ps(r1 + 8 * x));
+        const __m256 b = _mm256_add_ps(_mm256_loadu_ps(r0 + 8 * x + 8), _mm256_loadu_ps(r1 + 8 * x + 8));
+        // a = (p0, p1), b = (p2, p3) → (p0 + p1, p2 + p3)
+        const __m256 lo = _mm256_permute2f128_ps(a, b, 0x20);
+        const __m256 hi = _mm256_permute2f128_ps(a, b, 0x31);
+        _mm256_storeu_ps(out + 4 * x, _mm256_mul_ps(_mm256_add_ps(lo, hi), quarter));
+    }
+    for (; x < n; ++x) {
+        const __m128 s = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(r0 + 8 * x), _mm_loadu_ps(r0 + 8 * x + 4)),
+                                    _mm_add_ps(_mm_loadu_ps(r1 + 8 * x), _mm_loadu_ps(r1 + 8 * x + 4)));
+        _mm_storeu_ps(out + 4 * x, _mm_mul_ps(s, _mm_set1_ps(0.25f)));
+    }
+}
+
+void KaiserHAvx2(const float* src, float* out, int n, const float* w) {
+    int x = 0;
+    for (; x + 2 <= n; x += 2) {
+        __m256 acc = _mm256_setzero_ps();
+        for (int i = 0; i < kKaiserTaps; ++i) {
+            // 출력 x의 탭 i와 출력 x+1의 탭 i (입력 두 픽셀 간격)
+            const float* p = src + 4 * (2 * x - 3 + i);
+            const __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 8), 1);
+            acc = _mm256_fmadd_ps(_mm256_set1_ps(w[i]), v, acc);
+        }
+        _mm256_storeu_ps(out + 4 * x, acc);
+    }
+    for (; x < n; ++x) {
+        __m128 acc = _mm_setzero_ps();
+        for (int i = 0; i < kKaiserTaps; ++i)
+            acc = _mm_fmadd_ps(_mm_set1_ps(w[i]), _mm_loadu_ps(src + 4 * (2 * x - 3 + i)), acc);
+        _mm_storeu_ps(out + 4 * x, acc);
+    }
+}
+
+void KaiserVAvx2(const float* const* rows, float* out, int count, const float* w) {
+    int j = 0;
+    for (; j + 8 <= count; j += 8) {
+        __m256 acc = _mm256_setzero_ps();
+        for (int i = 0; i < kKaiserTaps; ++i)
+            acc = _mm256_fmadd_ps(_mm256_set1_ps(w[i]), _mm256_loadu_ps(rows[i] + j), acc);
+        _mm256_storeu_ps(out + j, acc);
+    }
+    for (; j < count; ++j) {
+        float acc = 0.0f;
+        for (int i = 0; i < kKaiserTaps; ++i) acc += w[i] * rows[i][j];
+        out[j] = acc;
+    }
+}
+
+const MipKernels kAvx2 = { "avx2", BoxAvx2, KaiserHAvx2, KaiserVAvx2 };
+}
+
+const MipKernels* Avx2MipKernels() { return &kAvx2; }
+#else
+const MipKernels* Avx2MipKernels() { return nullptr; }
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+// mip_builder 내부용 행 커널 (픽셀 = float RGBA 4개, 선형 값)
+// 스칼라/SSE2는 mip_builder.cpp, AVX2+FMA는 별도 플래그로 빌드하는 mip_builder_avx2.cpp
+
+// 가로 Kaiser 입력 행의 좌우 여유 픽셀 수 (8탭: 2x-3 .. 2x+4)
+constexpr int kMipRowPad = 4;
+constexpr int kKaiserTaps = 8;
+
+struct MipKernels {
+    const char* name;
+    // 2x2 박스: out[x] = (r0[2x] + r0[2x+1] + r1[2x] + r1[2x+1]) / 4, 출력 n픽셀
+    void (*box)(const float* r0, const float* r1, float* out, int n);
+    // 가로 8탭: out[x] = Σ w[i] * src[2x - 3 + i] (src 앞뒤로 kMipRowPad픽셀 읽을 수 있어야 함)
+    void (*kaiserH)(const float* src, float* out, int n, const float* w);
+    // 세로 8탭: out[j] = Σ w[i] * rows[i][j], count개 float
+    void (*kaiserV)(const float* const* rows, float* out, int count, const float* w);
+};
+
+const MipKernels& ScalarMipKernels();
+const MipKernels& Sse2MipKernels();     // SSE2가 없는 빌드면 스칼라
+const MipKernels* Avx2MipKernels();     // AVX2 커널을 빌드하지 않았으면 nullptr
@@ -0,0 +1,21 @@
+// 기준선 stb_image: 모든 함수가 static이라 이 TU 밖으로 나가는 것은 아래 래퍼뿐
+#include "stb_image_baseline.h"
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"   // 쓰지 않는 static API 함수
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"   // 원본 v2.30의 stbi__context 경고 (손대지 않는 사본)
+#endif
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_baseline/stb_image.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+unsigned char* BaselineStbiLoadFromMemory(const unsigned char* data, int size, int* x, int* y, int* channels,
+                                          int desiredChannels) {
+    return stbi_load_from_memory(data, size, x, y, channels, desiredChannels);
+}
+
+void BaselineStbiFree(void* pixels) { stbi_image_free(pixels); }
@@ -1,3 +1,8 @@
+// stb 할당은 스레드별 아레나로 (image_arena.h). ImageArenaScope 밖에서는 그냥 힙
+#include "image_arena.h"
+
+#define STBI_MALLOC(sz)        ImageArenaMalloc(sz)
+#define STBI_REALLOC(p, newsz) ImageArenaRealloc(p, newsz)
+#define STBI_FREE(p)           ImageArenaFree(p)
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
-
@@ -0,0 +1,189 @@
+#include "texture_array_pool.h"
+#include "gl_state.h"
+#include "image_arena.h"
+#include "jpeg_simd.h"
+#include "mip_builder.h"
+#include "pixel_upload_ring.h"
+#include "stb_image.h"
+#include "vfs.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+// 업로드 전용 유닛 (TextureLoader와 같은 유닛)
+constexpr int kUploadUnit = GlState::kMaxTextureUnits - 1;
+
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// 3채널은 4채널로 넓혀 저장
+int StoredChannels(int channels) { return channels == 3 ? 4 : channels; }
+
+void FormatsFor(int storedChannels, GLenum& internal, GLenum& format) {
+    switch (storedChannels) {
+    case 1:  internal = GL_R8;    format = GL_RED;  break;
+    case 2:  internal = GL_RG8;   format = GL_RG;   break;
+    default: internal = GL_RGBA8; format = GL_RGBA; break;
+    }
+}
+}
+
+void TextureArrayPool::Init(const TextureArrayPoolOptions& options, PixelUploadRing* ring) {
+    Destroy();
+    InstallDefaultJpegKernels();
+    options_ = options;
+    options_.layersPerArray = std::max(1, options_.layersPerArray);
+    ring_ = ring;
+}
+
+void TextureArrayPool::Destroy() {
+    for (Array& a : arrays_) {
+        GetGlState().ForgetTexture(a.tex);
+        glDeleteTextures(1, &a.tex);
+    }
+    arrays_.clear();
+    names_.clear();
+}
+
+int TextureArrayPool::CreateArray(int w, int h, GLenum internalFormat) {
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    Array a;
+    a.width = w;
+    a.height = h;
+    a.internalFormat = internalFormat;
+    a.levels = MipLevelCount(w, h, options_.maxLevels);
+    a.capacity = std::min(options_.layersPerArray, std::max(1, (int)maxLayers));
+    for (int i = a.capacity - 1; i >= 0; --i) a.freeLayers.push_back(i);
+
+    const int channels = internalFormat == GL_R8 ? 1 : internalFormat == GL_RG8 ? 2 : 4;
+    const GLenum format = channels == 1 ? GL_RED : channels == 2 ? GL_RG : GL_RGBA;
+
+    glGenTextures(1, &a.tex);
+    GetGlState().BindTexture(kUploadUnit, GL_TEXTURE_2D_ARRAY, a.tex);
+    // 4.2+: 불변 저장소. 3.3이면 레벨마다 빈 glTexImage3D + MAX_LEVEL
+    if (glTexStorage3D) {
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, a.levels, internalFormat, w, h, a.capacity);
+    } else {
+        for (int i = 0; i < a.levels; ++i)
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, i, internalFormat, std::max(1, w >> i), std::max(1, h >> i), a.capacity,
+                         0, format, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, a.levels - 1);
+    }
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, options_.wrap);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, options_.wrap);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, a.levels > 1 ? options_.minFilter : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, options_.magFilter);
+
+    ++stats_.arraysCreated;
+    stats_.bytesAllocated += MipChainBytes(w, h, channels, a.levels) * a.capacity;
+    arrays_.push_back(std::move(a));
+    return (int)arrays_.size() - 1;
+}
+
+ArrayLayer TextureArrayPool::Add(const std::string& name, const unsigned char* pixels, int w, int h, int channels) {
+    if (!pixels || w <= 0 || h <= 0 || channels < 1 || channels > 4) { ++stats_.failed; return {}; }
+    Remove(name);
+
+    const int stored = StoredChannels(channels);
+    GLenum internal = 0, format = 0;
+    FormatsFor(stored, internal, format);
+
+    // 같은 버킷에서 빈 레이어가 있는 배열, 없으면 새 배열
+    int index = -1;
+    for (size_t i = 0; i < arrays_.size() && index < 0; ++i) {
+        const Array& a = arrays_[i];
+        if (a.width == w && a.height == h && a.internalFormat == internal && !a.freeLayers.empty()) index = (int)i;
+    }
+    if (index < 0) index = CreateArray(w, h, internal);
+    Array& a = arrays_[index];
+    ArrayLayer ref{ index, a.freeLayers.back() };
+    a.freeLayers.pop_back();
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<unsigned char> expanded;
+    const unsigned char* base = pixels;
+    if (stored != channels) {
+        expanded.resize((size_t)w * h * 4);
+        for (size_t i = 0, n = (size_t)w * h; i < n; ++i) {
+            expanded[i * 4 + 0] = pixels[i * 3 + 0];
+            expanded[i * 4 + 1] = pixels[i * 3 + 1];
+            expanded[i * 4 + 2] = pixels[i * 3 + 2];
+            expanded[i * 4 + 3] = 255;
+        }
+        base = expanded.data();
+    }
+    std::vector<MipLevel> mips;
+    if (a.levels > 1) {
+        MipOptions mo;
+        mo.srgb = options_.srgbMips;
+        mo.maxLevels = a.levels;
+        mips = BuildMipChain(base, w, h, stored, mo);
+    }
+    stats_.mipMs += MsSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    GetGlState().BindTexture(kUploadUnit, GL_TEXTURE_2D_ARRAY, a.tex);
+    // R8/RG8 행은 4바이트 정렬이 아닐 수 있음
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    auto upload = [&](int level, int lw, int lh, const unsigned char* px) {
+        const size_t bytes = (size_t)lw * lh * stored;
+        if (ring_) ring_->TexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, ref.layer, lw, lh, 1, format, GL_UNSIGNED_BYTE, px, bytes);
+        else glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, ref.layer, lw, lh, 1, format, GL_UNSIGNED_BYTE, px);
+        stats_.bytesUploaded += bytes;
+    };
+    upload(0, w, h, base);
+    for (size_t i = 0; i < mips.size(); ++i) upload((int)i + 1, mips[i].width, mips[i].height, mips[i].pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    stats_.uploadMs += MsSince(t0);
+
+    ++stats_.added;
+    names_[name] = ref;
+    return ref;
+}
+
+ArrayLayer TextureArrayPool::AddFile(const std::string& path, bool flipY) {
+    FileView file = GetVfs().Open(path);
+    if (!file) { ++stats_.failed; return {}; }
+    // stb 결과도 아래 stbi_image_free까지 이 스코프 안에서만 씀
+    ImageArenaScope arena(ImageArenaEstimate(file.data(), file.size()));
+    stbi_set_flip_vertically_on_load_thread(flipY);
+    int w = 0, h = 0, c = 0;
+    unsigned char* px = stbi_load_from_memory(file.data(), (int)file.size(), &w, &h, &c, 0);
+    if (!px) {
+        fprintf(stderr, "[TextureArrayPool] decode failed: %s (%s)\n", path.c_str(), stbi_failure_reason());
+        ++stats_.failed;
+        return {};
+    }
+    const ArrayLayer ref = Add(path, px, w, h, c);
+    stbi_image_free(px);
+    return ref;
+}
+
+bool TextureArrayPool::Remove(const std::string& name) {
+    auto it = names_.find(name);
+    if (it == names_.end()) return false;
+    arrays_[it->second.array].freeLayers.push_back(it->second.layer);
+    names_.erase(it);
+    ++stats_.removed;
+    return true;
+}
+
+ArrayLayer TextureArrayPool::Find(const std::string& name) const {
+    auto it = names_.find(name);
+    return it == names_.end() ? ArrayLayer{} : it->second;
+}
+
+void TextureArrayPool::PrintStats(FILE* out) const {
+    fprintf(out, "[TextureArrayPool] layers=%zu arrays=%zu added=%u removed=%u failed=%u | %zu bytes allocated, %zu uploaded"
+                 " | mips %.3f ms, upload %.3f ms\n",
+            names_.size(), arrays_.size(), stats_.added, stats_.removed, stats_.failed, stats_.bytesAllocated,
+            stats_.bytesUploaded, stats_.mipMs, stats_.uploadMs);
+    for (size_t i = 0; i < arrays_.size(); ++i) {
+        const Array& a = arrays_[i];
+        fprintf(out, "  [%zu] %dx%d fmt=0x%X levels=%d layers %d/%d\n", i, a.width, a.height, a.internalFormat,
+                a.levels, a.Used(), a.capacity);
+    }
+}
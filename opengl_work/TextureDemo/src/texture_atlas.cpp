@@ -0,0 +1,289 @@
+#include "texture_atlas.h"
+#include "gl_state.h"
+#include "image_arena.h"
+#include "jpeg_simd.h"
+#include "mip_builder.h"
+#include "pixel_upload_ring.h"
+#include "stb_image.h"
+#include "vfs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+namespace {
+// 업로드 전용 유닛 (TextureLoader와 같은 유닛)
+constexpr int kUploadUnit = GlState::kMaxTextureUnits - 1;
+
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+bool Overlaps(const AtlasRect& a, const AtlasRect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+bool Contains(const AtlasRect& outer, const AtlasRect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.w <= outer.x + outer.w && inner.y + inner.h <= outer.y + outer.h;
+}
+
+int RoundUp(int v, int a) { return (v + a - 1) / a * a; }
+}
+
+// ── MaxRectsPacker ──
+void MaxRectsPacker::Reset(int width, int height) {
+    width_ = width;
+    height_ = height;
+    usedArea_ = 0;
+    used_.clear();
+    free_.assign(1, AtlasRect{ 0, 0, width, height });
+}
+
+bool MaxRectsPacker::Insert(int w, int h, AtlasRect* out) {
+    if (w <= 0 || h <= 0) return false;
+    // Best Short Side Fit: 남는 짧은 변이 가장 작은 자리 (같으면 긴 변)
+    int bestShort = INT_MAX, bestLong = INT_MAX;
+    const AtlasRect* best = nullptr;
+    for (const AtlasRect& f : free_) {
+        if (f.w < w || f.h < h) continue;
+        const int dw = f.w - w, dh = f.h - h;
+        const int s = std::min(dw, dh), l = std::max(dw, dh);
+        if (s < bestShort || (s == bestShort && l < bestLong)) {
+            bestShort = s; bestLong = l; best = &f;
+        }
+    }
+    if (!best) return false;
+    const AtlasRect r{ best->x, best->y, w, h };
+    SplitFree(r);
+    Prune();
+    used_.push_back(r);
+    usedArea_ += (size_t)w * h;
+    if (out) *out = r;
+    return true;
+}
+
+bool MaxRectsPacker::Remove(const AtlasRect& r) {
+    auto it = std::find_if(used_.begin(), used_.end(), [&](const AtlasRect& u) {
+        return u.x == r.x && u.y == r.y && u.w == r.w && u.h == r.h;
+    });
+    if (it == used_.end()) return false;
+    usedArea_ -= (size_t)r.w * r.h;
+    used_.erase(it);
+    // 빈 사각형을 이어 붙이는 대신 남은 칸으로 처음부터 다시 자름 (항상 최대 사각형 목록이 됨)
+    free_.assign(1, AtlasRect{ 0, 0, width_, height_ });
+    for (const AtlasRect& u : used_) {
+        SplitFree(u);
+        Prune();
+    }
+    return true;
+}
+
+size_t MaxRectsPacker::LargestFreeArea() const {
+    size_t best = 0;
+    for (const AtlasRect& f : free_) best = std::max(best, (size_t)f.w * f.h);
+    return best;
+}
+
+void MaxRectsPacker::SplitFree(const AtlasRect& r) {
+    const size_t n = free_.size();
+    for (size_t i = 0; i < n; ++i) {
+        const AtlasRect f = free_[i];
+        if (!Overlaps(f, r)) continue;
+        // r 바깥으로 남는 네 방향 조각 (서로 겹칠 수 있음)
+        if (r.x > f.x) free_.push_back({ f.x, f.y, r.x - f.x, f.h });
+        if (r.x + r.w < f.x + f.w) free_.push_back({ r.x + r.w, f.y, f.x + f.w - (r.x + r.w), f.h });
+        if (r.y > f.y) free_.push_back({ f.x, f.y, f.w, r.y - f.y });
+        if (r.y + r.h < f.y + f.h) free_.push_back({ f.x, r.y + r.h, f.w, f.y + f.h - (r.y + r.h) });
+        free_[i].w = 0;   // 지울 표시
+    }
+    free_.erase(std::remove_if(free_.begin(), free_.end(), [](const AtlasRect& f) { return f.w == 0; }), free_.end());
+}
+
+void MaxRectsPacker::Prune() {
+    for (size_t i = 0; i < free_.size(); ++i) {
+        for (size_t j = i + 1; j < free_.size(); ++j) {
+            if (Contains(free_[j], free_[i])) {
+                free_.erase(free_.begin() + i);
+                --i;
+                break;
+            }
+            if (Contains(free_[i], free_[j])) {
+                free_.erase(free_.begin() + j);
+                --j;
+            }
+        }
+    }
+}
+
+// ── TextureAtlas ──
+bool TextureAtlas::Init(const AtlasOptions& options, PixelUploadRing* ring) {
+    Destroy();
+    InstallDefaultJpegKernels();
+    options_ = options;
+    ring_ = ring;
+    int maxLevels = 1;
+    while ((options_.size >> maxLevels) > 0) ++maxLevels;
+    options_.mipLevels = std::max(1, std::min(options_.mipLevels, maxLevels));
+    align_ = 1 << (options_.mipLevels - 1);
+
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (options_.size <= 0 || options_.size > maxSize) {
+        fprintf(stderr, "[TextureAtlas] size %d not supported (max %d)\n", options_.size, maxSize);
+        return false;
+    }
+
+    glGenTextures(1, &tex_);
+    GetGlState().BindTexture(kUploadUnit, GL_TEXTURE_2D, tex_);
+    // 4.2+: 불변 저장소. 3.3이면 레벨마다 빈 glTexImage2D + MAX_LEVEL
+    if (glTexStorage2D) {
+        glTexStorage2D(GL_TEXTURE_2D, options_.mipLevels, GL_RGBA8, options_.size, options_.size);
+    } else {
+        for (int i = 0; i < options_.mipLevels; ++i) {
+            const int s = std::max(1, options_.size >> i);
+            glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, s, s, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, options_.mipLevels - 1);
+    }
+    // 아틀라스는 반복할 수 없으므로 항상 CLAMP (반복이 필요한 텍스처는 따로 둘 것)
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, options_.mipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    packer_.Reset(options_.size, options_.size);
+    return true;
+}
+
+void TextureAtlas::Destroy() {
+    if (tex_) {
+        GetGlState().ForgetTexture(tex_);
+        glDeleteTextures(1, &tex_);
+        tex_ = 0;
+    }
+    regions_.clear();
+}
+
+const AtlasRegion* TextureAtlas::Add(const std::string& name, const unsigned char* pixels, int w, int h, int channels) {
+    if (!tex_ || !pixels || w <= 0 || h <= 0 || channels < 1 || channels > 4) return nullptr;
+    Remove(name);
+
+    auto t0 = std::chrono::steady_clock::now();
+    const int pad = std::max(0, options_.padding);
+    const int sw = RoundUp(w + 2 * pad, align_), sh = RoundUp(h + 2 * pad, align_);
+    AtlasRegion region;
+    if (!packer_.Insert(sw, sh, &region.slot)) {
+        ++stats_.failed;
+        fprintf(stderr, "[TextureAtlas] no room for %s (%dx%d, largest free %zu px)\n",
+                name.c_str(), w, h, packer_.LargestFreeArea());
+        return nullptr;
+    }
+    region.x = region.slot.x + pad;
+    region.y = region.slot.y + pad;
+    region.w = w;
+    region.h = h;
+    const float inv = 1.0f / (float)options_.size;
+    region.u0 = region.x * inv;
+    region.v0 = region.y * inv;
+    region.u1 = (region.x + w) * inv;
+    region.v1 = (region.y + h) * inv;
+
+    // 칸 전체를 RGBA로 채움. 거터와 정렬 여백은 가장 가까운 가장자리 텍셀 복제
+    std::vector<unsigned char> slot((size_t)sw * sh * 4);
+    for (int y = 0; y < sh; ++y) {
+        const int sy = std::min(std::max(y - pad, 0), h - 1);
+        unsigned char* d = &slot[(size_t)y * sw * 4];
+        for (int x = 0; x < sw; ++x, d += 4) {
+            const int sx = std::min(std::max(x - pad, 0), w - 1);
+            const unsigned char* s = pixels + ((size_t)sy * w + sx) * channels;
+            d[0] = s[0];
+            d[1] = channels >= 3 ? s[1] : s[0];
+            d[2] = channels >= 3 ? s[2] : s[0];
+            d[3] = channels == 2 ? s[1] : channels == 4 ? s[3] : 255;
+        }
+    }
+    // 칸 크기가 align_의 배수라 레벨마다 정확히 절반 → 칸 단위 밉이 아틀라스 전체 밉과 같은 위치에 맞음
+    std::vector<MipLevel> mips;
+    if (options_.mipLevels > 1) {
+        MipOptions mo;
+        mo.srgb = options_.srgbMips;
+        mo.maxLevels = options_.mipLevels;
+        mo.threads = 1;
+        mips = BuildMipChain(slot.data(), sw, sh, 4, mo);
+    }
+    stats_.packMs += MsSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    GetGlState().BindTexture(kUploadUnit, GL_TEXTURE_2D, tex_);
+    auto upload = [&](int level, int lw, int lh, const unsigned char* px) {
+        const size_t bytes = (size_t)lw * lh * 4;
+        const GLint x = region.slot.x >> level, y = region.slot.y >> level;
+        if (ring_) ring_->TexSubImage2D(GL_TEXTURE_2D, level, x, y, lw, lh, GL_RGBA, GL_UNSIGNED_BYTE, px, bytes);
+        else glTexSubImage2D(GL_TEXTURE_2D, level, x, y, lw, lh, GL_RGBA, GL_UNSIGNED_BYTE, px);
+        stats_.bytesUploaded += bytes;
+    };
+    upload(0, sw, sh, slot.data());
+    for (size_t i = 0; i < mips.size(); ++i) upload((int)i + 1, mips[i].width, mips[i].height, mips[i].pixels.data());
+    stats_.uploadMs += MsSince(t0);
+
+    ++stats_.inserted;
+    return &(regions_[name] = region);
+}
+
+const AtlasRegion* TextureAtlas::AddFile(const std::string& path, bool flipY) {
+    FileView file = GetVfs().Open(path);
+    if (!file) return nullptr;
+    // stb 결과도 아래 stbi_image_free까지 이 스코프 안에서만 씀
+    ImageArenaScope arena(ImageArenaEstimate(file.data(), file.size()));
+    stbi_set_flip_vertically_on_load_thread(flipY);
+    int w = 0, h = 0, c = 0;
+    unsigned char* px = stbi_load_from_memory(file.data(), (int)file.size(), &w, &h, &c, 0);
+    if (!px) {
+        fprintf(stderr, "[TextureAtlas] decode failed: %s (%s)\n", path.c_str(), stbi_failure_reason());
+        return nullptr;
+    }
+    const AtlasRegion* r = Add(path, px, w, h, c);
+    stbi_image_free(px);
+    return r;
+}
+
+bool TextureAtlas::Remove(const std::string& name) {
+    auto it = regions_.find(name);
+    if (it == regions_.end()) return false;
+    // 텍셀은 지우지 않음 (다음에 그 자리에 들어오는 칸이 거터까지 덮어씀)
+    packer_.Remove(it->second.slot);
+    regions_.erase(it);
+    ++stats_.removed;
+    return true;
+}
+
+const AtlasRegion* TextureAtlas::Find(const std::string& name) const {
+    auto it = regions_.find(name);
+    return it == regions_.end() ? nullptr : &it->second;
+}
+
+void TextureAtlas::RemapUVs(float* vertices, size_t vertexCount, size_t stride, size_t uvOffset, const AtlasRegion& region) {
+    for (size_t i = 0; i < vertexCount; ++i) {
+        float* uv = vertices + i * stride + uvOffset;
+        region.Remap(uv[0], uv[1]);
+    }
+}
+
+float TextureAtlas::Fragmentation() const {
+    const size_t freeArea = packer_.FreeArea();
+    return freeArea ? 1.0f - (float)packer_.LargestFreeArea() / (float)freeArea : 0.0f;
+}
+
+float TextureAtlas::Occupancy() const {
+    const size_t total = (size_t)packer_.Width() * packer_.Height();
+    return total ? (float)packer_.UsedArea() / (float)total : 0.0f;
+}
+
+void TextureAtlas::PrintStats(FILE* out) const {
+    fprintf(out, "[TextureAtlas] %dx%d x%d levels | images=%zu inserted=%u removed=%u failed=%u | occupancy %.1f%%"
+                 " fragmentation %.2f free rects=%zu | %zu bytes, pack %.3f ms, upload %.3f ms\n",
+            options_.size, options_.size, options_.mipLevels, regions_.size(), stats_.inserted, stats_.removed,
+            stats_.failed, Occupancy() * 100.0f, Fragmentation(), packer_.FreeRectCount(), stats_.bytesUploaded,
+            stats_.packMs, stats_.uploadMs);
+}
@@ -0,0 +1,68 @@
+// 텍스처 쿠커: 이미지 파일을 .gtex(미리 뒤집고 밉 체인까지 만든 컨테이너)로 변환
+// 사용법: TextureCook [옵션] <src> <dst.gtex> [<src> <dst.gtex> ...]
+//   --no-flip, --no-mips
+//   --bc (불투명 BC1 / 알파 BC3), --bc7 (불투명 BC1 / 알파 BC7), --bc1, --bc3 (강제)
+//   --quality fast|normal|high, --threads N
+//   --mip-filter box|kaiser, --linear (sRGB 곡선 없이 평균), --alpha-cutoff 0.5 (알파 테스트 커버리지 유지)
+// 옵션은 모든 쌍에 적용됨. 압축하면 원본 대비 PSNR을 출력
+#include "cooked_texture.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    CookOptions options;
+    std::vector<std::string> files;
+    bool bad = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if (!std::strcmp(a, "--no-flip")) options.flipY = false;
+        else if (!std::strcmp(a, "--no-mips")) options.mipmaps = false;
+        else if (!std::strcmp(a, "--bc")) options.compression = CookCompression::Auto;
+        else if (!std::strcmp(a, "--bc7")) options.compression = CookCompression::AutoBc7;
+        else if (!std::strcmp(a, "--bc1")) options.compression = CookCompression::BC1;
+        else if (!std::strcmp(a, "--bc3")) options.compression = CookCompression::BC3;
+        else if (!std::strcmp(a, "--threads") && i + 1 < argc) options.threads = options.mip.threads = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "--linear")) options.mip.srgb = false;
+        else if (!std::strcmp(a, "--alpha-cutoff") && i + 1 < argc) options.mip.alphaCutoff = (float)std::atof(argv[++i]);
+        else if (!std::strcmp(a, "--mip-filter") && i + 1 < argc) {
+            const char* f = argv[++i];
+            if (!std::strcmp(f, "box")) options.mip.filter = MipFilter::Box;
+            else if (!std::strcmp(f, "kaiser")) options.mip.filter = MipFilter::Kaiser;
+            else bad = true;
+        }
+        else if (!std::strcmp(a, "--quality") && i + 1 < argc) {
+            const char* q = argv[++i];
+            if (!std::strcmp(q, "fast")) options.quality = BcQuality::Fast;
+            else if (!std::strcmp(q, "normal")) options.quality = BcQuality::Normal;
+            else if (!std::strcmp(q, "high")) options.quality = BcQuality::High;
+            else bad = true;
+        }
+        else if (a[0] == '-' && a[1] == '-') bad = true;
+        else files.push_back(a);
+    }
+    if (bad || files.empty() || files.size() % 2 != 0) {
+        fprintf(stderr, "usage: %s [--no-flip] [--no-mips] [--bc|--bc7|--bc1|--bc3] [--quality fast|normal|high] [--threads N]"
+                        " [--mip-filter box|kaiser] [--linear] [--alpha-cutoff A] <src> <dst.gtex> [<src> <dst.gtex> ...]\n", argv[0]);
+        return 2;
+    }
+
+    int failed = 0;
+    for (size_t i = 0; i < files.size(); i += 2) {
+        BcEncodeStats bcStats;
+        BcFormat bcFormat = BcFormat::BC1;
+        MipStats mipStats;
+        if (!CookTexture(files[i], files[i + 1], options, &bcStats, &bcFormat, &mipStats)) {
+            fprintf(stderr, "[TextureCook] failed: %s\n", files[i].c_str());
+            ++failed;
+            continue;
+        }
+        printf("[TextureCook] %s -> %s\n", files[i].c_str(), files[i + 1].c_str());
+        if (options.mipmaps) PrintMipStats(stdout, files[i + 1].c_str(), mipStats);
+        if (options.compression != CookCompression::None) PrintBcStats(stdout, files[i + 1].c_str(), bcFormat, bcStats);
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,464 @@
+#include "texture_loader.h"
+#include "cooked_texture.h"
+#include "gl_state.h"
+#include "image_arena.h"
+#include "jpeg_simd.h"
+#include "pixel_upload_ring.h"
+#include "stb_image.h"
+#include "vfs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+// 업로드 전용 유닛: 렌더 루프가 쓰는 유닛의 바인딩을 건드리지 않음
+constexpr int kUploadUnit = GlState::kMaxTextureUnits - 1;
+
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void FormatsFor(int channels, GLint& internal, GLenum& format) {
+    switch (channels) {
+    case 1:  internal = GL_R8;    format = GL_RED;  break;
+    case 2:  internal = GL_RG8;   format = GL_RG;   break;
+    case 3:  internal = GL_RGB8;  format = GL_RGB;  break;
+    default: internal = GL_RGBA8; format = GL_RGBA; break;
+    }
+}
+}
+
+void TextureLoader::Init(int workers, size_t uploadBudgetBytes) {
+    Shutdown();
+    InstallDefaultJpegKernels();   // 워커가 디코드를 시작하기 전에
+    budget_ = uploadBudgetBytes;
+    if (workers <= 0) workers = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    stop_ = false;
+    for (int i = 0; i < workers; ++i)
+        workers_.emplace_back(&TextureLoader::WorkerMain, this);
+}
+
+void TextureLoader::Shutdown() {
+    std::deque<Job> dropped;
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        stop_ = true;
+        dropped.swap(jobs_);
+    }
+    cv_.notify_all();
+    for (std::thread& t : workers_) t.join();
+    workers_.clear();
+    // 처리하지 못한 요청의 링 예약 반환 (링이 로더보다 오래 살 수 있음)
+    for (const Job& j : dropped) if (j.slice) ring_->Release(j.slice);
+    for (const Decoded& d : done_) if (d.slice) ring_->Release(d.slice);
+    done_.clear();
+    inFlight_ = 0;
+    queuedBytes_ = 0;
+    pending_.clear();
+    requestOf_.clear();
+    cancelled_.clear();
+    streamed_.clear();
+}
+
+GLuint TextureLoader::Load(const std::string& path, const TextureDesc& desc, FileView file) {
+    GlState& gl = GetGlState();
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    gl.BindTexture(kUploadUnit, GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, desc.wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, desc.wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc.magFilter);
+
+    // .gtex는 디코드할 것이 없으므로 바로 올림 (뒤집기/밉은 굽는 시점에 정해짐 → desc.flipY/mipmaps 무시)
+    if (IsCookedTexturePath(path)) {
+        ++stats_.requested;
+        auto t0 = std::chrono::steady_clock::now();
+        if (!file) file = GetVfs().Open(path);
+        CookedTextureInfo info;
+        if (file && UploadCookedTexture(file, ring_, &info)) {
+            ++stats_.uploaded;
+            stats_.bytesUploaded += info.bytes;
+            stats_.uploadMs += MsSince(t0);
+            if (onUpload_) onUpload_(tex, info.width, info.height);
+            return tex;
+        }
+        ++stats_.failed;
+        fprintf(stderr, "[TextureLoader] cooked texture failed: %s\n", path.c_str());
+        // 실패해도 아래 플레이스홀더는 올려 둠
+    }
+
+    // 1x1 회색 플레이스홀더 (1x1은 밉맵 체인이 레벨 0뿐이라 밉 필터여도 완전한 텍스처)
+    const unsigned char grey[4] = { 128, 128, 128, 255 };
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+
+    if (IsCookedTexturePath(path)) return tex;
+
+    Job job{ tex, ++nextRequest_, path, desc, std::move(file), {} };
+    job.stream = stream_;
+    // 스트리밍은 레벨 0 전체를 워커에 모아 두지 않음 → 밉은 마지막 밴드 뒤 glGenerateMipmap
+    job.cpuMips = desc.mipmaps && cpuMips_ && !job.stream;
+    if (ring_ && ring_->IsPersistent() && !job.stream) {
+        // 헤더만 읽어 크기를 알아내고 링 구간을 미리 잡아 둠 (자리가 없으면 일반 경로)
+        if (!job.file) job.file = GetVfs().Open(path);
+        if (job.file && stbi_info_from_memory(job.file.data(), (int)job.file.size(), &job.w, &job.h, &job.channels)) {
+            const size_t bytes = job.cpuMips ? MipChainBytes(job.w, job.h, job.channels, mipOptions_.maxLevels)
+                                             : (size_t)job.w * job.h * job.channels;
+            job.slice = ring_->Reserve(bytes);
+        }
+    }
+
+    ++stats_.requested;
+    pending_[job.request] = std::chrono::steady_clock::now();
+    requestOf_[tex] = job.request;
+    if (workers_.empty()) Init();
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        jobs_.push_back(std::move(job));
+        ++inFlight_;
+    }
+    cv_.notify_one();
+    return tex;
+}
+
+void TextureLoader::WorkerMain() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lk(m_);
+            cv_.wait(lk, [&] { return stop_ || !jobs_.empty(); });
+            if (stop_) return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        Decoded d;
+        d.tex = job.tex;
+        d.request = job.request;
+        d.stream = job.stream;
+        d.path = std::move(job.path);
+        d.desc = job.desc;
+        d.slice = job.slice;
+        if (FileView file = job.file ? job.file : GetVfs().Open(d.path)) {
+            // stb 할당은 이 워커의 아레나에서 (디코드가 끝나면 되감음). 출력은 항상 우리 버퍼로 받음
+            ImageArenaScope arena(ImageArenaEstimate(file.data(), file.size()));
+            if (job.stream) {
+                DecodeStreamed(file, d);
+            } else if (job.slice && !job.cpuMips) {
+                // PBO에 바로 디코드. 뒤집기는 행 순서로 처리 (별도 패스 없음)
+                d.ok = stbi_load_from_memory_into(file.data(), (int)file.size(), job.slice.ptr,
+                                                  job.w * job.channels, job.desc.flipY,
+                                                  &d.w, &d.h, &d.channels, job.channels) != 0;
+                d.channels = job.channels;
+                if (!d.ok) d.error = stbi_failure_reason();
+            } else if (stbi_info_from_memory(file.data(), (int)file.size(), &d.w, &d.h, &d.channels)) {
+                d.pixels = { (unsigned char*)std::malloc((size_t)d.w * d.h * d.channels), std::free };
+                d.ok = d.pixels && stbi_load_from_memory_into(file.data(), (int)file.size(), d.pixels.get(),
+                                                              d.w * d.channels, job.desc.flipY,
+                                                              &d.w, &d.h, &d.channels, d.channels) != 0;
+                if (!d.ok) {
+                    d.error = d.pixels ? stbi_failure_reason() : "out of memory";
+                    d.pixels.reset();
+                }
+            } else {
+                d.error = stbi_failure_reason();
+            }
+            d.stbAllocs = arena.Allocations();
+            d.stbHeapAllocs = arena.HeapAllocations();
+        } else {
+            d.error = "file not found";
+        }
+        d.decodeMs = MsSince(t0);
+        // 스트리밍이면 레벨 0은 이미 밴드로 보냄
+        d.bytes = job.stream ? 0 : (size_t)d.w * d.h * d.channels;
+
+        if (d.ok && job.cpuMips) {
+            // 워커 여러 개가 이미 병렬이므로 밉 생성 자체는 이 스레드에서만
+            auto t1 = std::chrono::steady_clock::now();
+            MipOptions mip = mipOptions_;
+            mip.threads = 1;
+            d.mips = BuildMipChain(d.pixels.get(), d.w, d.h, d.channels, mip);
+            for (const MipLevel& lv : d.mips) d.bytes += lv.pixels.size();
+            if (d.slice) {
+                // 레벨 0부터 이어 붙임 (GL 스레드는 오프셋만 넘김)
+                unsigned char* dst = d.slice.ptr;
+                std::memcpy(dst, d.pixels.get(), (size_t)d.w * d.h * d.channels);
+                dst += (size_t)d.w * d.h * d.channels;
+                for (MipLevel& lv : d.mips) {
+                    std::memcpy(dst, lv.pixels.data(), lv.pixels.size());
+                    dst += lv.pixels.size();
+                    std::vector<unsigned char>().swap(lv.pixels);
+                }
+                d.pixels.reset();
+            }
+            d.mipMs = MsSince(t1);
+        }
+
+        PushDone(std::move(d));
+    }
+}
+
+void TextureLoader::PushDone(Decoded&& d) {
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        queuedBytes_ += d.bytes;
+        peakQueuedBytes_ = std::max(peakQueuedBytes_, queuedBytes_);
+        done_.push_back(std::move(d));
+    }
+    doneCv_.notify_all();
+}
+
+// stb 행 콜백 → 밴드 항목. 레벨 0 전체는 어디에도 모으지 않음 (대기 중인 픽셀은 밴드 몇 개뿐)
+struct TextureLoader::BandSink {
+    TextureLoader* self;
+    Decoded* d;
+    int sent = 0;
+
+    static int Begin(void* user, int x, int y, int channelsInFile, int channels) {
+        BandSink* s = (BandSink*)user;
+        (void)channelsInFile;
+        s->d->w = x;
+        s->d->h = y;
+        s->d->channels = channels;
+        return 1;
+    }
+
+    static int Rows(void* user, const stbi_uc* data, int y0, int count) {
+        BandSink* s = (BandSink*)user;
+        const Decoded& d = *s->d;
+        const size_t stride = (size_t)d.w * d.channels;
+        Decoded band;
+        band.tex = d.tex;
+        band.request = d.request;
+        band.desc = d.desc;
+        band.w = d.w;
+        band.h = d.h;
+        band.channels = d.channels;
+        band.band = true;
+        band.first = s->sent++ == 0;
+        band.rows = count;
+        // 뒤집으면 파일의 위쪽 행이 GL의 위쪽(끝 행)으로 → 밴드 안의 행 순서도 거꾸로
+        band.y0 = d.desc.flipY ? d.h - y0 - count : y0;
+        band.rowData.resize(stride * count);
+        for (int r = 0; r < count; ++r) {
+            const int dst = d.desc.flipY ? count - 1 - r : r;
+            std::memcpy(band.rowData.data() + stride * dst, data + stride * r, stride);
+        }
+        band.bytes = band.rowData.size();
+        s->self->PushDone(std::move(band));
+        return 1;
+    }
+};
+
+void TextureLoader::DecodeStreamed(const FileView& file, Decoded& d) {
+    BandSink sink{ this, &d };
+    const stbi_row_callbacks cb = { BandSink::Begin, BandSink::Rows };
+    int w = 0, h = 0, c = 0;
+    d.ok = stbi_load_rows_from_memory(file.data(), (int)file.size(), &cb, &sink, bandRows_, &w, &h, &c, 0) != 0;
+    if (!d.ok) d.error = stbi_failure_reason();
+}
+
+void TextureLoader::Upload(const Decoded& d) {
+    GLint internal; GLenum format;
+    FormatsFor(d.channels, internal, format);
+    GetGlState().BindTexture(kUploadUnit, GL_TEXTURE_2D, d.tex);
+    // RGB 등은 행 길이가 4의 배수가 아닐 수 있음
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    const size_t bytes = (size_t)d.w * d.h * d.channels;
+    if (d.slice) {
+        ring_->TexImage2D(d.slice, 0, GL_TEXTURE_2D, 0, internal, d.w, d.h, format, GL_UNSIGNED_BYTE);
+        size_t at = bytes;
+        for (size_t i = 0; i < d.mips.size(); ++i) {
+            const MipLevel& lv = d.mips[i];
+            ring_->TexImage2D(d.slice, at, GL_TEXTURE_2D, (GLint)i + 1, internal, lv.width, lv.height, format, GL_UNSIGNED_BYTE);
+            at += (size_t)lv.width * lv.height * d.channels;
+        }
+        ring_->Commit(d.slice);
+    } else if (ring_) {
+        ring_->TexImage2D(GL_TEXTURE_2D, 0, internal, d.w, d.h, format, GL_UNSIGNED_BYTE, d.pixels.get(), bytes);
+        for (size_t i = 0; i < d.mips.size(); ++i)
+            ring_->TexImage2D(GL_TEXTURE_2D, (GLint)i + 1, internal, d.mips[i].width, d.mips[i].height, format,
+                              GL_UNSIGNED_BYTE, d.mips[i].pixels.data(), d.mips[i].pixels.size());
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, internal, d.w, d.h, 0, format, GL_UNSIGNED_BYTE, d.pixels.get());
+        for (size_t i = 0; i < d.mips.size(); ++i)
+            glTexImage2D(GL_TEXTURE_2D, (GLint)i + 1, internal, d.mips[i].width, d.mips[i].height, 0, format,
+                         GL_UNSIGNED_BYTE, d.mips[i].pixels.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (d.desc.mipmaps && d.mips.empty()) glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+void TextureLoader::UploadBand(const Decoded& d) {
+    GLint internal; GLenum format;
+    FormatsFor(d.channels, internal, format);
+    GetGlState().BindTexture(kUploadUnit, GL_TEXTURE_2D, d.tex);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (d.first) {
+        // 레벨 0 저장소만 잡고 밉이 올 때까지 MAX_LEVEL 0 (밉 필터여도 완전한 텍스처). 아직 안 온 행은 미정의
+        glTexImage2D(GL_TEXTURE_2D, 0, internal, d.w, d.h, 0, format, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    }
+    if (ring_)
+        ring_->TexSubImage2D(GL_TEXTURE_2D, 0, 0, d.y0, d.w, d.rows, format, GL_UNSIGNED_BYTE, d.rowData.data(), d.rowData.size());
+    else
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, d.y0, d.w, d.rows, format, GL_UNSIGNED_BYTE, d.rowData.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void TextureLoader::FinishStreamed(const Decoded& d) {
+    GLint internal; GLenum format;
+    FormatsFor(d.channels, internal, format);
+    GetGlState().BindTexture(kUploadUnit, GL_TEXTURE_2D, d.tex);
+    if (!d.ok) {
+        // 중간에 실패: 반쯤 채운 레벨 0 대신 플레이스홀더로 되돌림
+        const unsigned char grey[4] = { 128, 128, 128, 255 };
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+        return;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (size_t i = 0; i < d.mips.size(); ++i) {
+        const MipLevel& lv = d.mips[i];
+        if (ring_)
+            ring_->TexImage2D(GL_TEXTURE_2D, (GLint)i + 1, internal, lv.width, lv.height, format, GL_UNSIGNED_BYTE,
+                              lv.pixels.data(), lv.pixels.size());
+        else
+            glTexImage2D(GL_TEXTURE_2D, (GLint)i + 1, internal, lv.width, lv.height, 0, format, GL_UNSIGNED_BYTE, lv.pixels.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+    if (d.desc.mipmaps && d.mips.empty()) glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+void TextureLoader::NoteFirstPixel(uint64_t request) {
+    auto it = pending_.find(request);
+    if (it == pending_.end()) return;
+    const double ms = MsSince(it->second);
+    stats_.firstPixelMs += ms;
+    stats_.maxFirstPixelMs = std::max(stats_.maxFirstPixelMs, ms);
+}
+
+void TextureLoader::Update() {
+    auto t0 = std::chrono::steady_clock::now();
+    size_t spent = 0;
+    bool any = false;
+    for (;;) {
+        Decoded d;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            if (done_.empty()) break;
+            if (any && spent + done_.front().bytes > budget_) break;   // 나머지는 다음 프레임
+            d = std::move(done_.front());
+            done_.pop_front();
+            queuedBytes_ -= d.bytes;
+            stats_.peakQueuedBytes = peakQueuedBytes_;
+            if (!d.band) --inFlight_;
+        }
+        any = true;
+        if (d.band) {
+            if (cancelled_.count(d.request)) continue;
+            UploadBand(d);
+            if (d.first) {
+                streamed_.insert(d.request);
+                NoteFirstPixel(d.request);
+            }
+            spent += d.bytes;
+            stats_.bytesUploaded += d.bytes;
+            ++stats_.bandsUploaded;
+            continue;
+        }
+        const bool streamed = streamed_.erase(d.request) != 0;
+        if (!d.stream && d.ok && !cancelled_.count(d.request)) NoteFirstPixel(d.request);
+        pending_.erase(d.request);
+        auto owner = requestOf_.find(d.tex);
+        if (owner != requestOf_.end() && owner->second == d.request) requestOf_.erase(owner);
+        if (cancelled_.erase(d.request)) {
+            if (d.slice) ring_->Release(d.slice);
+            ++stats_.cancelled;
+            continue;
+        }
+        stats_.decodeMs += d.decodeMs;
+        stats_.stbAllocs += d.stbAllocs;
+        stats_.stbHeapAllocs += d.stbHeapAllocs;
+        stats_.mipMs += d.mipMs;
+        if (!d.ok) {
+            if (d.slice) ring_->Release(d.slice);
+            if (streamed) FinishStreamed(d);
+            ++stats_.failed;
+            fprintf(stderr, "[TextureLoader] decode failed: %s (%s)\n", d.path.c_str(), d.error ? d.error : "?");
+            continue;
+        }
+        if (d.stream && !streamed) {
+            // 밴드를 하나도 못 올린 스트리밍 요청: 레벨 0 픽셀이 없으므로 Upload()하지 않고 플레이스홀더 유지
+            ++stats_.failed;
+            fprintf(stderr, "[TextureLoader] streamed decode produced no rows: %s\n", d.path.c_str());
+            continue;
+        }
+        if (streamed) FinishStreamed(d);
+        else Upload(d);
+        spent += d.bytes;
+        stats_.bytesUploaded += d.bytes;
+        ++stats_.uploaded;
+        if (onUpload_) onUpload_(d.tex, d.w, d.h);
+    }
+    if (any) {
+        const double ms = MsSince(t0);
+        stats_.uploadMs += ms;
+        stats_.maxFrameUploadMs = std::max(stats_.maxFrameUploadMs, ms);
+    }
+}
+
+void TextureLoader::Flush() {
+    const size_t budget = budget_;
+    budget_ = ~size_t(0);
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lk(m_);
+            doneCv_.wait(lk, [&] { return !done_.empty() || inFlight_ == 0; });
+            if (done_.empty() && inFlight_ == 0) break;
+        }
+        Update();
+    }
+    budget_ = budget;
+}
+
+void TextureLoader::Cancel(GLuint tex) {
+    auto owner = requestOf_.find(tex);
+    if (owner == requestOf_.end()) return;
+    // 이 텍스처 이름과의 연결은 바로 끊음 (지운 뒤 같은 이름으로 새 Load()가 와도 섞이지 않게)
+    const uint64_t request = owner->second;
+    requestOf_.erase(owner);
+    std::lock_guard<std::mutex> lk(m_);
+    auto it = std::find_if(jobs_.begin(), jobs_.end(), [&](const Job& j) { return j.request == request; });
+    if (it != jobs_.end()) {
+        // 아직 워커가 집어 가지 않음 → 큐에서 바로 제거
+        if (it->slice) ring_->Release(it->slice);
+        jobs_.erase(it);
+        --inFlight_;
+        pending_.erase(request);
+        ++stats_.cancelled;
+        return;
+    }
+    cancelled_.insert(request);
+}
+
+size_t TextureLoader::Pending() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return inFlight_;
+}
+
+void TextureLoader::PrintStats(FILE* out) const {
+    fprintf(out, "[TextureLoader] workers=%zu requested=%u uploaded=%u failed=%u cancelled=%u | %zu bytes, decode %.2f ms + mips %.2f ms (workers, %s), upload %.2f ms (max %.2f ms/frame)\n",
+            workers_.size(), stats_.requested, stats_.uploaded, stats_.failed, stats_.cancelled, stats_.bytesUploaded,
+            stats_.decodeMs, stats_.mipMs, cpuMips_ && !stream_ ? MipKernelName(mipOptions_.kernel) : "gpu", stats_.uploadMs, stats_.maxFrameUploadMs);
+    const unsigned decodes = stats_.uploaded + stats_.failed;
+    fprintf(out, "  first pixel avg %.2f ms (max %.2f ms) | queued peak %zu bytes | %s | stb allocs %.1f/decode (heap %.2f)\n",
+            stats_.uploaded ? stats_.firstPixelMs / stats_.uploaded : 0.0, stats_.maxFirstPixelMs, stats_.peakQueuedBytes,
+            stream_ ? "streaming" : "whole images", decodes ? (double)stats_.stbAllocs / decodes : 0.0,
+            decodes ? (double)stats_.stbHeapAllocs / decodes : 0.0);
+    if (stream_) fprintf(out, "  %u bands of %d rows\n", stats_.bandsUploaded, bandRows_);
+}
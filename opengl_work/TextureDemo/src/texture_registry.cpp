@@ -0,0 +1,127 @@
+#include "texture_registry.h"
+#include "cooked_texture.h"
+#include "gl_state.h"
+#include "hash_util.h"
+#include "stb_image.h"
+#include "vfs.h"
+
+#include <chrono>
+#include <utility>
+
+namespace {
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// 구조체 패딩이 섞이지 않도록 필드별로 해시
+uint64_t HashDesc(const TextureDesc& d) {
+    const int32_t fields[] = { d.flipY, d.mipmaps, d.wrap, d.minFilter, d.magFilter };
+    return HashBytes(fields, sizeof(fields));
+}
+}
+
+TextureHandle::TextureHandle(const TextureHandle& o) : reg_(o.reg_), key_(o.key_), id_(o.id_) {
+    if (reg_) reg_->AddRef(key_);
+}
+
+TextureHandle::TextureHandle(TextureHandle&& o) noexcept : reg_(o.reg_), key_(o.key_), id_(o.id_) {
+    o.reg_ = nullptr; o.id_ = 0;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle o) noexcept {
+    std::swap(reg_, o.reg_);
+    std::swap(key_, o.key_);
+    std::swap(id_, o.id_);
+    return *this;
+}
+
+TextureHandle::~TextureHandle() {
+    if (reg_) reg_->Release(key_);
+}
+
+TextureRegistry::~TextureRegistry() {
+    for (auto& [key, e] : entries_) {
+        loader_.Cancel(e.tex);
+        GetGlState().ForgetTexture(e.tex);
+        glDeleteTextures(1, &e.tex);
+    }
+}
+
+TextureHandle TextureRegistry::Acquire(const std::string& path, const TextureDesc& desc) {
+    ++stats_.requests;
+    const uint64_t descHash = HashDesc(desc);
+    std::string pathKey = path;
+    pathKey.append(reinterpret_cast<const char*>(&descHash), sizeof(descHash));
+
+    auto p = byPath_.find(pathKey);
+    if (p != byPath_.end()) {
+        Entry& e = entries_[p->second];
+        ++e.refs;
+        ++stats_.pathHits;
+        stats_.savedBytes += e.bytes;
+        return TextureHandle(this, p->second, e.tex);
+    }
+
+    FileView file = GetVfs().Open(path);
+    if (!file) return {};
+    auto t0 = std::chrono::steady_clock::now();
+    const uint64_t key = HashBytesFast(file.data(), file.size(), descHash);
+    stats_.hashMs += MsSince(t0);
+
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        Entry& e = it->second;
+        ++e.refs;
+        ++stats_.contentHits;
+        stats_.savedBytes += e.bytes;
+        e.pathKeys.push_back(pathKey);
+        byPath_.emplace(std::move(pathKey), key);
+        return TextureHandle(this, key, e.tex);
+    }
+
+    // 업로드될 크기는 헤더만 보고 계산 (절약량 보고용)
+    size_t bytes = 0;
+    CookedTextureInfo cooked;
+    if (IsCookedTexturePath(path) && ReadCookedTextureInfo(file, &cooked)) {
+        bytes = cooked.bytes;
+    } else {
+        int w = 0, h = 0, c = 0;
+        stbi_info_from_memory(file.data(), (int)file.size(), &w, &h, &c);
+        bytes = (size_t)w * h * c;
+    }
+
+    Entry& e = entries_[key];
+    e.tex = loader_.Load(path, desc, std::move(file));
+    e.refs = 1;
+    e.bytes = bytes;
+    e.pathKeys.push_back(pathKey);
+    byPath_.emplace(std::move(pathKey), key);
+    ++stats_.loads;
+    stats_.liveBytes += e.bytes;
+    return TextureHandle(this, key, e.tex);
+}
+
+void TextureRegistry::AddRef(uint64_t key) {
+    auto it = entries_.find(key);
+    if (it != entries_.end()) ++it->second.refs;
+}
+
+void TextureRegistry::Release(uint64_t key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end() || --it->second.refs > 0) return;
+
+    Entry& e = it->second;
+    loader_.Cancel(e.tex);   // 아직 디코드/업로드 전이면 버리게 함
+    GetGlState().ForgetTexture(e.tex);
+    glDeleteTextures(1, &e.tex);
+    for (const std::string& k : e.pathKeys) byPath_.erase(k);
+    stats_.liveBytes -= e.bytes;
+    ++stats_.released;
+    entries_.erase(it);
+}
+
+void TextureRegistry::PrintStats(FILE* out) const {
+    fprintf(out, "[TextureRegistry] live=%zu (%zu bytes) requests=%u loads=%u shared: path=%u content=%u released=%u | saved %zu bytes, hash %.3f ms\n",
+            entries_.size(), stats_.liveBytes, stats_.requests, stats_.loads, stats_.pathHits, stats_.contentHits,
+            stats_.released, stats_.savedBytes, stats_.hashMs);
+}
@@ -0,0 +1,43 @@
+# 셰이더 파일 하나를 constexpr string_view 헤더로 변환 (cmake -P 로 실행)
+#   INPUT  : 원본 셰이더 경로
+#   OUTPUT : 생성할 헤더 경로
+#   SYMBOL : C++ 식별자 (예: textured_vert)
+file(READ "${INPUT}" content)
+
+string(FIND "${content}" "#include" inc_pos)
+if (inc_pos EQUAL -1)
+  set(has_include false)
+else()
+  set(has_include true)
+endif()
+
+# MSVC 문자열 리터럴 길이 제한(C2026)을 피하려고 8000자 단위로 나눠 이어 붙임
+string(LENGTH "${content}" len)
+set(chunks "")
+set(pos 0)
+while (pos LESS len)
+  string(SUBSTRING "${content}" ${pos} 8000 piece)
+  string(APPEND chunks "    R\"__GLSL__(${piece})__GLSL__\"\n")
+  math(EXPR pos "${pos} + 8000")
+endwhile()
+if (chunks STREQUAL "")
+  set(chunks "    \"\"\n")
+endif()
+
+file(WRITE "${OUTPUT}.tmp"
+"// 자동 생성 파일 (EmbedShaderFile.cmake) - 직접 수정하지 말 것
+#pragma once
+#include \"hash_util.h\"
+
+#include <string_view>
+
+namespace embedded_shaders {
+inline constexpr std::string_view ${SYMBOL} =
+${chunks};
+inline constexpr uint64_t ${SYMBOL}_hash = HashString(${SYMBOL});
+inline constexpr bool ${SYMBOL}_has_include = ${has_include};
+}
+")
+# 내용이 같으면 타임스탬프를 건드리지 않아 불필요한 재컴파일을 막음
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different "${OUTPUT}.tmp" "${OUTPUT}")
+file(REMOVE "${OUTPUT}.tmp")
@@ -0,0 +1,54 @@
+# ── 셰이더 임베드: shaders/ 의 GLSL을 빌드 시점에 C++ 헤더로 변환 ──
+# embed_shaders(<target> <shader_dir>)
+#   - 파일마다 constexpr string_view + 컴파일 타임 해시를 담은 헤더 생성
+#   - 런타임 경로("shaders/<상대경로>")로 찾을 수 있도록 등록 테이블 소스를 타깃에 추가
+set(EMBED_SHADER_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/EmbedShaderFile.cmake" CACHE INTERNAL "")
+
+function(embed_shaders target shader_dir)
+  file(GLOB_RECURSE shader_files CONFIGURE_DEPENDS
+       "${shader_dir}/*.vert" "${shader_dir}/*.frag" "${shader_dir}/*.glsl")
+  get_filename_component(dir_name "${shader_dir}" NAME)
+  # 셰이더가 없으면 등록 테이블을 만들지 않음 (빈 kShaders[]는 크기 0 배열이라 컴파일 실패). 런타임은 디스크에서 읽음
+  if(NOT shader_files)
+    message(STATUS "embed_shaders(${target}): no shaders in ${shader_dir}, nothing embedded")
+    return()
+  endif()
+  set(gen_dir "${CMAKE_CURRENT_BINARY_DIR}/embedded_shaders/${target}")
+
+  set(headers "")
+  set(includes "")
+  set(entries "")
+  foreach(src IN LISTS shader_files)
+    file(RELATIVE_PATH rel "${shader_dir}" "${src}")
+    string(MAKE_C_IDENTIFIER "${rel}" symbol)
+    set(out "${gen_dir}/${symbol}.h")
+    add_custom_command(
+      OUTPUT "${out}"
+      COMMAND ${CMAKE_COMMAND} -DINPUT=${src} -DOUTPUT=${out} -DSYMBOL=${symbol}
+              -P "${EMBED_SHADER_SCRIPT}"
+      DEPENDS "${src}" "${EMBED_SHADER_SCRIPT}"
+      COMMENT "Embedding shader ${dir_name}/${rel}"
+      VERBATIM)
+    list(APPEND headers "${out}")
+    string(APPEND includes "#include \"${symbol}.h\"\n")
+    string(APPEND entries "    { \"${dir_name}/${rel}\", ${symbol}, ${symbol}_hash, ${symbol}_has_include },\n")
+  endforeach()
+
+  set(registry "${gen_dir}/embedded_shader_table.cpp")
+  file(WRITE "${registry}.tmp"
+"// 자동 생성 파일 (EmbedShaders.cmake) - 직접 수정하지 말 것
+#include \"embedded_shaders.h\"
+${includes}
+namespace {
+using namespace embedded_shaders;
+const EmbeddedShader kShaders[] = {
+${entries}};
+// 정적 초기화 때 전역 테이블에 등록
+[[maybe_unused]] const bool kRegistered = (RegisterEmbeddedShaders(kShaders, sizeof(kShaders) / sizeof(kShaders[0])), true);
+}
+")
+  configure_file("${registry}.tmp" "${registry}" COPYONLY)
+
+  target_sources(${target} PRIVATE ${headers} "${registry}")
+  target_include_directories(${target} PRIVATE "${gen_dir}")
+endfunction()
@@ -0,0 +1,13 @@
+#pragma once
+// 실행 중인 CPU의 SIMD 지원 여부 (CPUID + OS가 YMM/ZMM 레지스터를 저장하는지 XGETBV로 확인)
+//  - 컴파일 플래그가 아니라 런타임 값 → AVX2 커널을 따로 빌드해 두고 여기서 골라 씀
+//  - x86이 아니면 전부 false
+struct CpuFeatures {
+    bool sse2 = false;
+    bool sse41 = false;
+    bool avx2 = false;      // AVX2 + FMA3 (둘 다 있어야 true)
+    bool avx512 = false;    // AVX-512 F + BW
+};
+
+// 처음 호출할 때 한 번만 조사 (스레드 안전)
+const CpuFeatures& GetCpuFeatures();
@@ -0,0 +1,27 @@
+#pragma once
+// 빌드 시 임베드된 셰이더 (cmake/EmbedShaders.cmake의 embed_shaders()가 테이블을 생성/등록)
+//  - 경로는 실행 파일 기준 상대 경로 그대로 ("shaders/textured.vert")
+//  - 소스는 실행 파일 안의 문자열 리터럴이므로 파일 I/O도, 복사도 없음
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+struct EmbeddedShader {
+    std::string_view path;
+    std::string_view source;   // 널 종료 리터럴을 가리킴
+    uint64_t hash;             // HashString(source), 컴파일 타임 계산
+    bool hasInclude;           // #include가 있으면 전처리가 필요
+};
+
+struct EmbeddedShaderStats {
+    unsigned lookups = 0;
+    unsigned hits = 0;
+};
+
+void RegisterEmbeddedShaders(const EmbeddedShader* table, size_t count);
+const EmbeddedShader* FindEmbeddedShader(std::string_view path);
+size_t EmbeddedShaderCount();
+
+const EmbeddedShaderStats& GetEmbeddedShaderStats();
+void PrintEmbeddedShaderStats(FILE* out);
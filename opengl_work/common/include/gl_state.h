@@ -0,0 +1,79 @@
+#pragma once
+// GL 상태 캐시: 마지막으로 설정한 값을 기억해 두고 같은 값이면 GL 호출을 생략
+//  - 프로그램, VAO, 텍스처 유닛별 바인딩, 유닛별 샘플러, 버퍼 바인딩(UBO 인덱스 포함), blend/depth, 뷰포트
+//  - 메인 컨텍스트 전용. 캐시를 거치지 않고 상태를 바꿨다면 Invalidate() 호출
+//  - 객체를 지우면 GL이 바인딩을 0으로 되돌리므로 Forget*()로 알려줄 것
+#include <glad/glad.h>
+
+#include <cstdio>
+
+struct GlStateStats {
+    unsigned issued = 0;  // 실제로 호출한 GL 함수 수
+    unsigned elided = 0;  // 같은 상태라서 생략한 호출 수
+};
+
+class GlState {
+public:
+    static constexpr int kMaxTextureUnits = 32;
+    static constexpr int kMaxUniformBindings = 16;
+
+    GlState() { Invalidate(); }
+
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vao);
+    // 유닛 번호는 0부터 (GL_TEXTURE0 + unit). glActiveTexture도 필요할 때만 호출
+    void BindTexture(int unit, GLenum target, GLuint texture);
+    // glBindSampler (유닛 선택 불필요). 0이면 텍스처 자체 파라미터로 돌아감
+    void BindSampler(int unit, GLuint sampler);
+    void BindBuffer(GLenum target, GLuint buffer);
+    void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+    void SetEnabled(GLenum cap, bool enabled);   // GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST
+    void BlendFunc(GLenum src, GLenum dst);
+    void DepthFunc(GLenum func);
+    void DepthMask(bool write);
+    void Viewport(GLint x, GLint y, GLsizei w, GLsizei h);
+
+    void ForgetProgram(GLuint program);
+    void ForgetVertexArray(GLuint vao);
+    void ForgetTexture(GLuint texture);
+    void ForgetSampler(GLuint sampler);
+    void ForgetBuffer(GLuint buffer);
+
+    // 모든 그림자 값을 "모름"으로 → 다음 호출은 무조건 발행
+    void Invalidate();
+
+    GLuint Program() const { return program_; }
+    const GlStateStats& Stats() const { return stats_; }
+    void ResetStats() { stats_ = {}; }
+    void PrintStats(FILE* out) const;
+
+private:
+    static constexpr GLuint kUnknown = ~0u;
+    enum TexTarget { kTex2D, kTex2DArray, kTex3D, kTexCube, kTexTargetCount };
+    enum BufTarget { kArray, kElement, kUniform, kPixelUnpack, kPixelPack, kCopyRead, kCopyWrite, kBufTargetCount };
+    enum Cap { kBlend, kDepthTest, kCullFace, kScissorTest, kCapCount };
+
+    static int TexIndex(GLenum target);
+    static int BufIndex(GLenum target);
+    static int CapIndex(GLenum cap);
+    void ActiveTexture(int unit);
+    bool Same(bool same) { same ? ++stats_.elided : ++stats_.issued; return same; }
+
+    GLuint program_;
+    GLuint vao_;
+    int activeUnit_;
+    GLuint textures_[kMaxTextureUnits][kTexTargetCount];
+    GLuint samplers_[kMaxTextureUnits];
+    GLuint buffers_[kBufTargetCount];
+    struct Range { GLuint buffer; GLintptr offset; GLsizeiptr size; };
+    Range uniformRanges_[kMaxUniformBindings];
+    int caps_[kCapCount];   // -1 = 모름
+    GLenum blendSrc_, blendDst_, depthFunc_;
+    int depthMask_;
+    GLint viewport_[4];
+    GlStateStats stats_;
+};
+
+// 메인 컨텍스트의 상태 캐시
+GlState& GetGlState();
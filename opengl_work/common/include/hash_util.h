@@ -0,0 +1,41 @@
+#pragma once
+// 64bit FNV-1a 해시 (constexpr: 컴파일 타임 키 생성에도 사용)
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+inline uint64_t HashBytes(const void* data, size_t len, uint64_t seed = kFnvOffset) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed;
+    for (size_t i = 0; i < len; ++i) { h ^= p[i]; h *= kFnvPrime; }
+    return h;
+}
+
+constexpr uint64_t HashString(std::string_view s, uint64_t seed = kFnvOffset) {
+    uint64_t h = seed;
+    for (char c : s) { h ^= (unsigned char)c; h *= kFnvPrime; }
+    return h;
+}
+
+// 큰 입력(파일 내용 등)용: 8바이트씩 곱셈/시프트로 섞음. FNV보다 훨씬 빠르지만 암호학적 용도는 아님
+inline uint64_t HashBytesFast(const void* data, size_t len, uint64_t seed = kFnvOffset) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed ^ (len * 0x9E3779B97F4A7C15ull);
+    for (; len >= 8; p += 8, len -= 8) {
+        uint64_t k;
+        std::memcpy(&k, p, 8);
+        k *= 0xBF58476D1CE4E5B9ull;
+        k ^= k >> 31;
+        h = (h ^ k) * 0x94D049BB133111EBull;
+        h ^= h >> 29;
+    }
+    h = HashBytes(p, len, h);
+    // 마지막에 한 번 더 섞어 하위 비트까지 고르게
+    h ^= h >> 33; h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ull;
+    return h ^ (h >> 33);
+}
@@ -0,0 +1,99 @@
+#pragma once
+// 텍스처 업로드용 PBO 링 (GL_PIXEL_UNPACK_BUFFER)
+//  - 픽셀을 링에 memcpy한 뒤 glTex(Sub)Image가 버퍼 오프셋에서 읽게 함
+//    → 드라이버가 클라이언트 메모리 복사를 기다리지 않고 바로 반환 (GPU가 나중에 가져감)
+//  - 업로드마다 펜스를 걸고, 링이 한 바퀴 돌아 그 구간을 다시 쓰기 전에 펜스를 확인
+//    (펜스 대기가 실패하면 구간을 회수하지 않고 버퍼 저장소를 새로 잡음)
+//  - glBufferStorage(4.4)가 있으면 persistent+coherent 매핑, 없으면 업로드마다 unsynchronized 매핑
+// 업로드 후 PIXEL_UNPACK 바인딩은 0으로 되돌림 (다른 코드의 클라이언트 포인터 업로드가 깨지지 않도록)
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+struct PixelUploadRingStats {
+    unsigned uploads = 0;
+    unsigned reserved = 0;    // Reserve()로 호출자가 직접 채운 업로드 (디코드 → PBO, 복사 없음)
+    unsigned stalls = 0;      // 재사용할 구간의 펜스가 아직 안 끝나서 기다린 횟수
+    unsigned direct = 0;      // 링에 자리가 없어(너무 크거나 예약이 막고 있어) 클라이언트 메모리에서 바로 올린 횟수
+    size_t   bytes = 0;
+    double   stallMs = 0.0;
+    unsigned orphans = 0;     // 펜스 대기가 실패해 저장소를 새로 잡은 횟수
+};
+
+class PixelUploadRing {
+public:
+    // Reserve()로 받은 구간. ptr은 다른 스레드에서 채워도 됨 (persistent 매핑일 때만 발급)
+    struct Slice {
+        unsigned char* ptr = nullptr;
+        GLuint buffer = 0;    // 예약한 버퍼 (그 사이 저장소를 새로 잡았으면 옛 버퍼)
+        GLintptr offset = 0;
+        size_t size = 0;
+        explicit operator bool() const { return ptr != nullptr; }
+    };
+
+    PixelUploadRing() = default;
+    ~PixelUploadRing() { Destroy(); }
+    PixelUploadRing(const PixelUploadRing&) = delete;
+    PixelUploadRing& operator=(const PixelUploadRing&) = delete;
+
+    bool Init(size_t ringBytes = 16u << 20);
+    void Destroy();
+
+    // 현재 바인드된 텍스처(target)의 level에 업로드. 레벨 전체를 새로 지정
+    void TexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei w, GLsizei h,
+                    GLenum format, GLenum type, const void* pixels, size_t bytes);
+    // 부분 업로드 (아틀라스/배열 레이어 등)
+    void TexSubImage2D(GLenum target, GLint level, GLint x, GLint y, GLsizei w, GLsizei h,
+                       GLenum format, GLenum type, const void* pixels, size_t bytes);
+    void TexSubImage3D(GLenum target, GLint level, GLint x, GLint y, GLint z, GLsizei w, GLsizei h, GLsizei d,
+                       GLenum format, GLenum type, const void* pixels, size_t bytes);
+
+    // 호출자가 직접 채울 구간 예약 (예: stbi_load_from_memory_into로 바로 디코드).
+    // persistent 매핑이 아니거나 아직 커밋 안 된 예약 때문에 자리가 없으면 빈 Slice (기다리지 않음)
+    Slice Reserve(size_t bytes);
+    // 채운 예약 구간에서 업로드하고 펜스를 검 (예약 순서와 달라도 됨)
+    void TexImage2D(const Slice& slice, GLenum target, GLint level, GLint internalFormat, GLsizei w, GLsizei h,
+                    GLenum format, GLenum type);
+    // 한 예약에 여러 레벨을 담았을 때: at 바이트 위치에서 업로드만 하고, 다 올린 뒤 Commit()으로 펜스
+    void TexImage2D(const Slice& slice, size_t at, GLenum target, GLint level, GLint internalFormat, GLsizei w, GLsizei h,
+                    GLenum format, GLenum type);
+    void Commit(const Slice& slice);
+    // 쓰지 않게 된 예약 반환 (디코드 실패 등)
+    void Release(const Slice& slice);
+
+    size_t Capacity() const { return size_; }
+    bool IsPersistent() const { return persistent_; }
+    const PixelUploadRingStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    // fence가 nullptr이면 아직 커밋되지 않은 예약
+    struct InFlight { GLsync fence; size_t begin, end; };
+    // Orphan()으로 물러난 persistent 버퍼. 남은 예약이 Commit/Release되면 지움
+    struct Retired { GLuint buffer; int reservations; };
+
+    // 링에서 n바이트 자리를 찾아 시작 오프셋 반환. 미커밋 예약을 기다려야 하면 -1
+    GLintptr Allocate(size_t n);
+    // bytes를 링에 복사하고 버퍼 오프셋 반환 (PBO는 바인드된 상태로 남음). 자리가 없으면 -1
+    GLintptr Stage(const void* pixels, size_t bytes);
+    // 오프셋의 구간에 펜스를 걸고 PBO 바인딩 해제
+    void Finish(GLintptr offset, size_t bytes);
+    bool WaitOldest();
+    void CreateBuffer();
+    void DeleteBuffer(GLuint buffer, bool mapped);
+    // 펜스 대기가 실패했을 때: 모든 펜스를 버리고 새 저장소로
+    void Orphan();
+    void RetireSlice(const Slice& slice);
+
+    GLuint buffer_ = 0;
+    unsigned char* mapped_ = nullptr;   // persistent 매핑 (아니면 nullptr)
+    bool persistent_ = false;
+    size_t size_ = 0;
+    size_t head_ = 0;
+    std::deque<InFlight> inFlight_;     // 오래된 것부터
+    std::vector<Retired> retired_;
+    PixelUploadRingStats stats_;
+};
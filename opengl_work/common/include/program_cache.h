@@ -0,0 +1,51 @@
+#pragma once
+// glGetProgramBinary / glProgramBinary 기반 디스크 프로그램 캐시
+//  - 키: vertex+fragment 소스 + GL_VENDOR/GL_RENDERER/GL_VERSION 의 64bit 해시
+//  - 드라이버가 바이너리를 거부하면(업데이트 등) 일반 컴파일로 폴백
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+struct ProgramCacheStats {
+    unsigned hits = 0;      // 바이너리 로드 성공
+    unsigned misses = 0;    // 캐시 파일 없음 또는 거부됨
+    unsigned rejects = 0;   // 파일은 있었지만 드라이버가 거부 (misses에도 포함)
+    unsigned stores = 0;    // 새로 기록한 바이너리 수
+    double   loadMs = 0.0;  // 캐시 적중 시 소요 시간 합계
+    double   buildMs = 0.0; // 캐시 미스 시 컴파일+링크 소요 시간 합계
+};
+
+class ProgramBinaryCache {
+public:
+    explicit ProgramBinaryCache(std::string dir = "shader_cache");
+
+    // 현재 컨텍스트가 프로그램 바이너리를 지원하는지 (GL 4.1 / ARB_get_program_binary)
+    bool IsSupported() const;
+
+    // 소스 + 드라이버 식별 문자열 해시. GL 컨텍스트가 current 여야 함
+    uint64_t MakeKey(const std::string& vs, const std::string& fs);
+    // 소스 해시를 이미 알고 있을 때 (임베드된 셰이더: 컴파일 타임 해시)
+    uint64_t MakeKey(uint64_t vsHash, uint64_t fsHash);
+
+    // 캐시에서 프로그램 로드. 없거나 거부되면 0
+    GLuint Load(uint64_t key);
+    // 링크된 프로그램의 바이너리를 기록 (GL_PROGRAM_BINARY_RETRIEVABLE_HINT 권장)
+    bool Store(uint64_t key, GLuint prog);
+
+    void AddBuildTime(double ms) { stats_.buildMs += ms; }
+    const ProgramCacheStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    std::string PathFor(uint64_t key) const;
+    const std::string& DriverId();
+
+    std::string dir_;
+    std::string driverId_;   // vendor|renderer|version (최초 MakeKey 때 채움)
+    ProgramCacheStats stats_;
+};
+
+// 프로세스 전역 캐시 (CreateShaderProgramFromFiles가 사용)
+ProgramBinaryCache& GetProgramCache();
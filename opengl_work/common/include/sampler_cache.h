@@ -0,0 +1,70 @@
+#pragma once
+// 샘플러 객체 캐시
+//  - wrap/필터/이방성/LOD 설정(SamplerDesc)마다 샘플러 객체를 하나만 만들어 재사용
+//  - Bind(unit, desc)는 glBindSampler만 (GlState가 같은 샘플러면 생략)
+//    → 필터를 전역으로 바꿔도 텍스처마다 바인드 + glTexParameteri 할 필요 없이 유닛 수만큼만 호출
+//  - 샘플러가 묶인 유닛에서는 텍스처 자체의 파라미터는 무시됨
+//  - 이방성은 GL 4.6 또는 GL_EXT/ARB_texture_filter_anisotropic이 있을 때만, 최대값으로 잘라서 키에 넣음
+// 메인 컨텍스트 전용. 컨텍스트를 닫기 전에 Clear() 호출
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <unordered_map>
+
+struct SamplerDesc {
+    GLint wrapS = GL_REPEAT, wrapT = GL_REPEAT, wrapR = GL_REPEAT;
+    GLint minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    GLint magFilter = GL_LINEAR;
+    float anisotropy = 1.0f;    // 1이면 끔
+    float minLod = -1000.0f, maxLod = 1000.0f;
+    float lodBias = 0.0f;
+
+    bool operator==(const SamplerDesc& o) const {
+        return wrapS == o.wrapS && wrapT == o.wrapT && wrapR == o.wrapR && minFilter == o.minFilter &&
+               magFilter == o.magFilter && anisotropy == o.anisotropy && minLod == o.minLod && maxLod == o.maxLod &&
+               lodBias == o.lodBias;
+    }
+};
+
+// 모든 축에 같은 wrap
+SamplerDesc MakeSamplerDesc(GLint wrap, GLint minFilter, GLint magFilter, float anisotropy = 1.0f);
+
+struct SamplerCacheStats {
+    unsigned lookups = 0;
+    unsigned created = 0;
+    unsigned binds = 0;       // Bind() 호출 수 (실제 glBindSampler 수는 GlState 통계)
+};
+
+class SamplerCache {
+public:
+    SamplerCache() = default;
+    ~SamplerCache() = default;   // GL 객체는 Clear()로 (컨텍스트가 사라진 뒤라 소멸자에서는 지우지 않음)
+    SamplerCache(const SamplerCache&) = delete;
+    SamplerCache& operator=(const SamplerCache&) = delete;
+
+    // desc에 맞는 샘플러 (없으면 만듦)
+    GLuint Get(const SamplerDesc& desc);
+    void Bind(int unit, const SamplerDesc& desc);
+    // 유닛을 텍스처 파라미터로 되돌림
+    void Unbind(int unit);
+    void Clear();
+
+    // 1이면 이방성 필터 미지원
+    float MaxAnisotropy();
+    size_t Count() const { return samplers_.size(); }
+    const SamplerCacheStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    struct DescHash {
+        size_t operator()(const SamplerDesc& d) const;
+    };
+
+    std::unordered_map<SamplerDesc, GLuint, DescHash> samplers_;
+    float maxAnisotropy_ = 0.0f;   // 0 = 아직 조회 안 함
+    SamplerCacheStats stats_;
+};
+
+// 메인 컨텍스트의 샘플러 캐시
+SamplerCache& GetSamplerCache();
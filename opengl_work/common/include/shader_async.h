@@ -0,0 +1,96 @@
+#pragma once
+// 비동기 셰이더 컴파일 파이프라인
+//  - GL_KHR_parallel_shader_compile 가 있으면 드라이버 내부 스레드에 맡기고 완료 여부만 폴링
+//  - 없으면 공유 컨텍스트를 가진 워커 스레드에서 컴파일/링크
+//  - 컴파일/링크 상태는 프로그램이 처음 바인드될 때(Id()) 한 번만 확인
+#include <glad/glad.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct GLFWwindow;
+class ShaderCompiler;
+
+// future 비슷한 프로그램 핸들
+class AsyncProgram {
+public:
+    // 완료될 때까지 기다린 뒤(필요하면) 상태를 확인하고 프로그램 이름 반환. 실패 시 0
+    GLuint Id();
+    // 블로킹 없이 완료 여부 확인
+    bool IsReady();
+    const std::string& Name() const { return name_; }
+
+private:
+    friend class ShaderCompiler;
+    enum class Mode { Cached, Parallel, Worker, Deferred };
+
+    ShaderCompiler* owner_ = nullptr;
+    Mode mode_ = Mode::Deferred;
+    std::string name_;
+    std::string vsSrc_, fsSrc_;   // 워커 모드에서만 사용
+    uint64_t cacheKey_ = 0;
+
+    GLuint prog_ = 0, vs_ = 0, fs_ = 0;
+    bool resolved_ = false;
+    bool ok_ = false;
+
+    // 워커 모드 동기화
+    std::mutex m_;
+    std::condition_variable cv_;
+    bool workerDone_ = false;
+    bool workerOk_ = false;
+    GLsync fence_ = nullptr;
+};
+
+using AsyncProgramPtr = std::shared_ptr<AsyncProgram>;
+
+struct AsyncCompileStats {
+    unsigned submitted = 0;
+    unsigned cacheHits = 0;    // 프로그램 바이너리 캐시에서 즉시 완료
+    unsigned parallel = 0;     // KHR_parallel_shader_compile 경로
+    unsigned worker = 0;       // 공유 컨텍스트 워커 경로
+    unsigned deferred = 0;     // 확장/워커 모두 없을 때: 즉시 제출, 상태 확인만 지연
+    unsigned failed = 0;
+    double   stallMs = 0.0;    // Id()에서 메인 스레드가 기다린 시간 합계
+};
+
+class ShaderCompiler {
+public:
+    ShaderCompiler() = default;
+    ~ShaderCompiler();
+    ShaderCompiler(const ShaderCompiler&) = delete;
+    ShaderCompiler& operator=(const ShaderCompiler&) = delete;
+
+    // mainWindow의 컨텍스트가 current 인 메인 스레드에서 호출
+    // useWorker=false 면 KHR 확장이 없을 때 Deferred 모드로 동작
+    void Init(GLFWwindow* mainWindow, bool useWorker = true);
+    void Shutdown();
+
+    AsyncProgramPtr CompileAsync(std::string vs, std::string fs, std::string name = "program");
+    AsyncProgramPtr CompileFilesAsync(const char* vsPath, const char* fsPath);
+
+    bool HasParallelCompile() const { return khrParallel_; }
+    const AsyncCompileStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    friend class AsyncProgram;
+    void WorkerLoop();
+    void Submit(const AsyncProgramPtr& p);
+    void Resolve(AsyncProgram& p);
+
+    bool khrParallel_ = false;
+    GLFWwindow* workerWindow_ = nullptr;
+    std::thread worker_;
+    std::mutex qm_;
+    std::condition_variable qcv_;
+    std::deque<AsyncProgramPtr> queue_;
+    bool quit_ = false;
+    AsyncCompileStats stats_;
+};
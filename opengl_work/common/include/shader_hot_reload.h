@@ -0,0 +1,97 @@
+#pragma once
+// 셰이더 핫 리로드
+//  - 감시 스레드가 inotify(리눅스) 또는 mtime 폴링(그 외)으로 변경을 감지하고 파일을 읽어 둠
+//  - 바뀐 파일을 #include 하는 프로그램만 다시 전처리(shader_preprocessor.h)
+//  - 컴파일은 ShaderCompiler(비동기)에 맡기고, 완료된 프로그램은 다음 프레임 Update()에서 교체
+//  - 컴파일이 실패하면 기존 프로그램을 그대로 유지
+#include <glad/glad.h>
+
+#include "shader_async.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct HotReloadStats {
+    unsigned reloads = 0;        // 교체 성공
+    unsigned failures = 0;       // 컴파일 실패 → 기존 프로그램 유지
+    double   lastLatencyMs = 0;  // 파일 변경 감지 → 교체까지
+    double   maxLatencyMs = 0;
+    double   sumLatencyMs = 0;
+    double   maxUpdateMs = 0;    // Update() 자체가 프레임에서 쓴 시간
+    double   sumUpdateMs = 0;
+    unsigned updates = 0;
+    double   avgFrameMs = 0;     // Update() 호출 간격의 지수 이동 평균
+    double   maxSwapFrameMs = 0; // 교체가 일어난 프레임의 간격 중 최댓값
+};
+
+class ShaderHotReloader {
+public:
+    using Clock = std::chrono::steady_clock;
+    // 교체 직후 호출 (샘플러 유닛 등 프로그램 상태 재설정용)
+    using ReloadCallback = std::function<void(int slot, GLuint program)>;
+
+    explicit ShaderHotReloader(ShaderCompiler& compiler) : compiler_(compiler) {}
+    ~ShaderHotReloader();
+    ShaderHotReloader(const ShaderHotReloader&) = delete;
+    ShaderHotReloader& operator=(const ShaderHotReloader&) = delete;
+
+    // 디렉터리 감시 시작 (여러 번 호출 가능, 첫 호출 때 감시 스레드 시작)
+    bool Watch(const std::string& dir);
+    void Stop();
+
+    // 프로그램 등록: 이후 Program(slot)이 최신 프로그램을 돌려줌
+    // defines: 셰이더 변형(shader_variants.h)이면 같은 define 목록으로 다시 전처리
+    int Register(const std::string& vsPath, const std::string& fsPath, GLuint program,
+                 std::vector<std::string> defines = {});
+    GLuint Program(int slot) const { return slots_[slot].program; }
+    void SetReloadCallback(ReloadCallback cb) { onReload_ = std::move(cb); }
+
+    // 프레임 시작 시 호출 (메인 스레드). 이번 프레임에 교체된 프로그램이 있으면 true
+    bool Update();
+
+    const HotReloadStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    struct Slot {
+        std::string vsPath, fsPath;
+        std::vector<std::string> defines;
+        GLuint program = 0;
+        AsyncProgramPtr pending;
+        Clock::time_point changedAt;   // 가장 이른 미처리 변경 시각
+        Clock::time_point pendingSince;// 컴파일 중인 변경의 감지 시각 (지연 시간 측정용)
+        bool dirty = false;            // 컴파일 중에 또 바뀜 → 끝나면 다시 제출
+    };
+    struct Change {
+        std::string source;
+        Clock::time_point when;
+    };
+
+    void WatchLoop();
+    void OnFileChanged(const std::string& path);
+    static std::string Normalize(const std::string& path);
+
+    ShaderCompiler& compiler_;
+    ReloadCallback onReload_;
+    std::vector<Slot> slots_;
+
+    // 감시 스레드 ↔ 메인 스레드 공유 상태
+    std::mutex m_;
+    std::vector<std::string> watchDirs_;
+    std::unordered_map<std::string, Change> changed_;   // 경로 → 새 내용
+    std::thread thread_;
+    std::atomic<bool> quit_{ false };
+    std::unordered_map<int, std::string> watchDescs_;    // inotify wd → 디렉터리
+    int inotifyFd_ = -1;
+
+    Clock::time_point lastUpdate_{};
+    bool swapFrame_ = false;   // 직전 Update()에서 교체가 있었음 → 이번 간격을 교체 프레임으로 기록
+    HotReloadStats stats_;
+};
@@ -0,0 +1,98 @@
+#pragma once
+// GLSL 전처리기
+//  - #include "파일" / <파일>, #pragma once, #define 주입, #version 끌어올리기
+//  - #line 지시문으로 원래 파일/줄 번호를 유지 (소스 문자열 번호 = PreprocessResult::files 인덱스)
+//  - 파일 파싱 결과와 최종 출력을 메모이즈하고, include 그래프로 변경 영향을 계산
+// 주의: 조건부 컴파일(#if/#ifdef)은 해석하지 않으므로 #if 0 안의 #include도 확장됨
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct PreprocessResult {
+    bool ok = false;
+    std::string source;               // glShaderSource에 넘길 최종 소스
+    std::vector<std::string> files;   // #line 소스 문자열 번호 → 파일 경로 (0 = 루트)
+    std::string error;
+};
+
+struct PreprocessStats {
+    unsigned processed = 0;   // 실제로 확장을 수행한 횟수
+    unsigned memoHits = 0;    // 출력 메모 적중
+    unsigned fileLoads = 0;   // 파일을 새로 읽고 파싱한 횟수
+    double   totalMs = 0.0;   // Process() 총 소요 시간
+};
+
+class ShaderPreprocessor {
+public:
+    // 파일 읽기 함수 (기본: ReadFile). 빈 문자열 = 열기 실패
+    using Loader = std::function<std::string(const std::string& path)>;
+
+    ShaderPreprocessor();
+
+    void SetLoader(Loader loader) { loader_ = std::move(loader); }
+    void AddIncludeDir(const std::string& dir);
+
+    // defines: "NAME" 또는 "NAME=VALUE" / "NAME VALUE"
+    PreprocessResult Process(const std::string& path, const std::vector<std::string>& defines = {});
+
+    // 파일 내용 변경 통지 (핫 리로드에서 이미 읽은 내용을 넘김).
+    // 해당 파일을 (직접/간접) 사용하는 루트 파일 목록을 반환
+    std::vector<std::string> UpdateFile(const std::string& path, std::string text);
+    // 내용 없이 무효화만 (다음 Process 때 다시 읽음)
+    std::vector<std::string> Invalidate(const std::string& path);
+
+    // 마지막 Process 기준으로 root가 사용하는 파일 집합 (root 자신 포함)
+    const std::unordered_set<std::string>* Dependencies(const std::string& root) const;
+
+    const PreprocessStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+    static std::string Normalize(const std::string& path);
+
+private:
+    struct Piece {
+        enum Kind { Text, Include } kind;
+        std::string text;     // Text: 줄바꿈 포함 본문 / Include: 지정된 경로
+        int line = 1;         // 이 조각이 시작하는 원본 줄 번호 (1부터)
+        bool angled = false;  // <...> 형식
+    };
+    struct FileNode {
+        bool loaded = false;
+        bool pragmaOnce = false;
+        std::string version;  // "#version ..." 줄 (없으면 빈 문자열)
+        std::vector<Piece> pieces;
+    };
+    struct ExpandState {
+        std::string out;
+        std::vector<std::string> files;
+        std::unordered_map<std::string, int> fileIndex;
+        std::unordered_set<std::string> onceDone;
+        std::vector<std::string> stack;
+        std::unordered_set<std::string> deps;
+        std::string error;
+    };
+
+    const FileNode* GetFile(const std::string& path);
+    static void Parse(const std::string& text, FileNode& node);
+    std::string Resolve(const std::string& from, const Piece& inc);
+    bool Expand(const std::string& path, ExpandState& st);
+    std::vector<std::string> AffectedRoots(const std::string& path);
+
+    Loader loader_;
+    std::vector<std::string> includeDirs_;
+    std::unordered_map<std::string, FileNode> files_;
+    struct Output {
+        std::string root;
+        PreprocessResult result;
+    };
+    std::unordered_map<std::string, Output> outputs_;                       // 루트+define 키 → 결과
+    std::unordered_map<std::string, std::unordered_set<std::string>> deps_; // 루트 → 사용 파일
+    PreprocessStats stats_;
+};
+
+// 프로세스 전역 전처리기 (CreateShaderProgramFromFiles, ShaderCompiler, 핫 리로드가 공유)
+ShaderPreprocessor& GetShaderPreprocessor();
@@ -0,0 +1,22 @@
+#pragma once
+// 셰이더 컴파일/링크 공용 헬퍼 (HelloTriangle, TextureDemo 공용)
+#include <glad/glad.h>
+
+#include <string>
+
+// 컴파일/링크 결과 확인: 실패하면 로그를 stderr로 출력하고 false 반환
+bool CheckShaderCompile(GLuint shader, const char* name);
+bool CheckProgramLink(GLuint prog);
+
+// 소스 문자열로부터 프로그램 생성 (실패해도 프로그램 이름은 반환됨)
+GLuint CreateShaderProgram(const char* vs, const char* fs);
+
+// 파일 전체를 문자열로 읽기 (vfs.h 경유, 실패 시 빈 문자열)
+std::string ReadFile(const char* path);
+
+// 전처리된 소스로 프로그램 생성. 디스크 프로그램 캐시(program_cache.h)를 먼저 확인하고
+// 미스면 컴파일 후 바이너리를 기록. 링크 실패 시 0
+GLuint CreateCachedProgram(const std::string& vsCode, const std::string& fsCode);
+
+// 파일 경로로부터 프로그램 생성. #include 전처리(shader_preprocessor.h) 후 CreateCachedProgram
+GLuint CreateShaderProgramFromFiles(const char* vsPath, const char* fsPath);
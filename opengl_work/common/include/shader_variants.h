@@ -0,0 +1,62 @@
+#pragma once
+// 셰이더 변형(permutation) 관리
+//  - 기본 vert/frag 한 쌍 + 기능 목록. 비트마스크의 i번째 비트가 켜지면 features[i]를 #define
+//  - 변형은 처음 Get() 될 때 컴파일(지연), 마스크를 키로 해시맵에 보관
+//  - Precompile()로 시작 시 "핫 셋"을 미리 제출 (ShaderCompiler가 있으면 비동기)
+#include <glad/glad.h>
+
+#include "shader_async.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ShaderVariantStats {
+    unsigned compiled = 0;    // 실제로 만든 변형 수 (캐시 적중 포함)
+    unsigned lookups = 0;
+    unsigned failed = 0;
+    double   compileMs = 0.0; // 변형 생성에 쓴 메인 스레드 시간 (제출 + Id() 확인/대기)
+    double   asyncMs = 0.0;   // 비동기 변형의 제출부터 Id() 확인까지 (백그라운드 컴파일/링크 포함)
+};
+
+class ShaderVariants {
+public:
+    ShaderVariants(std::string vsPath, std::string fsPath, std::vector<std::string> features);
+    ~ShaderVariants();
+    ShaderVariants(const ShaderVariants&) = delete;
+    ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+    // 이름 목록 → 마스크 (없는 이름은 경고 후 무시)
+    uint32_t Mask(std::initializer_list<const char*> names) const;
+    // 마스크 → 주입할 define 목록 (핫 리로드 등록용)
+    std::vector<std::string> Defines(uint32_t mask) const;
+
+    // 변형 프로그램 (없으면 지금 컴파일). 실패 시 0
+    GLuint Get(uint32_t mask);
+    // 핫 셋 미리 제출. compiler가 있으면 비동기, 결과는 Get()에서 확인
+    void Precompile(const std::vector<uint32_t>& hotSet, ShaderCompiler* compiler = nullptr);
+    // 외부(핫 리로드)에서 교체한 프로그램을 반영. 이전 프로그램은 호출자가 정리
+    void Replace(uint32_t mask, GLuint program);
+    // 모든 변형 삭제 (소스가 바뀌었을 때, 종료 시 컨텍스트가 살아 있을 때). 소멸자는 GL을 건드리지 않음
+    void Clear();
+
+    size_t Count() const { return variants_.size(); }
+    const ShaderVariantStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    struct Variant {
+        GLuint program = 0;
+        AsyncProgramPtr pending;
+        std::chrono::steady_clock::time_point submitted;   // Precompile() 제출 시각
+    };
+
+    std::string vsPath_, fsPath_;
+    std::vector<std::string> features_;
+    std::unordered_map<uint32_t, Variant> variants_;
+    ShaderVariantStats stats_;
+};
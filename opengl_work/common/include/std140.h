@@ -0,0 +1,75 @@
+#pragma once
+// std140 레이아웃 헬퍼
+//  - std140::Vec4, Mat4 ... : C++ 쪽 멤버 타입 (vec4 계열은 alignas(16))
+//  - std140::Layout<...>   : 멤버 타입 목록으로 std140 규칙의 오프셋/크기를 컴파일 타임에 계산
+//  - STD140_ASSERT_*        : 실제 C++ 구조체 오프셋과 비교해 static_assert
+// vec3 뒤에 스칼라가 오면 GLSL은 12바이트 뒤에 붙이지만 C++ 배치는 다를 수 있으므로
+// 반드시 ASSERT 매크로로 확인할 것
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace std140 {
+
+struct alignas(8) Vec2 { float x, y; };
+struct Vec3 { float x, y, z; };              // 크기 12, 정렬은 Layout/ASSERT가 검사
+struct alignas(16) Vec4 { float x, y, z, w; };
+struct alignas(16) IVec4 { int32_t x, y, z, w; };
+struct alignas(16) Mat3 { Vec4 col[3]; };    // 열 하나가 vec4 스트라이드
+struct alignas(16) Mat4 { float m[16]; };    // 열 우선 (glUniformMatrix4fv와 같은 순서)
+
+// 배열: 원소마다 16바이트 경계로 패딩
+template <typename T, size_t N>
+struct Array {
+    struct alignas(16) Elem { T v; };
+    Elem e[N];
+    T& operator[](size_t i) { return e[i].v; }
+    const T& operator[](size_t i) const { return e[i].v; }
+};
+
+// 타입별 std140 기준 정렬/크기
+template <typename T> struct Traits;
+template <> struct Traits<float>    { static constexpr size_t align = 4,  size = 4; };
+template <> struct Traits<int32_t>  { static constexpr size_t align = 4,  size = 4; };
+template <> struct Traits<uint32_t> { static constexpr size_t align = 4,  size = 4; };
+template <> struct Traits<Vec2>     { static constexpr size_t align = 8,  size = 8; };
+template <> struct Traits<Vec3>     { static constexpr size_t align = 16, size = 12; };
+template <> struct Traits<Vec4>     { static constexpr size_t align = 16, size = 16; };
+template <> struct Traits<IVec4>    { static constexpr size_t align = 16, size = 16; };
+template <> struct Traits<Mat3>     { static constexpr size_t align = 16, size = 48; };
+template <> struct Traits<Mat4>     { static constexpr size_t align = 16, size = 64; };
+template <typename T, size_t N>
+struct Traits<Array<T, N>> {
+    static constexpr size_t stride = (Traits<T>::size + 15) & ~size_t(15);
+    static constexpr size_t align = 16, size = stride * N;
+};
+
+constexpr size_t RoundUp(size_t v, size_t a) { return (v + a - 1) / a * a; }
+
+template <typename... Ts>
+struct Layout {
+    static constexpr size_t count = sizeof...(Ts);
+
+    // i번째 멤버의 std140 오프셋
+    static constexpr size_t Offset(size_t i) {
+        constexpr size_t aligns[] = { Traits<Ts>::align... };
+        constexpr size_t sizes[] = { Traits<Ts>::size... };
+        size_t off = 0;
+        for (size_t k = 0; k < count; ++k) {
+            off = RoundUp(off, aligns[k]);
+            if (k == i) return off;
+            off += sizes[k];
+        }
+        return off;
+    }
+    // 블록 전체 크기 (마지막 멤버 끝을 vec4 경계로 올림)
+    static constexpr size_t Size() { return RoundUp(Offset(count), 16); }
+};
+
+} // namespace std140
+
+#define STD140_ASSERT_MEMBER(Struct, LayoutT, index, member)                        \
+    static_assert(offsetof(Struct, member) == LayoutT::Offset(index),               \
+                  #Struct "::" #member " is not at its std140 offset")
+#define STD140_ASSERT_SIZE(Struct, LayoutT)                                         \
+    static_assert(sizeof(Struct) == LayoutT::Size(), #Struct " size does not match std140 block size")
@@ -0,0 +1,72 @@
+#pragma once
+// 프레임 단위 UBO 링 할당기
+//  - 버퍼를 framesInFlight 개의 구역으로 나누고, 매 프레임 한 구역에서 draw별 조각을 잘라 씀
+//  - 조각은 GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT에 맞춰 정렬, glBindBufferRange로 바인드
+//  - glBufferStorage(4.4)가 있으면 persistent+coherent 매핑, 없으면 프레임마다 unsynchronized 매핑
+//  - 구역 재사용 전에는 펜스로 GPU가 다 읽었는지 확인 (대기가 실패하면 버퍼 저장소를 새로 잡음)
+#include <glad/glad.h>
+
+#include "gl_state.h"
+
+#include <cstdio>
+#include <cstring>
+
+struct UniformRingStats {
+    unsigned allocations = 0;
+    unsigned overflows = 0;    // 구역이 꽉 차서 실패한 할당
+    unsigned stalls = 0;       // 펜스를 기다려야 했던 프레임
+    unsigned orphans = 0;      // 펜스 대기가 실패해 저장소를 새로 잡은 횟수
+    size_t   bytes = 0;        // 누적 할당 바이트 (정렬 패딩 포함)
+};
+
+class UniformRing {
+public:
+    struct Slice {
+        void* ptr = nullptr;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+        explicit operator bool() const { return ptr != nullptr; }
+    };
+
+    UniformRing() = default;
+    ~UniformRing() { Destroy(); }
+    UniformRing(const UniformRing&) = delete;
+    UniformRing& operator=(const UniformRing&) = delete;
+
+    bool Init(size_t bytesPerFrame, int framesInFlight = 3);
+    void Destroy();
+
+    // 프레임 시작/끝 (사이에서만 Alloc 가능)
+    void BeginFrame();
+    void EndFrame();
+
+    Slice Alloc(size_t size);
+    template <typename T>
+    Slice Push(const T& block) {
+        Slice s = Alloc(sizeof(T));
+        if (s) std::memcpy(s.ptr, &block, sizeof(T));
+        return s;
+    }
+    void Bind(GLuint binding, const Slice& s) const {
+        if (s) GetGlState().BindBufferRange(GL_UNIFORM_BUFFER, binding, buffer_, s.offset, s.size);
+    }
+
+    GLuint Buffer() const { return buffer_; }
+    bool IsPersistent() const { return persistent_; }
+    const UniformRingStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    void Orphan();
+
+    GLuint buffer_ = 0;
+    unsigned char* mapped_ = nullptr;   // persistent: 버퍼 전체 / 아니면 현재 구역
+    bool persistent_ = false;
+    size_t regionSize_ = 0;
+    int regions_ = 0;
+    int current_ = 0;
+    size_t head_ = 0;                   // 현재 구역 안의 다음 할당 위치
+    GLint align_ = 256;
+    GLsync fences_[8] = {};
+    UniformRingStats stats_;
+};
@@ -0,0 +1,70 @@
+#pragma once
+// 프로그램 리플렉션 기반 uniform 테이블
+//  - 링크 후 한 번 glGetActiveUniform으로 활성 uniform을 열거해 위치/타입을 기록
+//  - 이름은 컴파일 타임 해시 키("uMix"_u)로 찾으므로 렌더 루프에 문자열 조회가 없음
+//  - 마지막으로 올린 값을 기억해 같은 값이면 glUniform* 호출을 생략
+// Set* 호출 전에 해당 프로그램이 glUseProgram 되어 있어야 함
+#include <glad/glad.h>
+
+#include "hash_util.h"
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct UniformKey {
+    uint64_t hash;
+    std::string_view name;
+    constexpr explicit UniformKey(std::string_view n) : hash(HashString(n)), name(n) {}
+};
+
+constexpr UniformKey operator""_u(const char* s, size_t n) { return UniformKey(std::string_view(s, n)); }
+
+struct UniformTableStats {
+    unsigned uploads = 0;   // 실제로 호출한 glUniform*
+    unsigned skipped = 0;   // 값이 같아서 생략
+    unsigned missing = 0;   // 활성 uniform이 아님 (최적화로 제거되었거나 오타)
+};
+
+class UniformTable {
+public:
+    UniformTable() = default;
+    explicit UniformTable(GLuint program) { Reflect(program); }
+
+    // 프로그램이 바뀌면(핫 리로드 등) 다시 호출. 값 캐시도 초기화됨
+    void Reflect(GLuint program);
+    GLuint Program() const { return program_; }
+
+    GLint Location(UniformKey key) const;
+    bool Has(UniformKey key) const { return Find(key) != nullptr; }
+
+    void Set(UniformKey key, int v);
+    void Set(UniformKey key, float v);
+    void Set(UniformKey key, float x, float y);
+    void Set(UniformKey key, float x, float y, float z);
+    void Set(UniformKey key, float x, float y, float z, float w);
+    void SetMat4(UniformKey key, const float* m, bool transpose = false);
+
+    const UniformTableStats& Stats() const { return stats_; }
+    void PrintStats(FILE* out) const;
+
+private:
+    struct Entry {
+        uint64_t hash = 0;
+        GLint location = -1;
+        GLenum type = 0;
+        GLint size = 0;         // 배열 원소 수
+        bool valid = false;     // value에 유효한 값이 있음
+        float value[16] = {};   // 마지막 업로드 값 (mat4까지, int는 비트 그대로)
+        std::string name;
+    };
+
+    const Entry* Find(UniformKey key) const;
+    // 값이 바뀌었으면 캐시를 갱신하고 entry 반환, 같거나 없으면 nullptr
+    Entry* Dirty(UniformKey key, const void* data, size_t bytes);
+
+    GLuint program_ = 0;
+    std::vector<Entry> entries_;   // hash 기준 정렬 (이진 탐색)
+    UniformTableStats stats_;
+};
@@ -0,0 +1,88 @@
+#pragma once
+// 읽기 전용 가상 파일 시스템
+//  - 마운트 포인트: 디렉터리 또는 팩 아카이브(.pak)를 "assets/" 같은 접두사에 연결
+//  - Open()은 mmap(Windows: MapViewOfFile)된 구간을 그대로 돌려줌 → 복사 없음
+//  - 어느 마운트에도 해당하지 않는 경로는 디스크에서 직접 매핑
+// 나중에 마운트한 것이 먼저 검색됨 (패치 아카이브가 원본을 덮어쓰도록)
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// 매핑된 파일 하나. 마지막 FileView가 사라질 때 해제
+class MappedFile;
+
+// 읽기 전용 구간. 복사해도 매핑을 공유할 뿐 내용은 복사하지 않음
+class FileView {
+public:
+    FileView() = default;
+    FileView(std::shared_ptr<const MappedFile> owner, const unsigned char* data, size_t size)
+        : owner_(std::move(owner)), data_(data), size_(size) {}
+
+    explicit operator bool() const { return owner_ != nullptr; }
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::string_view str() const { return { reinterpret_cast<const char*>(data_), size_ }; }
+
+private:
+    std::shared_ptr<const MappedFile> owner_;
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+struct VfsFileStats {
+    unsigned opens = 0;
+    size_t   bytes = 0;      // 마지막으로 매핑한 크기
+    double   totalMs = 0.0;  // Open() 누적 시간
+    double   maxMs = 0.0;
+};
+
+struct VfsStats {
+    unsigned opens = 0;
+    unsigned failures = 0;
+    size_t   bytesMapped = 0;
+    double   openMs = 0.0;
+};
+
+class Vfs {
+public:
+    // prefix 아래 경로를 dir에서 찾음 (prefix 예: "assets/", 빈 문자열이면 모든 경로)
+    bool MountDirectory(std::string prefix, std::string dir);
+    // 팩 아카이브를 통째로 매핑해 두고 목차로 찾음
+    bool MountArchive(std::string prefix, const std::string& archivePath);
+    void UnmountAll();
+
+    // 실패 시 빈 FileView (stderr에 경로 출력)
+    FileView Open(std::string_view path);
+    bool Exists(std::string_view path);
+
+    // dir 아래의 모든 파일을 팩 아카이브 하나로 묶음 (목차 경로는 dir 기준 상대 경로)
+    static bool WriteArchive(const std::string& dir, const std::string& archivePath);
+
+    VfsStats Stats() const;
+    void PrintStats(FILE* out) const;
+
+private:
+    struct Entry { uint64_t offset, size; };
+    struct Mount {
+        std::string prefix;
+        std::string dir;                               // 디렉터리 마운트
+        std::shared_ptr<const MappedFile> archive;     // 아카이브 마운트
+        std::unordered_map<std::string, Entry> index;
+    };
+
+    FileView OpenLocked(const std::string& cleanPath);
+
+    mutable std::mutex mutex_;    // 핫 리로드 감시 스레드도 읽기 때문에 잠금
+    std::vector<Mount> mounts_;
+    VfsStats stats_;
+    std::unordered_map<std::string, VfsFileStats> files_;
+};
+
+// 프로세스 전역 VFS (셰이더 로더와 텍스처 로더가 함께 사용)
+Vfs& GetVfs();
@@ -0,0 +1,67 @@
+#include "cpu_features.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPU_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define CPU_X86 0
+#endif
+
+namespace {
+#if CPU_X86
+void Cpuid(int leaf, int sub, unsigned r[4]) {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, leaf, sub);
+    for (int i = 0; i < 4; ++i) r[i] = (unsigned)regs[i];
+#else
+    __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+#endif
+}
+
+unsigned long long Xgetbv() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+#endif
+
+CpuFeatures Detect() {
+    CpuFeatures f;
+#if CPU_X86
+    unsigned r[4];
+    Cpuid(0, 0, r);
+    const unsigned maxLeaf = r[0];
+    if (maxLeaf < 1) return f;
+    Cpuid(1, 0, r);
+    f.sse2 = (r[3] >> 26) & 1;
+    f.sse41 = (r[2] >> 19) & 1;
+    const bool fma = (r[2] >> 12) & 1;
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx = (r[2] >> 28) & 1;
+    // OS가 컨텍스트 전환 때 XMM/YMM(비트 1,2), opmask/ZMM(비트 5,6,7)을 저장해야 쓸 수 있음
+    const unsigned long long xcr0 = osxsave ? Xgetbv() : 0;
+    const bool ymm = (xcr0 & 0x6) == 0x6;
+    const bool zmm = (xcr0 & 0xE6) == 0xE6;
+    if (maxLeaf >= 7) {
+        Cpuid(7, 0, r);
+        f.avx2 = avx && fma && ymm && ((r[1] >> 5) & 1);
+        f.avx512 = f.avx2 && zmm && ((r[1] >> 16) & 1) && ((r[1] >> 30) & 1);
+    }
+#endif
+    return f;
+}
+}
+
+const CpuFeatures& GetCpuFeatures() {
+    static const CpuFeatures features = Detect();
+    return features;
+}
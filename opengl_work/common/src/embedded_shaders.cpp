@@ -0,0 +1,33 @@
+#include "embedded_shaders.h"
+
+#include <vector>
+
+namespace {
+// 정적 초기화 순서와 무관하도록 함수 안 static으로 둠
+std::vector<const EmbeddedShader*>& Table() {
+    static std::vector<const EmbeddedShader*> table;
+    return table;
+}
+EmbeddedShaderStats g_stats;
+}
+
+void RegisterEmbeddedShaders(const EmbeddedShader* table, size_t count) {
+    for (size_t i = 0; i < count; ++i) Table().push_back(&table[i]);
+}
+
+const EmbeddedShader* FindEmbeddedShader(std::string_view path) {
+    ++g_stats.lookups;
+    // 많아야 수십 개이므로 선형 탐색으로 충분
+    for (const EmbeddedShader* s : Table()) {
+        if (s->path == path) { ++g_stats.hits; return s; }
+    }
+    return nullptr;
+}
+
+size_t EmbeddedShaderCount() { return Table().size(); }
+
+const EmbeddedShaderStats& GetEmbeddedShaderStats() { return g_stats; }
+
+void PrintEmbeddedShaderStats(FILE* out) {
+    fprintf(out, "[EmbeddedShaders] registered=%zu lookups=%u hits=%u\n", Table().size(), g_stats.lookups, g_stats.hits);
+}
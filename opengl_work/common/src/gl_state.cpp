@@ -0,0 +1,187 @@
+#include "gl_state.h"
+
+int GlState::TexIndex(GLenum target) {
+    switch (target) {
+    case GL_TEXTURE_2D:       return kTex2D;
+    case GL_TEXTURE_2D_ARRAY: return kTex2DArray;
+    case GL_TEXTURE_3D:       return kTex3D;
+    case GL_TEXTURE_CUBE_MAP: return kTexCube;
+    default:                  return -1;
+    }
+}
+
+int GlState::BufIndex(GLenum target) {
+    switch (target) {
+    case GL_ARRAY_BUFFER:         return kArray;
+    case GL_ELEMENT_ARRAY_BUFFER: return kElement;
+    case GL_UNIFORM_BUFFER:       return kUniform;
+    case GL_PIXEL_UNPACK_BUFFER:  return kPixelUnpack;
+    case GL_PIXEL_PACK_BUFFER:    return kPixelPack;
+    case GL_COPY_READ_BUFFER:     return kCopyRead;
+    case GL_COPY_WRITE_BUFFER:    return kCopyWrite;
+    default:                      return -1;
+    }
+}
+
+int GlState::CapIndex(GLenum cap) {
+    switch (cap) {
+    case GL_BLEND:        return kBlend;
+    case GL_DEPTH_TEST:   return kDepthTest;
+    case GL_CULL_FACE:    return kCullFace;
+    case GL_SCISSOR_TEST: return kScissorTest;
+    default:              return -1;
+    }
+}
+
+void GlState::UseProgram(GLuint program) {
+    if (Same(program_ == program)) return;
+    glUseProgram(program);
+    program_ = program;
+}
+
+void GlState::BindVertexArray(GLuint vao) {
+    if (Same(vao_ == vao)) return;
+    glBindVertexArray(vao);
+    vao_ = vao;
+    // 인덱스 버퍼 바인딩은 VAO 상태라서 VAO가 바뀌면 알 수 없음
+    buffers_[kElement] = kUnknown;
+}
+
+void GlState::ActiveTexture(int unit) {
+    if (Same(activeUnit_ == unit)) return;
+    glActiveTexture(GL_TEXTURE0 + unit);
+    activeUnit_ = unit;
+}
+
+void GlState::BindTexture(int unit, GLenum target, GLuint texture) {
+    const int t = TexIndex(target);
+    if (t < 0 || unit < 0 || unit >= kMaxTextureUnits) {
+        ActiveTexture(unit);
+        ++stats_.issued;
+        glBindTexture(target, texture);
+        return;
+    }
+    if (textures_[unit][t] == texture) { ++stats_.elided; return; }
+    ActiveTexture(unit);
+    ++stats_.issued;
+    glBindTexture(target, texture);
+    textures_[unit][t] = texture;
+}
+
+void GlState::BindSampler(int unit, GLuint sampler) {
+    if (unit < 0 || unit >= kMaxTextureUnits) {
+        ++stats_.issued;
+        glBindSampler(unit, sampler);
+        return;
+    }
+    if (Same(samplers_[unit] == sampler)) return;
+    glBindSampler(unit, sampler);
+    samplers_[unit] = sampler;
+}
+
+void GlState::BindBuffer(GLenum target, GLuint buffer) {
+    const int b = BufIndex(target);
+    if (b >= 0 && Same(buffers_[b] == buffer)) return;
+    if (b < 0) ++stats_.issued;
+    glBindBuffer(target, buffer);
+    if (b >= 0) buffers_[b] = buffer;
+}
+
+void GlState::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    if (target == GL_UNIFORM_BUFFER && index < (GLuint)kMaxUniformBindings) {
+        Range& r = uniformRanges_[index];
+        if (Same(r.buffer == buffer && r.offset == offset && r.size == size)) return;
+        r = { buffer, offset, size };
+    } else {
+        ++stats_.issued;
+    }
+    glBindBufferRange(target, index, buffer, offset, size);
+    // 인덱스 바인딩은 일반 바인딩 지점도 함께 바꿈
+    const int b = BufIndex(target);
+    if (b >= 0) buffers_[b] = buffer;
+}
+
+void GlState::SetEnabled(GLenum cap, bool enabled) {
+    const int c = CapIndex(cap);
+    if (c >= 0 && Same(caps_[c] == (int)enabled)) return;
+    if (c < 0) ++stats_.issued;
+    enabled ? glEnable(cap) : glDisable(cap);
+    if (c >= 0) caps_[c] = enabled;
+}
+
+void GlState::BlendFunc(GLenum src, GLenum dst) {
+    if (Same(blendSrc_ == src && blendDst_ == dst)) return;
+    glBlendFunc(src, dst);
+    blendSrc_ = src; blendDst_ = dst;
+}
+
+void GlState::DepthFunc(GLenum func) {
+    if (Same(depthFunc_ == func)) return;
+    glDepthFunc(func);
+    depthFunc_ = func;
+}
+
+void GlState::DepthMask(bool write) {
+    if (Same(depthMask_ == (int)write)) return;
+    glDepthMask(write ? GL_TRUE : GL_FALSE);
+    depthMask_ = write;
+}
+
+void GlState::Viewport(GLint x, GLint y, GLsizei w, GLsizei h) {
+    if (Same(viewport_[0] == x && viewport_[1] == y && viewport_[2] == w && viewport_[3] == h)) return;
+    glViewport(x, y, w, h);
+    viewport_[0] = x; viewport_[1] = y; viewport_[2] = w; viewport_[3] = h;
+}
+
+void GlState::ForgetProgram(GLuint program) {
+    // 사용 중인 프로그램은 삭제돼도 바인딩이 유지되지만 이름이 재사용될 수 있으므로 모름으로
+    if (program_ == program) program_ = kUnknown;
+}
+
+void GlState::ForgetVertexArray(GLuint vao) {
+    if (vao_ == vao) { vao_ = 0; buffers_[kElement] = kUnknown; }
+}
+
+void GlState::ForgetTexture(GLuint texture) {
+    for (auto& unit : textures_)
+        for (GLuint& t : unit)
+            if (t == texture) t = 0;
+}
+
+void GlState::ForgetSampler(GLuint sampler) {
+    for (GLuint& s : samplers_)
+        if (s == sampler) s = 0;
+}
+
+void GlState::ForgetBuffer(GLuint buffer) {
+    for (GLuint& b : buffers_)
+        if (b == buffer) b = 0;
+    for (Range& r : uniformRanges_)
+        if (r.buffer == buffer) r = { 0, 0, 0 };
+}
+
+void GlState::Invalidate() {
+    program_ = kUnknown;
+    vao_ = kUnknown;
+    activeUnit_ = -1;
+    for (auto& unit : textures_)
+        for (GLuint& t : unit) t = kUnknown;
+    for (GLuint& s : samplers_) s = kUnknown;
+    for (GLuint& b : buffers_) b = kUnknown;
+    for (Range& r : uniformRanges_) r = { kUnknown, -1, -1 };
+    for (int& c : caps_) c = -1;
+    blendSrc_ = blendDst_ = depthFunc_ = kUnknown;
+    depthMask_ = -1;
+    viewport_[0] = viewport_[1] = viewport_[2] = viewport_[3] = -1;
+}
+
+void GlState::PrintStats(FILE* out) const {
+    const unsigned total = stats_.issued + stats_.elided;
+    fprintf(out, "[GlState] issued=%u elided=%u (%.1f%% elided)\n",
+            stats_.issued, stats_.elided, total ? 100.0 * stats_.elided / total : 0.0);
+}
+
+GlState& GetGlState() {
+    static GlState state;
+    return state;
+}
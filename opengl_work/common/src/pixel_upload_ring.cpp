@@ -0,0 +1,280 @@
+#include "pixel_upload_ring.h"
+#include "gl_state.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+const void* AsOffset(GLintptr offset) { return reinterpret_cast<const void*>(offset); }
+}
+
+bool PixelUploadRing::Init(size_t ringBytes) {
+    Destroy();
+    size_ = (ringBytes + 15) & ~size_t(15);
+    CreateBuffer();
+    return buffer_ != 0;
+}
+
+void PixelUploadRing::CreateBuffer() {
+    GlState& gl = GetGlState();
+    persistent_ = false;
+    glGenBuffers(1, &buffer_);
+    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_);
+    if (glBufferStorage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size_, nullptr, flags);
+        mapped_ = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)size_, flags));
+        persistent_ = mapped_ != nullptr;
+    }
+    if (!persistent_) {
+        // 4.4 미만(또는 매핑 실패): 일반 버퍼 + 업로드마다 해당 구간만 매핑
+        if (glBufferStorage) {
+            gl.ForgetBuffer(buffer_);
+            glDeleteBuffers(1, &buffer_);
+            glGenBuffers(1, &buffer_);
+            gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_);
+        }
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size_, nullptr, GL_STREAM_DRAW);
+        mapped_ = nullptr;
+    }
+    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    head_ = 0;
+}
+
+void PixelUploadRing::DeleteBuffer(GLuint buffer, bool mapped) {
+    GlState& gl = GetGlState();
+    if (mapped) {
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    gl.ForgetBuffer(buffer);
+    glDeleteBuffers(1, &buffer);
+}
+
+void PixelUploadRing::Orphan() {
+    ++stats_.orphans;
+    int reservations = 0;
+    for (InFlight& f : inFlight_) {
+        if (f.fence) glDeleteSync(f.fence);
+        else ++reservations;
+    }
+    inFlight_.clear();
+    head_ = 0;
+    if (!persistent_) {
+        // 업로드마다 매핑하는 버퍼는 저장소만 새로 (예약은 persistent일 때만 있음)
+        GetGlState().BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size_, nullptr, GL_STREAM_DRAW);
+        GetGlState().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return;
+    }
+    // 불변 저장소는 다시 지정할 수 없으므로 버퍼를 새로 만듦. 워커가 아직 채우는 예약이 있으면
+    // 옛 버퍼는 매핑을 유지한 채 Commit/Release될 때까지 남겨 둠 (옛 버퍼에서 올리고 지움)
+    if (reservations) retired_.push_back({ buffer_, reservations });
+    else DeleteBuffer(buffer_, true);
+    buffer_ = 0;
+    mapped_ = nullptr;
+    CreateBuffer();
+}
+
+void PixelUploadRing::RetireSlice(const Slice& slice) {
+    for (auto it = retired_.begin(); it != retired_.end(); ++it) {
+        if (it->buffer != slice.buffer) continue;
+        if (--it->reservations == 0) {
+            DeleteBuffer(it->buffer, true);
+            retired_.erase(it);
+        }
+        return;
+    }
+}
+
+void PixelUploadRing::Destroy() {
+    for (InFlight& f : inFlight_) glDeleteSync(f.fence);
+    inFlight_.clear();
+    for (const Retired& r : retired_) DeleteBuffer(r.buffer, true);
+    retired_.clear();
+    if (buffer_) DeleteBuffer(buffer_, persistent_);
+    buffer_ = 0; mapped_ = nullptr; persistent_ = false; size_ = 0;
+}
+
+bool PixelUploadRing::WaitOldest() {
+    if (!inFlight_.front().fence) return false;   // 아직 채우는 중인 예약은 기다릴 수 없음
+    GLsync fence = inFlight_.front().fence;
+    GLenum r = glClientWaitSync(fence, 0, 0);
+    if (r == GL_TIMEOUT_EXPIRED) {
+        ++stats_.stalls;
+        auto t0 = std::chrono::steady_clock::now();
+        do {
+            r = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000000));
+        } while (r == GL_TIMEOUT_EXPIRED);
+        stats_.stallMs += MsSince(t0);
+    }
+    // 대기 실패: GPU가 다 읽었는지 모르므로 회수하지 않고 저장소를 새로 잡음 (링 전체가 비게 됨)
+    if (r == GL_WAIT_FAILED) {
+        Orphan();
+        return true;
+    }
+    glDeleteSync(fence);
+    inFlight_.pop_front();
+    return true;
+}
+
+GLintptr PixelUploadRing::Allocate(size_t n) {
+    if (!buffer_ || n > size_) return -1;
+
+    // 이미 끝난 업로드는 기다림 없이 정리
+    while (!inFlight_.empty() && inFlight_.front().fence) {
+        const GLenum r = glClientWaitSync(inFlight_.front().fence, 0, 0);
+        if (r == GL_TIMEOUT_EXPIRED) break;
+        if (r == GL_WAIT_FAILED) { Orphan(); break; }
+        glDeleteSync(inFlight_.front().fence);
+        inFlight_.pop_front();
+    }
+
+    size_t begin;
+    for (;;) {
+        // 끝까지 자리가 없으면 처음으로 돌아감 (남은 꼬리는 버림)
+        begin = (head_ + n <= size_) ? head_ : 0;
+        bool overlaps = false;
+        for (const InFlight& f : inFlight_) {
+            if (begin < f.end && f.begin < begin + n) { overlaps = true; break; }
+        }
+        if (!overlaps) break;
+        if (!WaitOldest()) return -1;
+    }
+    return (GLintptr)begin;
+}
+
+GLintptr PixelUploadRing::Stage(const void* pixels, size_t bytes) {
+    const size_t n = (bytes + 15) & ~size_t(15);
+    const GLintptr off = Allocate(n);
+    if (off < 0) return -1;
+    const size_t begin = (size_t)off;
+
+    GetGlState().BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_);
+    if (persistent_) {
+        std::memcpy(mapped_ + begin, pixels, bytes);
+    } else {
+        // 펜스로 이미 동기화했으므로 드라이버의 암묵적 동기화는 생략
+        void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, (GLintptr)begin, (GLsizeiptr)n,
+                                     GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        if (!dst) { GetGlState().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); return -1; }
+        std::memcpy(dst, pixels, bytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    return (GLintptr)begin;
+}
+
+void PixelUploadRing::Finish(GLintptr offset, size_t bytes) {
+    const size_t begin = (size_t)offset;
+    const size_t end = begin + ((bytes + 15) & ~size_t(15));
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    auto it = std::find_if(inFlight_.begin(), inFlight_.end(), [&](const InFlight& f) { return !f.fence && f.begin == begin; });
+    if (it != inFlight_.end()) {
+        it->fence = fence;   // 예약 커밋
+    } else {
+        inFlight_.push_back({ fence, begin, end });
+        head_ = end;
+    }
+    GetGlState().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    ++stats_.uploads;
+    stats_.bytes += bytes;
+}
+
+PixelUploadRing::Slice PixelUploadRing::Reserve(size_t bytes) {
+    Slice s;
+    if (!persistent_) return s;
+    const size_t n = (bytes + 15) & ~size_t(15);
+    const GLintptr off = Allocate(n);
+    if (off < 0) return s;
+    inFlight_.push_back({ nullptr, (size_t)off, (size_t)off + n });
+    head_ = (size_t)off + n;
+    s.ptr = mapped_ + off;
+    s.buffer = buffer_;
+    s.offset = off;
+    s.size = bytes;
+    return s;
+}
+
+void PixelUploadRing::TexImage2D(const Slice& slice, GLenum target, GLint level, GLint internalFormat,
+                                 GLsizei w, GLsizei h, GLenum format, GLenum type) {
+    TexImage2D(slice, 0, target, level, internalFormat, w, h, format, type);
+    Commit(slice);
+}
+
+void PixelUploadRing::TexImage2D(const Slice& slice, size_t at, GLenum target, GLint level, GLint internalFormat,
+                                 GLsizei w, GLsizei h, GLenum format, GLenum type) {
+    GetGlState().BindBuffer(GL_PIXEL_UNPACK_BUFFER, slice.buffer);
+    glTexImage2D(target, level, internalFormat, w, h, 0, format, type, AsOffset(slice.offset + (GLintptr)at));
+}
+
+void PixelUploadRing::Commit(const Slice& slice) {
+    ++stats_.reserved;
+    if (slice.buffer != buffer_) {
+        // Orphan() 전에 예약한 구간: 옛 버퍼에서 이미 올렸으므로 펜스 대신 옛 버퍼 정리만
+        GetGlState().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        ++stats_.uploads;
+        stats_.bytes += slice.size;
+        RetireSlice(slice);
+        return;
+    }
+    Finish(slice.offset, slice.size);
+}
+
+void PixelUploadRing::Release(const Slice& slice) {
+    if (slice.buffer != buffer_) { RetireSlice(slice); return; }
+    // GPU가 읽지 않으므로 바로 끝나는 펜스로 표시 → 다음 정리 때 회수
+    for (InFlight& f : inFlight_) {
+        if (!f.fence && f.begin == (size_t)slice.offset) {
+            f.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            break;
+        }
+    }
+}
+
+void PixelUploadRing::TexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei w, GLsizei h,
+                                 GLenum format, GLenum type, const void* pixels, size_t bytes) {
+    const GLintptr off = Stage(pixels, bytes);
+    if (off < 0) {
+        ++stats_.direct;
+        glTexImage2D(target, level, internalFormat, w, h, 0, format, type, pixels);
+        return;
+    }
+    glTexImage2D(target, level, internalFormat, w, h, 0, format, type, AsOffset(off));
+    Finish(off, bytes);
+}
+
+void PixelUploadRing::TexSubImage2D(GLenum target, GLint level, GLint x, GLint y, GLsizei w, GLsizei h,
+                                    GLenum format, GLenum type, const void* pixels, size_t bytes) {
+    const GLintptr off = Stage(pixels, bytes);
+    if (off < 0) {
+        ++stats_.direct;
+        glTexSubImage2D(target, level, x, y, w, h, format, type, pixels);
+        return;
+    }
+    glTexSubImage2D(target, level, x, y, w, h, format, type, AsOffset(off));
+    Finish(off, bytes);
+}
+
+void PixelUploadRing::TexSubImage3D(GLenum target, GLint level, GLint x, GLint y, GLint z, GLsizei w, GLsizei h, GLsizei d,
+                                    GLenum format, GLenum type, const void* pixels, size_t bytes) {
+    const GLintptr off = Stage(pixels, bytes);
+    if (off < 0) {
+        ++stats_.direct;
+        glTexSubImage3D(target, level, x, y, z, w, h, d, format, type, pixels);
+        return;
+    }
+    glTexSubImage3D(target, level, x, y, z, w, h, d, format, type, AsOffset(off));
+    Finish(off, bytes);
+}
+
+void PixelUploadRing::PrintStats(FILE* out) const {
+    fprintf(out, "[PixelUploadRing] %s, %zu bytes | uploads=%u (in-place %u) bytes=%zu direct=%u stalls=%u (%.2f ms) orphans=%u\n",
+            persistent_ ? "persistent" : "map-per-upload", size_, stats_.uploads, stats_.reserved, stats_.bytes,
+            stats_.direct, stats_.stalls, stats_.stallMs, stats_.orphans);
+}
@@ -0,0 +1,142 @@
+#include "program_cache.h"
+#include "hash_util.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+// 캐시 파일 헤더: magic, 버전, binaryFormat, 길이, 키 (키 충돌/파일 손상 검증용)
+constexpr uint32_t kMagic = 0x42504C47; // "GLPB"
+constexpr uint32_t kVersion = 1;
+
+struct CacheFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;
+    uint32_t length;
+    uint64_t key;
+};
+
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+const char* GlString(GLenum name) {
+    const GLubyte* s = glGetString(name);
+    return s ? reinterpret_cast<const char*>(s) : "";
+}
+}
+
+ProgramBinaryCache::ProgramBinaryCache(std::string dir) : dir_(std::move(dir)) {}
+
+bool ProgramBinaryCache::IsSupported() const {
+    if (!glGetProgramBinary || !glProgramBinary) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+const std::string& ProgramBinaryCache::DriverId() {
+    if (driverId_.empty()) {
+        driverId_ = std::string(GlString(GL_VENDOR)) + "|" + GlString(GL_RENDERER) + "|" + GlString(GL_VERSION);
+    }
+    return driverId_;
+}
+
+uint64_t ProgramBinaryCache::MakeKey(uint64_t vsHash, uint64_t fsHash) {
+    const std::string& id = DriverId();
+    uint64_t h = HashBytes(&vsHash, sizeof(vsHash));
+    h = HashBytes(&fsHash, sizeof(fsHash), h);
+    return HashBytes(id.data(), id.size(), h);
+}
+
+uint64_t ProgramBinaryCache::MakeKey(const std::string& vs, const std::string& fs) {
+    const std::string& id = DriverId();
+    // 경계가 섞이지 않도록 각 구간 사이에 구분자('\0')를 넣어 해시
+    const char sep = '\0';
+    uint64_t h = HashBytes(vs.data(), vs.size());
+    h = HashBytes(&sep, 1, h);
+    h = HashBytes(fs.data(), fs.size(), h);
+    h = HashBytes(&sep, 1, h);
+    return HashBytes(id.data(), id.size(), h);
+}
+
+std::string ProgramBinaryCache::PathFor(uint64_t key) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return dir_ + "/" + name;
+}
+
+GLuint ProgramBinaryCache::Load(uint64_t key) {
+    auto t0 = std::chrono::steady_clock::now();
+    if (!IsSupported()) { ++stats_.misses; return 0; }
+
+    std::ifstream f(PathFor(key), std::ios::binary);
+    if (!f) { ++stats_.misses; return 0; }
+
+    CacheFileHeader hdr{};
+    f.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
+    if (!f || hdr.magic != kMagic || hdr.version != kVersion || hdr.key != key || hdr.length == 0) {
+        ++stats_.rejects; ++stats_.misses;
+        return 0;
+    }
+    std::vector<char> blob(hdr.length);
+    f.read(blob.data(), hdr.length);
+    if (!f) { ++stats_.rejects; ++stats_.misses; return 0; }
+
+    GLuint p = glCreateProgram();
+    glProgramBinary(p, hdr.format, blob.data(), (GLsizei)hdr.length);
+    GLint linked = 0; glGetProgramiv(p, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // 드라이버 업데이트 등으로 바이너리가 무효화됨 → 호출자가 다시 컴파일
+        glDeleteProgram(p);
+        ++stats_.rejects; ++stats_.misses;
+        return 0;
+    }
+    ++stats_.hits;
+    stats_.loadMs += MsSince(t0);
+    return p;
+}
+
+bool ProgramBinaryCache::Store(uint64_t key, GLuint prog) {
+    if (!IsSupported()) return false;
+
+    GLint len = 0; glGetProgramiv(prog, GL_PROGRAM_BINARY_LENGTH, &len);
+    if (len <= 0) return false;
+    std::vector<char> blob(len);
+    GLenum format = 0;
+    glGetProgramBinary(prog, len, &len, &format, blob.data());
+    if (len <= 0) return false;
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+
+    // 임시 파일에 쓴 뒤 rename: 도중에 죽어도 반쯤 쓰인 캐시가 남지 않음
+    const std::string path = PathFor(key);
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) return false;
+        CacheFileHeader hdr{ kMagic, kVersion, (uint32_t)format, (uint32_t)len, key };
+        f.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        f.write(blob.data(), len);
+        if (!f) return false;
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) { std::filesystem::remove(tmp, ec); return false; }
+    ++stats_.stores;
+    return true;
+}
+
+void ProgramBinaryCache::PrintStats(FILE* out) const {
+    fprintf(out, "[ProgramCache] hits=%u misses=%u (rejected=%u) stored=%u | load %.2f ms, build %.2f ms\n",
+            stats_.hits, stats_.misses, stats_.rejects, stats_.stores, stats_.loadMs, stats_.buildMs);
+}
+
+ProgramBinaryCache& GetProgramCache() {
+    static ProgramBinaryCache cache;
+    return cache;
+}
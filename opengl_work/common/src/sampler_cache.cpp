@@ -0,0 +1,106 @@
+#include "sampler_cache.h"
+#include "gl_state.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+bool HasExtension(const char* name) {
+    GLint n = 0; glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+    for (GLint i = 0; i < n; ++i) {
+        const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (ext && std::strcmp(ext, name) == 0) return true;
+    }
+    return false;
+}
+
+uint32_t Bits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+}
+
+SamplerDesc MakeSamplerDesc(GLint wrap, GLint minFilter, GLint magFilter, float anisotropy) {
+    SamplerDesc d;
+    d.wrapS = d.wrapT = d.wrapR = wrap;
+    d.minFilter = minFilter;
+    d.magFilter = magFilter;
+    d.anisotropy = anisotropy;
+    return d;
+}
+
+size_t SamplerCache::DescHash::operator()(const SamplerDesc& d) const {
+    // FNV-1a (필드 9개)
+    const uint32_t v[] = { (uint32_t)d.wrapS, (uint32_t)d.wrapT, (uint32_t)d.wrapR, (uint32_t)d.minFilter,
+                           (uint32_t)d.magFilter, Bits(d.anisotropy), Bits(d.minLod), Bits(d.maxLod), Bits(d.lodBias) };
+    uint64_t h = 1469598103934665603ull;
+    for (uint32_t x : v) { h ^= x; h *= 1099511628211ull; }
+    return (size_t)h;
+}
+
+float SamplerCache::MaxAnisotropy() {
+    if (maxAnisotropy_ == 0.0f) {
+        maxAnisotropy_ = 1.0f;
+        // GL_TEXTURE_MAX_ANISOTROPY(_EXT)는 코어와 확장에서 같은 값
+        if (GLAD_GL_VERSION_4_6 || HasExtension("GL_EXT_texture_filter_anisotropic") ||
+            HasExtension("GL_ARB_texture_filter_anisotropic")) {
+            GLfloat m = 1.0f;
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &m);
+            maxAnisotropy_ = std::max(1.0f, m);
+        }
+    }
+    return maxAnisotropy_;
+}
+
+GLuint SamplerCache::Get(const SamplerDesc& desc) {
+    ++stats_.lookups;
+    // 지원 범위로 잘라서 키로 씀 (16을 요청하든 32를 요청하든 최대가 8이면 같은 샘플러)
+    SamplerDesc key = desc;
+    key.anisotropy = std::min(std::max(1.0f, desc.anisotropy), MaxAnisotropy());
+    auto it = samplers_.find(key);
+    if (it != samplers_.end()) return it->second;
+
+    GLuint s = 0;
+    glGenSamplers(1, &s);
+    glSamplerParameteri(s, GL_TEXTURE_WRAP_S, key.wrapS);
+    glSamplerParameteri(s, GL_TEXTURE_WRAP_T, key.wrapT);
+    glSamplerParameteri(s, GL_TEXTURE_WRAP_R, key.wrapR);
+    glSamplerParameteri(s, GL_TEXTURE_MIN_FILTER, key.minFilter);
+    glSamplerParameteri(s, GL_TEXTURE_MAG_FILTER, key.magFilter);
+    glSamplerParameterf(s, GL_TEXTURE_MIN_LOD, key.minLod);
+    glSamplerParameterf(s, GL_TEXTURE_MAX_LOD, key.maxLod);
+    glSamplerParameterf(s, GL_TEXTURE_LOD_BIAS, key.lodBias);
+    if (key.anisotropy > 1.0f) glSamplerParameterf(s, GL_TEXTURE_MAX_ANISOTROPY, key.anisotropy);
+    ++stats_.created;
+    samplers_.emplace(key, s);
+    return s;
+}
+
+void SamplerCache::Bind(int unit, const SamplerDesc& desc) {
+    ++stats_.binds;
+    GetGlState().BindSampler(unit, Get(desc));
+}
+
+void SamplerCache::Unbind(int unit) {
+    GetGlState().BindSampler(unit, 0);
+}
+
+void SamplerCache::Clear() {
+    for (auto& [desc, s] : samplers_) {
+        GetGlState().ForgetSampler(s);
+        glDeleteSamplers(1, &s);
+    }
+    samplers_.clear();
+}
+
+void SamplerCache::PrintStats(FILE* out) const {
+    fprintf(out, "[SamplerCache] samplers=%zu created=%u lookups=%u binds=%u | max anisotropy %.0f\n",
+            samplers_.size(), stats_.created, stats_.lookups, stats_.binds, maxAnisotropy_);
+}
+
+SamplerCache& GetSamplerCache() {
+    static SamplerCache cache;
+    return cache;
+}
@@ -0,0 +1,239 @@
+#include "shader_async.h"
+#include "shader_util.h"
+#include "program_cache.h"
+#include "shader_preprocessor.h"
+
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <cstring>
+
+// GL_KHR_parallel_shader_compile (glad는 코어 프로파일만 생성되어 있으므로 직접 정의)
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
+namespace {
+bool HasExtension(const char* name) {
+    GLint n = 0; glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+    for (GLint i = 0; i < n; ++i) {
+        const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (ext && std::strcmp(ext, name) == 0) return true;
+    }
+    return false;
+}
+
+GLuint SubmitStage(GLenum type, const char* src) {
+    GLuint s = glCreateShader(type);
+    glShaderSource(s, 1, &src, nullptr);
+    glCompileShader(s);
+    return s;
+}
+}
+
+// ───────────────────────── AsyncProgram ─────────────────────────
+
+bool AsyncProgram::IsReady() {
+    if (resolved_) return true;
+    switch (mode_) {
+    case Mode::Parallel: {
+        GLint done = GL_FALSE;
+        glGetProgramiv(prog_, GL_COMPLETION_STATUS_KHR, &done);
+        return done == GL_TRUE;
+    }
+    case Mode::Worker: {
+        std::lock_guard<std::mutex> lk(m_);
+        return workerDone_;
+    }
+    default:
+        return true;
+    }
+}
+
+GLuint AsyncProgram::Id() {
+    if (!resolved_) {
+        auto t0 = std::chrono::steady_clock::now();
+        owner_->Resolve(*this);
+        owner_->stats_.stallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+    return ok_ ? prog_ : 0;
+}
+
+// ───────────────────────── ShaderCompiler ─────────────────────────
+
+ShaderCompiler::~ShaderCompiler() { Shutdown(); }
+
+void ShaderCompiler::Init(GLFWwindow* mainWindow, bool useWorker) {
+    if (HasExtension("GL_KHR_parallel_shader_compile") || HasExtension("GL_ARB_parallel_shader_compile")) {
+        auto maxThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+        if (!maxThreads)
+            maxThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+        if (maxThreads) {
+            maxThreads(0xFFFFFFFFu); // 드라이버가 정하는 최대 스레드 수 사용
+            khrParallel_ = true;
+            return;
+        }
+    }
+    if (!useWorker || !mainWindow) return;
+
+    // 공유 컨텍스트용 숨김 창 (창 생성은 메인 스레드에서만 가능). 컨텍스트 버전 힌트는 메인 창 것을 그대로 사용
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    workerWindow_ = glfwCreateWindow(1, 1, "shader-worker", nullptr, mainWindow);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    if (!workerWindow_) {
+        fprintf(stderr, "[ShaderCompiler] shared context creation failed, using deferred compile\n");
+        return;
+    }
+    quit_ = false;
+    worker_ = std::thread(&ShaderCompiler::WorkerLoop, this);
+}
+
+void ShaderCompiler::Shutdown() {
+    if (worker_.joinable()) {
+        { std::lock_guard<std::mutex> lk(qm_); quit_ = true; }
+        qcv_.notify_all();
+        worker_.join();
+    }
+    // 처리되지 못한 작업은 실패로 완료 처리 (Id()에서 영원히 기다리지 않도록)
+    for (auto& p : queue_) {
+        std::lock_guard<std::mutex> lk(p->m_);
+        p->workerDone_ = true; p->workerOk_ = false;
+        p->cv_.notify_all();
+    }
+    queue_.clear();
+    if (workerWindow_) { glfwDestroyWindow(workerWindow_); workerWindow_ = nullptr; }
+}
+
+AsyncProgramPtr ShaderCompiler::CompileAsync(std::string vs, std::string fs, std::string name) {
+    auto p = std::make_shared<AsyncProgram>();
+    p->owner_ = this;
+    p->name_ = std::move(name);
+    ++stats_.submitted;
+
+    ProgramBinaryCache& cache = GetProgramCache();
+    p->cacheKey_ = cache.MakeKey(vs, fs);
+    if (GLuint cached = cache.Load(p->cacheKey_)) {
+        p->mode_ = AsyncProgram::Mode::Cached;
+        p->prog_ = cached;
+        p->resolved_ = p->ok_ = true;
+        ++stats_.cacheHits;
+        return p;
+    }
+
+    p->vsSrc_ = std::move(vs);
+    p->fsSrc_ = std::move(fs);
+    Submit(p);
+    return p;
+}
+
+AsyncProgramPtr ShaderCompiler::CompileFilesAsync(const char* vsPath, const char* fsPath) {
+    ShaderPreprocessor& pp = GetShaderPreprocessor();
+    std::string vsCode = pp.Process(vsPath).source;
+    std::string fsCode = pp.Process(fsPath).source;
+    std::string name = std::string(vsPath) + " + " + fsPath;
+    if (vsCode.empty() || fsCode.empty()) {
+        fprintf(stderr, "Shader source empty: %s or %s\n", vsPath, fsPath);
+        auto p = std::make_shared<AsyncProgram>();
+        p->owner_ = this; p->name_ = std::move(name);
+        p->resolved_ = true; p->ok_ = false;
+        ++stats_.submitted; ++stats_.failed;
+        return p;
+    }
+    return CompileAsync(std::move(vsCode), std::move(fsCode), std::move(name));
+}
+
+void ShaderCompiler::Submit(const AsyncProgramPtr& p) {
+    if (worker_.joinable() && !khrParallel_) {
+        p->mode_ = AsyncProgram::Mode::Worker;
+        ++stats_.worker;
+        { std::lock_guard<std::mutex> lk(qm_); queue_.push_back(p); }
+        qcv_.notify_one();
+        return;
+    }
+
+    // KHR 경로와 Deferred 경로 모두 여기서 바로 제출하고 상태 확인은 Resolve로 미룸
+    p->mode_ = khrParallel_ ? AsyncProgram::Mode::Parallel : AsyncProgram::Mode::Deferred;
+    if (khrParallel_) ++stats_.parallel; else ++stats_.deferred;
+    p->vs_ = SubmitStage(GL_VERTEX_SHADER, p->vsSrc_.c_str());
+    p->fs_ = SubmitStage(GL_FRAGMENT_SHADER, p->fsSrc_.c_str());
+    p->prog_ = glCreateProgram();
+    if (glProgramParameteri)
+        glProgramParameteri(p->prog_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(p->prog_, p->vs_);
+    glAttachShader(p->prog_, p->fs_);
+    glLinkProgram(p->prog_);
+    p->vsSrc_.clear(); p->fsSrc_.clear();
+}
+
+void ShaderCompiler::Resolve(AsyncProgram& p) {
+    if (p.mode_ == AsyncProgram::Mode::Worker) {
+        std::unique_lock<std::mutex> lk(p.m_);
+        p.cv_.wait(lk, [&] { return p.workerDone_; });
+        if (p.fence_) {
+            // 워커 컨텍스트의 명령이 끝난 뒤에 이 컨텍스트가 프로그램을 쓰도록
+            glWaitSync(p.fence_, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(p.fence_);
+            p.fence_ = nullptr;
+        }
+        p.ok_ = p.workerOk_;
+    }
+    else {
+        GLint linked = 0; glGetProgramiv(p.prog_, GL_LINK_STATUS, &linked);
+        p.ok_ = linked != 0;
+        if (!p.ok_) {
+            fprintf(stderr, "[ShaderCompiler] %s failed\n", p.name_.c_str());
+            CheckShaderCompile(p.vs_, "Vertex");
+            CheckShaderCompile(p.fs_, "Fragment");
+            CheckProgramLink(p.prog_);
+        }
+        glDetachShader(p.prog_, p.vs_); glDeleteShader(p.vs_);
+        glDetachShader(p.prog_, p.fs_); glDeleteShader(p.fs_);
+        p.vs_ = p.fs_ = 0;
+    }
+
+    p.resolved_ = true;
+    if (p.ok_) {
+        GetProgramCache().Store(p.cacheKey_, p.prog_);
+    }
+    else {
+        if (p.prog_) glDeleteProgram(p.prog_);
+        p.prog_ = 0;
+        ++stats_.failed;
+    }
+}
+
+void ShaderCompiler::WorkerLoop() {
+    glfwMakeContextCurrent(workerWindow_);
+    for (;;) {
+        AsyncProgramPtr job;
+        {
+            std::unique_lock<std::mutex> lk(qm_);
+            qcv_.wait(lk, [&] { return quit_ || !queue_.empty(); });
+            if (quit_) break;
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        // 워커에서는 블로킹해도 되므로 기존 동기 경로를 그대로 사용
+        GLuint prog = CreateShaderProgram(job->vsSrc_.c_str(), job->fsSrc_.c_str());
+        GLint linked = 0; glGetProgramiv(prog, GL_LINK_STATUS, &linked);
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+
+        std::lock_guard<std::mutex> lk(job->m_);
+        job->prog_ = prog;
+        job->fence_ = fence;
+        job->workerOk_ = linked != 0;
+        job->workerDone_ = true;
+        job->vsSrc_.clear(); job->fsSrc_.clear();
+        job->cv_.notify_all();
+    }
+    glfwMakeContextCurrent(nullptr);
+}
+
+void ShaderCompiler::PrintStats(FILE* out) const {
+    fprintf(out, "[ShaderCompiler] %s | submitted=%u cached=%u parallel=%u worker=%u deferred=%u failed=%u | stall %.2f ms\n",
+            khrParallel_ ? "KHR_parallel_shader_compile" : (worker_.joinable() ? "shared-context worker" : "deferred"),
+            stats_.submitted, stats_.cacheHits, stats_.parallel, stats_.worker, stats_.deferred, stats_.failed, stats_.stallMs);
+}
@@ -0,0 +1,210 @@
+#include "shader_hot_reload.h"
+#include "gl_state.h"
+#include "shader_preprocessor.h"
+#include "shader_util.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+double MsBetween(ShaderHotReloader::Clock::time_point a, ShaderHotReloader::Clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+}
+
+ShaderHotReloader::~ShaderHotReloader() { Stop(); }
+
+std::string ShaderHotReloader::Normalize(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+bool ShaderHotReloader::Watch(const std::string& dir) {
+    std::lock_guard<std::mutex> lk(m_);
+#ifdef __linux__
+    if (inotifyFd_ < 0) {
+        inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyFd_ < 0) { perror("[HotReload] inotify_init1"); return false; }
+    }
+    // 에디터가 임시 파일에 쓰고 rename 하는 경우(IN_MOVED_TO)까지 잡음
+    int wd = inotify_add_watch(inotifyFd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        fprintf(stderr, "[HotReload] cannot watch %s\n", dir.c_str());
+        return false;
+    }
+    watchDescs_[wd] = Normalize(dir);
+#endif
+    watchDirs_.push_back(Normalize(dir));
+    if (!thread_.joinable()) {
+        quit_ = false;
+        thread_ = std::thread(&ShaderHotReloader::WatchLoop, this);
+    }
+    return true;
+}
+
+void ShaderHotReloader::Stop() {
+    quit_ = true;
+    if (thread_.joinable()) thread_.join();
+#ifdef __linux__
+    if (inotifyFd_ >= 0) { close(inotifyFd_); inotifyFd_ = -1; }
+#endif
+}
+
+int ShaderHotReloader::Register(const std::string& vsPath, const std::string& fsPath, GLuint program,
+                                std::vector<std::string> defines) {
+    Slot s;
+    s.vsPath = Normalize(vsPath);
+    s.fsPath = Normalize(fsPath);
+    s.defines = std::move(defines);
+    s.program = program;
+    // 등록은 시작 시점에만 하므로 여기서 동기로 읽어도 프레임에 영향 없음.
+    // 전처리해 두면 include 그래프가 만들어져 헤더 변경도 추적됨
+    ShaderPreprocessor& pp = GetShaderPreprocessor();
+    pp.Process(s.vsPath, s.defines);
+    pp.Process(s.fsPath, s.defines);
+    slots_.push_back(std::move(s));
+    return (int)slots_.size() - 1;
+}
+
+void ShaderHotReloader::OnFileChanged(const std::string& path) {
+    // 파일 I/O는 감시 스레드에서 끝내고 메인 스레드에는 내용만 넘김
+    std::string src = ReadFile(path.c_str());
+    if (src.empty()) return; // 저장 도중(잘린 상태)일 수 있음 → 다음 이벤트를 기다림
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lk(m_);
+    auto it = changed_.find(path);
+    if (it == changed_.end()) changed_.emplace(path, Change{ std::move(src), now });
+    else it->second.source = std::move(src); // 감지 시각은 가장 이른 것을 유지
+}
+
+void ShaderHotReloader::WatchLoop() {
+#ifdef __linux__
+    alignas(inotify_event) char buf[4096];
+    while (!quit_) {
+        pollfd pfd{ inotifyFd_, POLLIN, 0 };
+        if (poll(&pfd, 1, 100) <= 0) continue;
+        ssize_t n = read(inotifyFd_, buf, sizeof(buf));
+        for (ssize_t off = 0; off < n;) {
+            const inotify_event* ev = reinterpret_cast<const inotify_event*>(buf + off);
+            off += sizeof(inotify_event) + ev->len;
+            if (ev->len == 0) continue;
+            std::string dir;
+            {
+                std::lock_guard<std::mutex> lk(m_);
+                auto it = watchDescs_.find(ev->wd);
+                if (it != watchDescs_.end()) dir = it->second;
+            }
+            if (!dir.empty()) OnFileChanged(Normalize(dir + "/" + ev->name));
+        }
+    }
+#else
+    // inotify가 없는 플랫폼: 감시 디렉터리의 mtime을 주기적으로 비교
+    namespace fs = std::filesystem;
+    std::unordered_map<std::string, fs::file_time_type> stamps;
+    bool first = true;
+    while (!quit_) {
+        std::vector<std::string> dirs;
+        { std::lock_guard<std::mutex> lk(m_); dirs = watchDirs_; }
+        for (const std::string& d : dirs) {
+            std::error_code ec;
+            for (const auto& e : fs::directory_iterator(d, ec)) {
+                if (!e.is_regular_file(ec)) continue;
+                std::string p = Normalize(e.path().generic_string());
+                auto t = e.last_write_time(ec);
+                auto it = stamps.find(p);
+                if (it == stamps.end()) { stamps.emplace(p, t); if (!first) OnFileChanged(p); }
+                else if (it->second != t) { it->second = t; OnFileChanged(p); }
+            }
+        }
+        first = false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+#endif
+}
+
+bool ShaderHotReloader::Update() {
+    const Clock::time_point t0 = Clock::now();
+    if (lastUpdate_ != Clock::time_point{}) {
+        double frameMs = MsBetween(lastUpdate_, t0);
+        stats_.avgFrameMs = stats_.avgFrameMs == 0 ? frameMs : stats_.avgFrameMs * 0.95 + frameMs * 0.05;
+    }
+
+    std::unordered_map<std::string, Change> changes;
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        changes.swap(changed_);
+    }
+    // 바뀐 파일을 (직접 또는 #include로) 쓰는 루트만 다시 전처리/컴파일
+    ShaderPreprocessor& pp = GetShaderPreprocessor();
+    for (auto& [path, c] : changes) {
+        std::vector<std::string> roots = pp.UpdateFile(path, std::move(c.source));
+        for (Slot& s : slots_) {
+            bool hit = false;
+            for (const std::string& r : roots) hit = hit || r == s.vsPath || r == s.fsPath;
+            if (!hit) continue;
+            if (!s.dirty || c.when < s.changedAt) s.changedAt = c.when;
+            s.dirty = true;
+        }
+    }
+
+    bool swapped = false;
+    for (int i = 0; i < (int)slots_.size(); ++i) {
+        Slot& s = slots_[i];
+        if (s.pending && s.pending->IsReady()) {
+            // IsReady()가 참이므로 Id()는 블로킹하지 않음
+            GLuint p = s.pending->Id();
+            double latency = MsBetween(s.pendingSince, Clock::now());
+            if (p) {
+                if (s.program) { GetGlState().ForgetProgram(s.program); glDeleteProgram(s.program); }
+                s.program = p;
+                if (onReload_) onReload_(i, p);
+                swapped = true;
+                ++stats_.reloads;
+                stats_.lastLatencyMs = latency;
+                stats_.sumLatencyMs += latency;
+                stats_.maxLatencyMs = std::max(stats_.maxLatencyMs, latency);
+                fprintf(stdout, "[HotReload] %s reloaded (%.1f ms after change)\n", s.pending->Name().c_str(), latency);
+            }
+            else {
+                ++stats_.failures;
+                fprintf(stderr, "[HotReload] %s failed to compile, keeping previous program\n", s.pending->Name().c_str());
+            }
+            s.pending.reset();
+        }
+        if (!s.pending && s.dirty) {
+            s.dirty = false;
+            s.pendingSince = s.changedAt;
+            PreprocessResult vs = pp.Process(s.vsPath, s.defines);
+            PreprocessResult fs = pp.Process(s.fsPath, s.defines);
+            if (vs.ok && fs.ok)
+                s.pending = compiler_.CompileAsync(std::move(vs.source), std::move(fs.source), s.vsPath + " + " + s.fsPath);
+            else
+                ++stats_.failures; // 전처리 오류 (없는 include 등) → 기존 프로그램 유지
+        }
+    }
+
+    const Clock::time_point t1 = Clock::now();
+    double updateMs = MsBetween(t0, t1);
+    stats_.sumUpdateMs += updateMs;
+    stats_.maxUpdateMs = std::max(stats_.maxUpdateMs, updateMs);
+    ++stats_.updates;
+    if (swapFrame_) stats_.maxSwapFrameMs = std::max(stats_.maxSwapFrameMs, MsBetween(lastUpdate_, t0));
+    swapFrame_ = swapped;
+    lastUpdate_ = t0;
+    return swapped;
+}
+
+void ShaderHotReloader::PrintStats(FILE* out) const {
+    const HotReloadStats& s = stats_;
+    fprintf(out, "[HotReload] reloads=%u failures=%u | latency avg %.1f ms max %.1f ms"
+                 " | Update avg %.3f ms max %.3f ms | frame avg %.2f ms, worst swap frame %.2f ms\n",
+            s.reloads, s.failures,
+            s.reloads ? s.sumLatencyMs / s.reloads : 0.0, s.maxLatencyMs,
+            s.updates ? s.sumUpdateMs / s.updates : 0.0, s.maxUpdateMs,
+            s.avgFrameMs, s.maxSwapFrameMs);
+}
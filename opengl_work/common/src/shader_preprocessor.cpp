@@ -0,0 +1,248 @@
+#include "shader_preprocessor.h"
+#include "embedded_shaders.h"
+#include "shader_util.h"
+#include "vfs.h"
+
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+
+namespace {
+bool StartsWithDirective(const std::string& line, size_t& pos, const char* word) {
+    // "  #  include" 처럼 # 앞뒤 공백 허용
+    size_t i = line.find_first_not_of(" \t");
+    if (i == std::string::npos || line[i] != '#') return false;
+    i = line.find_first_not_of(" \t", i + 1);
+    if (i == std::string::npos) return false;
+    size_t n = std::char_traits<char>::length(word);
+    if (line.compare(i, n, word) != 0) return false;
+    if (i + n < line.size() && !isspace((unsigned char)line[i + n])) return false;
+    pos = i + n;
+    return true;
+}
+
+std::string DefineLine(const std::string& def) {
+    std::string d = def;
+    size_t eq = d.find('=');
+    if (eq != std::string::npos) d[eq] = ' ';
+    return "#define " + d + "\n";
+}
+}
+
+ShaderPreprocessor::ShaderPreprocessor()
+    : loader_([](const std::string& p) {
+          // 빌드 시 임베드된 셰이더가 있으면 파일을 열지 않음
+          if (const EmbeddedShader* e = FindEmbeddedShader(p)) return std::string(e->source);
+          return ReadFile(p.c_str());
+      }) {}
+
+std::string ShaderPreprocessor::Normalize(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+void ShaderPreprocessor::AddIncludeDir(const std::string& dir) {
+    includeDirs_.push_back(Normalize(dir));
+}
+
+void ShaderPreprocessor::Parse(const std::string& text, FileNode& node) {
+    node.pieces.clear();
+    node.version.clear();
+    node.pragmaOnce = false;
+
+    size_t begin = 0;
+    // UTF-8 BOM 제거 (일부 셰이더가 BOM 포함 저장되어 있음)
+    if (text.size() >= 3 && (unsigned char)text[0] == 0xEF && (unsigned char)text[1] == 0xBB && (unsigned char)text[2] == 0xBF)
+        begin = 3;
+
+    Piece cur{ Piece::Text, {}, 1, false };
+    int lineNo = 1;
+    while (begin < text.size()) {
+        size_t end = text.find('\n', begin);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(begin, end - begin);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        begin = end + 1;
+
+        size_t pos = 0;
+        if (StartsWithDirective(line, pos, "include")) {
+            size_t open = line.find_first_of("\"<", pos);
+            char closeCh = (open != std::string::npos && line[open] == '<') ? '>' : '"';
+            size_t close = open == std::string::npos ? open : line.find(closeCh, open + 1);
+            if (close != std::string::npos) {
+                if (!cur.text.empty()) node.pieces.push_back(std::move(cur));
+                node.pieces.push_back(Piece{ Piece::Include, line.substr(open + 1, close - open - 1), lineNo, closeCh == '>' });
+                cur = Piece{ Piece::Text, {}, lineNo + 1, false };
+                ++lineNo;
+                continue;
+            }
+        }
+        else if (StartsWithDirective(line, pos, "version")) {
+            // 루트의 #version은 맨 앞으로 끌어올리고, 자리에는 빈 줄을 남겨 줄 번호 유지
+            if (node.version.empty()) node.version = line;
+            line.clear();
+        }
+        else if (StartsWithDirective(line, pos, "pragma") && line.find("once", pos) != std::string::npos) {
+            node.pragmaOnce = true;
+            line.clear();
+        }
+        cur.text += line;
+        cur.text += '\n';
+        ++lineNo;
+    }
+    if (!cur.text.empty()) node.pieces.push_back(std::move(cur));
+    node.loaded = true;
+}
+
+const ShaderPreprocessor::FileNode* ShaderPreprocessor::GetFile(const std::string& path) {
+    FileNode& node = files_[path];
+    if (!node.loaded) {
+        std::string text = loader_(path);
+        if (text.empty()) { files_.erase(path); return nullptr; }
+        Parse(text, node);
+        ++stats_.fileLoads;
+    }
+    return &node;
+}
+
+std::string ShaderPreprocessor::Resolve(const std::string& from, const Piece& inc) {
+    namespace fs = std::filesystem;
+    Vfs& vfs = GetVfs();
+    if (!inc.angled) {
+        // "..." 는 포함하는 파일 기준 상대 경로 먼저
+        std::string p = Normalize((fs::path(from).parent_path() / inc.text).generic_string());
+        if (files_.count(p) || FindEmbeddedShader(p) || vfs.Exists(p)) return p;
+    }
+    for (const std::string& dir : includeDirs_) {
+        std::string p = Normalize(dir + "/" + inc.text);
+        if (files_.count(p) || FindEmbeddedShader(p) || vfs.Exists(p)) return p;
+    }
+    // 찾지 못하면 상대 경로 그대로 (로더가 파일 시스템 밖에서 찾을 수도 있음)
+    return Normalize((fs::path(from).parent_path() / inc.text).generic_string());
+}
+
+bool ShaderPreprocessor::Expand(const std::string& path, ExpandState& st) {
+    const FileNode* node = GetFile(path);
+    if (!node) { st.error = "cannot open " + path; return false; }
+    st.deps.insert(path);
+    if (node->pragmaOnce) {
+        if (st.onceDone.count(path)) return true;
+        st.onceDone.insert(path);
+    }
+    for (const std::string& s : st.stack) {
+        if (s == path) { st.error = "include cycle at " + path; return false; }
+    }
+
+    int idx;
+    auto it = st.fileIndex.find(path);
+    if (it == st.fileIndex.end()) {
+        idx = (int)st.files.size();
+        st.fileIndex.emplace(path, idx);
+        st.files.push_back(path);
+    }
+    else idx = it->second;
+
+    st.stack.push_back(path);
+    const bool isRoot = st.stack.size() == 1;
+    bool needLine = !isRoot; // 루트 첫 #line은 Process()에서 출력
+    for (const Piece& pc : node->pieces) {
+        if (pc.kind == Piece::Text) {
+            if (needLine) st.out += "#line " + std::to_string(pc.line) + " " + std::to_string(idx) + "\n";
+            st.out += pc.text;
+            needLine = false;
+            continue;
+        }
+        std::string child = Resolve(path, pc);
+        if (!Expand(child, st)) {
+            if (st.error.find(" (from ") == std::string::npos)
+                st.error += " (from " + path + ":" + std::to_string(pc.line) + ")";
+            st.stack.pop_back();
+            return false;
+        }
+        needLine = true; // include 뒤에는 원래 파일의 줄 번호로 복귀
+    }
+    st.stack.pop_back();
+    return true;
+}
+
+PreprocessResult ShaderPreprocessor::Process(const std::string& rawPath, const std::vector<std::string>& defines) {
+    auto t0 = std::chrono::steady_clock::now();
+    const std::string path = Normalize(rawPath);
+
+    std::string key = path;
+    for (const std::string& d : defines) { key += '\n'; key += d; }
+    auto memo = outputs_.find(key);
+    if (memo != outputs_.end()) {
+        ++stats_.memoHits;
+        stats_.totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        return memo->second.result;
+    }
+
+    ExpandState st;
+    PreprocessResult r;
+    const FileNode* root = GetFile(path);
+    if (!root) {
+        r.error = "cannot open " + path;
+    }
+    else {
+        // #version → 주입 define → #line 1 0 → 본문 순서
+        std::string header;
+        if (!root->version.empty()) header = root->version + "\n";
+        for (const std::string& d : defines) header += DefineLine(d);
+        header += "#line 1 0\n";
+        st.out = std::move(header);
+        r.ok = Expand(path, st);
+        r.error = st.error;
+        r.files = st.files;
+        if (r.ok) r.source = std::move(st.out);
+        deps_[path] = std::move(st.deps);
+    }
+    if (!r.ok) fprintf(stderr, "[ShaderPreprocessor] %s\n", r.error.c_str());
+
+    ++stats_.processed;
+    if (r.ok) outputs_[key] = Output{ path, r };
+    stats_.totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return r;
+}
+
+std::vector<std::string> ShaderPreprocessor::AffectedRoots(const std::string& path) {
+    std::vector<std::string> roots;
+    for (const auto& [root, files] : deps_)
+        if (files.count(path)) roots.push_back(root);
+    // 출력 메모 중 영향 받는 루트 것만 제거 → 나머지 프로그램은 재전처리/재컴파일하지 않음
+    for (auto it = outputs_.begin(); it != outputs_.end();) {
+        bool hit = false;
+        for (const std::string& r : roots) if (it->second.root == r) { hit = true; break; }
+        it = hit ? outputs_.erase(it) : std::next(it);
+    }
+    return roots;
+}
+
+std::vector<std::string> ShaderPreprocessor::UpdateFile(const std::string& rawPath, std::string text) {
+    const std::string path = Normalize(rawPath);
+    FileNode& node = files_[path];
+    Parse(text, node);
+    ++stats_.fileLoads;
+    return AffectedRoots(path);
+}
+
+std::vector<std::string> ShaderPreprocessor::Invalidate(const std::string& rawPath) {
+    const std::string path = Normalize(rawPath);
+    files_.erase(path);
+    return AffectedRoots(path);
+}
+
+const std::unordered_set<std::string>* ShaderPreprocessor::Dependencies(const std::string& root) const {
+    auto it = deps_.find(Normalize(root));
+    return it == deps_.end() ? nullptr : &it->second;
+}
+
+void ShaderPreprocessor::PrintStats(FILE* out) const {
+    unsigned calls = stats_.processed + stats_.memoHits;
+    fprintf(out, "[ShaderPreprocessor] processed=%u memo=%u fileLoads=%u | avg %.3f ms/shader\n",
+            stats_.processed, stats_.memoHits, stats_.fileLoads, calls ? stats_.totalMs / calls : 0.0);
+}
+
+ShaderPreprocessor& GetShaderPreprocessor() {
+    static ShaderPreprocessor pp;
+    return pp;
+}
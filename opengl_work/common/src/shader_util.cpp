@@ -0,0 +1,108 @@
+#include "shader_util.h"
+#include "embedded_shaders.h"
+#include "program_cache.h"
+#include "shader_preprocessor.h"
+#include "vfs.h"
+
+#include <chrono>
+#include <cstdio>
+
+bool CheckShaderCompile(GLuint shader, const char* name)
+{
+    GLint success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        GLint len = 0; glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &len);
+        std::string log(len, '\0');
+        glGetShaderInfoLog(shader, len, &len, log.data());
+        fprintf(stderr, "[Shader Compile Error] %s\n%s\n", name, log.c_str());
+    }
+    return success != 0;
+}
+
+bool CheckProgramLink(GLuint prog)
+{
+    GLint success = 0; glGetProgramiv(prog, GL_LINK_STATUS, &success);
+    if (!success) {
+        GLint len = 0; glGetProgramiv(prog, GL_INFO_LOG_LENGTH, &len);
+        std::string log(len, '\0');
+        glGetProgramInfoLog(prog, len, &len, log.data());
+        fprintf(stderr, "[Program Link Error]\n%s\n", log.c_str());
+    }
+    return success != 0;
+}
+
+GLuint CreateShaderProgram(const char* vs, const char* fs)
+{
+    GLuint v = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(v, 1, &vs, nullptr);
+    glCompileShader(v);
+    CheckShaderCompile(v, "Vertex");
+
+    GLuint f = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(f, 1, &fs, nullptr);
+    glCompileShader(f);
+    CheckShaderCompile(f, "Fragment");
+
+    GLuint p = glCreateProgram();
+    // 나중에 glGetProgramBinary로 꺼낼 수 있도록 링크 전에 힌트 설정
+    if (glProgramParameteri)
+        glProgramParameteri(p, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(p, v);
+    glAttachShader(p, f);
+    glLinkProgram(p);
+    CheckProgramLink(p);
+
+    glDeleteShader(v);
+    glDeleteShader(f);
+    return p;
+}
+
+std::string ReadFile(const char* path) {
+    // VFS 매핑 구간에서 문자열로 한 번만 복사 (실패 로그는 Vfs::Open이 출력)
+    FileView v = GetVfs().Open(path);
+    return v ? std::string(v.str()) : std::string();
+}
+
+static GLuint CreateCachedProgramKeyed(const char* vsCode, const char* fsCode, uint64_t key) {
+    // 1) 디스크 캐시 확인
+    ProgramBinaryCache& cache = GetProgramCache();
+    if (GLuint cached = cache.Load(key))
+        return cached;
+
+    // 2) 미스/거부 → 일반 컴파일 후 바이너리 기록
+    auto t0 = std::chrono::steady_clock::now();
+    GLuint p = CreateShaderProgram(vsCode, fsCode);
+    GLint linked = 0; glGetProgramiv(p, GL_LINK_STATUS, &linked);
+    cache.AddBuildTime(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+    if (!linked) {
+        glDeleteProgram(p);
+        return 0;
+    }
+    cache.Store(key, p);
+    return p;
+}
+
+GLuint CreateCachedProgram(const std::string& vsCode, const std::string& fsCode) {
+    return CreateCachedProgramKeyed(vsCode.c_str(), fsCode.c_str(), GetProgramCache().MakeKey(vsCode, fsCode));
+}
+
+GLuint CreateShaderProgramFromFiles(const char* vsPath, const char* fsPath) {
+    // 임베드된 셰이더이고 #include가 없으면 전처리 없이 리터럴을 바로 사용 (I/O·할당 없음)
+    const EmbeddedShader* ev = FindEmbeddedShader(vsPath);
+    const EmbeddedShader* ef = FindEmbeddedShader(fsPath);
+    if (ev && ef && !ev->hasInclude && !ef->hasInclude) {
+        return CreateCachedProgramKeyed(ev->source.data(), ef->source.data(),
+                                        GetProgramCache().MakeKey(ev->hash, ef->hash));
+    }
+
+    // #include 확장 + #line 매핑 (전처리 결과는 메모이즈됨)
+    ShaderPreprocessor& pp = GetShaderPreprocessor();
+    std::string vsCode = pp.Process(vsPath).source;
+    std::string fsCode = pp.Process(fsPath).source;
+    if (vsCode.empty() || fsCode.empty()) {
+        fprintf(stderr, "Shader source empty: %s or %s\n", vsPath, fsPath);
+        return 0;
+    }
+    return CreateCachedProgram(vsCode, fsCode);
+}
@@ -0,0 +1,112 @@
+#include "shader_variants.h"
+#include "gl_state.h"
+#include "shader_preprocessor.h"
+#include "shader_util.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace {
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+}
+
+ShaderVariants::ShaderVariants(std::string vsPath, std::string fsPath, std::vector<std::string> features)
+    : vsPath_(std::move(vsPath)), fsPath_(std::move(fsPath)), features_(std::move(features)) {}
+
+ShaderVariants::~ShaderVariants() = default;
+
+uint32_t ShaderVariants::Mask(std::initializer_list<const char*> names) const {
+    uint32_t mask = 0;
+    for (const char* n : names) {
+        bool found = false;
+        for (size_t i = 0; i < features_.size(); ++i) {
+            if (features_[i] == n) { mask |= 1u << i; found = true; break; }
+        }
+        if (!found) fprintf(stderr, "[ShaderVariants] unknown feature %s\n", n);
+    }
+    return mask;
+}
+
+std::vector<std::string> ShaderVariants::Defines(uint32_t mask) const {
+    std::vector<std::string> defs;
+    for (size_t i = 0; i < features_.size(); ++i)
+        if (mask & (1u << i)) defs.push_back(features_[i]);
+    return defs;
+}
+
+void ShaderVariants::Precompile(const std::vector<uint32_t>& hotSet, ShaderCompiler* compiler) {
+    ShaderPreprocessor& pp = GetShaderPreprocessor();
+    for (uint32_t mask : hotSet) {
+        if (variants_.count(mask)) continue;
+        if (!compiler) { Get(mask); continue; }
+
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::string> defs = Defines(mask);
+        PreprocessResult vs = pp.Process(vsPath_, defs);
+        PreprocessResult fs = pp.Process(fsPath_, defs);
+        if (!vs.ok || !fs.ok) {
+            // 항목을 남기지 않음 → Get()이 다시 시도 (include를 고쳤으면 그때 성공)
+            ++stats_.failed;
+            stats_.compileMs += MsSince(t0);
+            continue;
+        }
+        Variant& v = variants_[mask];
+        v.pending = compiler->CompileAsync(std::move(vs.source), std::move(fs.source), fsPath_ + " [" + std::to_string(mask) + "]");
+        v.submitted = t0;
+        ++stats_.compiled;
+        stats_.compileMs += MsSince(t0);
+    }
+}
+
+GLuint ShaderVariants::Get(uint32_t mask) {
+    ++stats_.lookups;
+    auto it = variants_.find(mask);
+    if (it != variants_.end()) {
+        Variant& v = it->second;
+        if (v.pending) {
+            // 비동기로 미리 제출된 변형: 첫 사용 때 상태 확인
+            auto t0 = std::chrono::steady_clock::now();
+            v.program = v.pending->Id();
+            v.pending.reset();
+            if (!v.program) ++stats_.failed;
+            stats_.compileMs += MsSince(t0);
+            stats_.asyncMs += MsSince(v.submitted);
+        }
+        return v.program;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::string> defs = Defines(mask);
+    ShaderPreprocessor& pp = GetShaderPreprocessor();
+    PreprocessResult vs = pp.Process(vsPath_, defs);
+    PreprocessResult fs = pp.Process(fsPath_, defs);
+    Variant& v = variants_[mask];
+    if (vs.ok && fs.ok)
+        v.program = CreateCachedProgram(vs.source, fs.source);
+    if (!v.program) ++stats_.failed;
+    ++stats_.compiled;
+    stats_.compileMs += MsSince(t0);
+    return v.program;
+}
+
+void ShaderVariants::Replace(uint32_t mask, GLuint program) {
+    Variant& v = variants_[mask];
+    v.pending.reset();
+    v.program = program;
+}
+
+void ShaderVariants::Clear() {
+    for (auto& [mask, v] : variants_) {
+        if (v.pending) v.program = v.pending->Id();
+        if (v.program) { GetGlState().ForgetProgram(v.program); glDeleteProgram(v.program); }
+    }
+    variants_.clear();
+}
+
+void ShaderVariants::PrintStats(FILE* out) const {
+    fprintf(out, "[ShaderVariants] %s: variants=%zu compiled=%u failed=%u lookups=%u | %.2f ms (async submit-to-ready %.2f ms)\n",
+            fsPath_.c_str(), variants_.size(), stats_.compiled, stats_.failed, stats_.lookups, stats_.compileMs,
+            stats_.asyncMs);
+}
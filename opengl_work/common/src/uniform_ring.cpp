@@ -0,0 +1,138 @@
+#include "uniform_ring.h"
+
+#include <algorithm>
+
+bool UniformRing::Init(size_t bytesPerFrame, int framesInFlight) {
+    Destroy();
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align_);
+    if (align_ <= 0) align_ = 256;
+    regions_ = std::clamp(framesInFlight, 1, (int)(sizeof(fences_) / sizeof(fences_[0])));
+    regionSize_ = (bytesPerFrame + align_ - 1) / align_ * align_;
+    const GLsizeiptr total = (GLsizeiptr)(regionSize_ * regions_);
+
+    glGenBuffers(1, &buffer_);
+    GetGlState().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    if (glBufferStorage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, total, nullptr, flags);
+        mapped_ = static_cast<unsigned char*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, total, flags));
+        persistent_ = mapped_ != nullptr;
+    }
+    if (!persistent_) {
+        // 4.4 미만(또는 매핑 실패): 일반 버퍼 + 프레임마다 구역만 매핑
+        if (glBufferStorage) {
+            // 불변 저장소는 다시 지정할 수 없으므로 버퍼를 새로 만듦
+            GetGlState().ForgetBuffer(buffer_);
+            glDeleteBuffers(1, &buffer_);
+            glGenBuffers(1, &buffer_);
+            GetGlState().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+        }
+        glBufferData(GL_UNIFORM_BUFFER, total, nullptr, GL_STREAM_DRAW);
+        mapped_ = nullptr;
+    }
+    GetGlState().BindBuffer(GL_UNIFORM_BUFFER, 0);
+    current_ = 0;
+    head_ = 0;
+    return buffer_ != 0;
+}
+
+void UniformRing::Destroy() {
+    for (GLsync& f : fences_) {
+        if (f) { glDeleteSync(f); f = nullptr; }
+    }
+    if (buffer_) {
+        if (persistent_) {
+            GetGlState().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            GetGlState().BindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        GetGlState().ForgetBuffer(buffer_);
+        glDeleteBuffers(1, &buffer_);
+    }
+    buffer_ = 0; mapped_ = nullptr; persistent_ = false;
+}
+
+void UniformRing::BeginFrame() {
+    current_ = (current_ + 1) % regions_;
+    head_ = 0;
+
+    // 이 구역을 마지막으로 쓴 프레임의 draw가 끝났는지 확인
+    if (GLsync f = fences_[current_]) {
+        GLenum r = glClientWaitSync(f, 0, 0);
+        if (r == GL_TIMEOUT_EXPIRED) {
+            ++stats_.stalls;
+            do {
+                r = glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000000));
+            } while (r == GL_TIMEOUT_EXPIRED);
+        }
+        glDeleteSync(f);
+        fences_[current_] = nullptr;
+        // 대기 실패: GPU가 다 읽었는지 모르므로 이 구역을 덮어쓰지 않고 저장소를 새로 잡음
+        if (r == GL_WAIT_FAILED) Orphan();
+    }
+
+    if (!persistent_) {
+        GetGlState().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+        // 펜스로 이미 동기화했으므로 드라이버의 암묵적 동기화는 생략
+        mapped_ = static_cast<unsigned char*>(glMapBufferRange(GL_UNIFORM_BUFFER,
+            (GLintptr)(current_ * regionSize_), (GLsizeiptr)regionSize_,
+            GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+        // 0으로 되돌리지 않음: EndFrame/Bind의 같은 바인드가 GlState에서 생략됨
+    }
+}
+
+void UniformRing::Orphan() {
+    ++stats_.orphans;
+    for (GLsync& f : fences_) {
+        if (f) { glDeleteSync(f); f = nullptr; }
+    }
+    GetGlState().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    if (persistent_) {
+        // 불변 저장소는 다시 지정할 수 없으므로 버퍼를 새로 만듦 (옛 버퍼는 GPU가 다 쓴 뒤 드라이버가 해제)
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        GetGlState().ForgetBuffer(buffer_);
+        glDeleteBuffers(1, &buffer_);
+        glGenBuffers(1, &buffer_);
+        GetGlState().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const GLsizeiptr total = (GLsizeiptr)(regionSize_ * regions_);
+        glBufferStorage(GL_UNIFORM_BUFFER, total, nullptr, flags);
+        mapped_ = static_cast<unsigned char*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, total, flags));
+        // 매핑 실패면 Alloc이 overflow로 실패함 (mapped_ == nullptr)
+    } else {
+        glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr)(regionSize_ * regions_), nullptr, GL_STREAM_DRAW);
+    }
+    GetGlState().BindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformRing::EndFrame() {
+    if (!persistent_ && mapped_) {
+        GetGlState().BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        mapped_ = nullptr;
+    }
+    fences_[current_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+UniformRing::Slice UniformRing::Alloc(size_t size) {
+    Slice s;
+    const size_t aligned = (size + align_ - 1) / align_ * align_;
+    if (!mapped_ || head_ + aligned > regionSize_) {
+        ++stats_.overflows;
+        return s;
+    }
+    const size_t regionBase = current_ * regionSize_;
+    s.ptr = persistent_ ? mapped_ + regionBase + head_ : mapped_ + head_;
+    s.offset = (GLintptr)(regionBase + head_);
+    s.size = (GLsizeiptr)size;
+    head_ += aligned;
+    ++stats_.allocations;
+    stats_.bytes += aligned;
+    return s;
+}
+
+void UniformRing::PrintStats(FILE* out) const {
+    fprintf(out, "[UniformRing] %s, %d x %zu bytes, align %d | allocs=%u bytes=%zu overflows=%u stalls=%u orphans=%u\n",
+            persistent_ ? "persistent" : "map-per-frame", regions_, regionSize_, align_,
+            stats_.allocations, stats_.bytes, stats_.overflows, stats_.stalls, stats_.orphans);
+}
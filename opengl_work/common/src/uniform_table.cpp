@@ -0,0 +1,89 @@
+#include "uniform_table.h"
+
+#include <algorithm>
+#include <cstring>
+
+void UniformTable::Reflect(GLuint program) {
+    program_ = program;
+    entries_.clear();
+    if (!program) return;
+
+    GLint count = 0, maxLen = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLen);
+    std::string buf(std::max(maxLen, 1), '\0');
+
+    entries_.reserve(count);
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei len = 0; GLint size = 0; GLenum type = 0;
+        glGetActiveUniform(program, (GLuint)i, (GLsizei)buf.size(), &len, &size, &type, buf.data());
+        std::string name(buf.data(), len);
+        // 배열은 "arr[0]" 으로 보고되므로 기본 이름으로 등록
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) name.resize(name.size() - 3);
+
+        GLint loc = glGetUniformLocation(program, name.c_str());
+        if (loc < 0) continue; // uniform block 멤버 등은 위치가 없음
+        Entry e;
+        e.hash = HashString(name);
+        e.location = loc;
+        e.type = type;
+        e.size = size;
+        e.name = std::move(name);
+        entries_.push_back(std::move(e));
+    }
+    std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+}
+
+const UniformTable::Entry* UniformTable::Find(UniformKey key) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), key.hash,
+                               [](const Entry& e, uint64_t h) { return e.hash < h; });
+    return (it != entries_.end() && it->hash == key.hash) ? &*it : nullptr;
+}
+
+GLint UniformTable::Location(UniformKey key) const {
+    const Entry* e = Find(key);
+    return e ? e->location : -1;
+}
+
+UniformTable::Entry* UniformTable::Dirty(UniformKey key, const void* data, size_t bytes) {
+    Entry* e = const_cast<Entry*>(Find(key));
+    if (!e) { ++stats_.missing; return nullptr; }
+    if (e->valid && std::memcmp(e->value, data, bytes) == 0) { ++stats_.skipped; return nullptr; }
+    std::memcpy(e->value, data, bytes);
+    e->valid = true;
+    ++stats_.uploads;
+    return e;
+}
+
+void UniformTable::Set(UniformKey key, int v) {
+    if (Entry* e = Dirty(key, &v, sizeof(v))) glUniform1i(e->location, v);
+}
+
+void UniformTable::Set(UniformKey key, float v) {
+    if (Entry* e = Dirty(key, &v, sizeof(v))) glUniform1f(e->location, v);
+}
+
+void UniformTable::Set(UniformKey key, float x, float y) {
+    const float v[2] = { x, y };
+    if (Entry* e = Dirty(key, v, sizeof(v))) glUniform2fv(e->location, 1, v);
+}
+
+void UniformTable::Set(UniformKey key, float x, float y, float z) {
+    const float v[3] = { x, y, z };
+    if (Entry* e = Dirty(key, v, sizeof(v))) glUniform3fv(e->location, 1, v);
+}
+
+void UniformTable::Set(UniformKey key, float x, float y, float z, float w) {
+    const float v[4] = { x, y, z, w };
+    if (Entry* e = Dirty(key, v, sizeof(v))) glUniform4fv(e->location, 1, v);
+}
+
+void UniformTable::SetMat4(UniformKey key, const float* m, bool transpose) {
+    if (Entry* e = Dirty(key, m, sizeof(float) * 16))
+        glUniformMatrix4fv(e->location, 1, transpose ? GL_TRUE : GL_FALSE, m);
+}
+
+void UniformTable::PrintStats(FILE* out) const {
+    fprintf(out, "[UniformTable] program=%u uniforms=%zu | uploads=%u skipped=%u missing=%u\n",
+            program_, entries_.size(), stats_.uploads, stats_.skipped, stats_.missing);
+}
@@ -0,0 +1,306 @@
+#include "vfs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// 파일 전체 읽기 전용 매핑
+class MappedFile {
+public:
+    static std::shared_ptr<const MappedFile> Open(const std::string& path);
+    ~MappedFile();
+
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+
+private:
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+std::shared_ptr<const MappedFile> MappedFile::Open(const std::string& path) {
+    auto m = std::make_shared<MappedFile>();
+#ifdef _WIN32
+    m->file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                           nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m->file_ == INVALID_HANDLE_VALUE) return nullptr;
+    LARGE_INTEGER len{};
+    if (!GetFileSizeEx(m->file_, &len)) return nullptr;
+    m->size = (size_t)len.QuadPart;
+    if (m->size == 0) return m;   // 빈 파일은 매핑할 수 없음 → 빈 구간
+    m->mapping_ = CreateFileMappingA(m->file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m->mapping_) return nullptr;
+    m->data = static_cast<const unsigned char*>(MapViewOfFile(m->mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!m->data) return nullptr;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return nullptr;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) { ::close(fd); return nullptr; }
+    m->size = (size_t)st.st_size;
+    if (m->size > 0) {
+        void* p = mmap(nullptr, m->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) { ::close(fd); return nullptr; }
+        m->data = static_cast<const unsigned char*>(p);
+    }
+    ::close(fd);   // 매핑은 fd를 닫아도 유지됨
+#endif
+    return m;
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+    if (data) munmap(const_cast<unsigned char*>(data), size);
+#endif
+}
+
+namespace {
+// 팩 아카이브: 헤더 + 목차(offset, size, 이름) + 16바이트 정렬된 파일 데이터
+constexpr uint32_t kPackMagic = 0x4B504C47; // "GLPK"
+constexpr uint32_t kPackVersion = 1;
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct PackEntry {
+    uint64_t offset;
+    uint64_t size;
+    uint32_t nameLen;
+};
+
+double MsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// "./a//b\c" → "a/b/c"
+std::string CleanPath(std::string_view path) {
+    std::string p(path);
+    std::replace(p.begin(), p.end(), '\\', '/');
+    while (p.compare(0, 2, "./") == 0) p.erase(0, 2);
+    for (size_t i; (i = p.find("//")) != std::string::npos;) p.erase(i, 1);
+    return p;
+}
+
+bool StartsWith(std::string_view s, std::string_view prefix) {
+    return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+}
+}
+
+bool Vfs::MountDirectory(std::string prefix, std::string dir) {
+    std::error_code ec;
+    if (!fs::is_directory(dir, ec)) {
+        fprintf(stderr, "[Vfs] not a directory: %s\n", dir.c_str());
+        return false;
+    }
+    Mount m;
+    m.prefix = CleanPath(prefix);
+    m.dir = std::move(dir);
+    std::lock_guard<std::mutex> lock(mutex_);
+    mounts_.push_back(std::move(m));
+    return true;
+}
+
+bool Vfs::MountArchive(std::string prefix, const std::string& archivePath) {
+    std::shared_ptr<const MappedFile> file = MappedFile::Open(archivePath);
+    if (!file || file->size < sizeof(PackHeader)) {
+        fprintf(stderr, "[Vfs] failed to map archive %s\n", archivePath.c_str());
+        return false;
+    }
+    PackHeader hdr;
+    memcpy(&hdr, file->data, sizeof(hdr));
+    if (hdr.magic != kPackMagic || hdr.version != kPackVersion) {
+        fprintf(stderr, "[Vfs] bad archive header: %s\n", archivePath.c_str());
+        return false;
+    }
+
+    Mount m;
+    m.prefix = CleanPath(prefix);
+    m.archive = file;
+    size_t pos = sizeof(hdr);
+    for (uint32_t i = 0; i < hdr.count; ++i) {
+        PackEntry e;
+        bool ok = pos + sizeof(e) <= file->size;
+        if (ok) {
+            memcpy(&e, file->data + pos, sizeof(e));
+            pos += sizeof(e);
+            // 더해서 비교하면 넘칠 수 있으므로 남은 크기와 비교
+            ok = e.nameLen <= file->size - pos && e.offset <= file->size && e.size <= file->size - e.offset;
+        }
+        if (!ok) {
+            fprintf(stderr, "[Vfs] truncated archive: %s\n", archivePath.c_str());
+            return false;
+        }
+        m.index.emplace(std::string(reinterpret_cast<const char*>(file->data + pos), e.nameLen), Entry{ e.offset, e.size });
+        pos += e.nameLen;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    mounts_.push_back(std::move(m));
+    return true;
+}
+
+void Vfs::UnmountAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mounts_.clear();   // 이미 열린 FileView는 매핑을 계속 붙잡고 있음
+}
+
+FileView Vfs::Open(std::string_view path) {
+    const std::string p = CleanPath(path);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto t0 = std::chrono::steady_clock::now();
+    FileView v = OpenLocked(p);
+    const double ms = MsSince(t0);
+
+    ++stats_.opens;
+    stats_.openMs += ms;
+    if (!v) {
+        ++stats_.failures;
+        fprintf(stderr, "Failed to open %.*s\n", (int)path.size(), path.data());
+        return v;
+    }
+    stats_.bytesMapped += v.size();
+    VfsFileStats& f = files_[p];
+    ++f.opens;
+    f.bytes = v.size();
+    f.totalMs += ms;
+    f.maxMs = std::max(f.maxMs, ms);
+    return v;
+}
+
+FileView Vfs::OpenLocked(const std::string& p) {
+    for (auto it = mounts_.rbegin(); it != mounts_.rend(); ++it) {
+        if (!StartsWith(p, it->prefix)) continue;
+        const std::string rel = p.substr(it->prefix.size());
+        if (it->archive) {
+            auto e = it->index.find(rel);
+            if (e != it->index.end())
+                return FileView(it->archive, it->archive->data + e->second.offset, (size_t)e->second.size);
+        } else if (auto file = MappedFile::Open(it->dir + "/" + rel)) {
+            return FileView(file, file->data, file->size);
+        }
+    }
+    // 마운트에 없으면 경로 그대로 (절대 경로, 작업 디렉터리 기준 상대 경로)
+    if (auto file = MappedFile::Open(p))
+        return FileView(file, file->data, file->size);
+    return {};
+}
+
+bool Vfs::Exists(std::string_view path) {
+    const std::string p = CleanPath(path);
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    for (auto it = mounts_.rbegin(); it != mounts_.rend(); ++it) {
+        if (!StartsWith(p, it->prefix)) continue;
+        const std::string rel = p.substr(it->prefix.size());
+        if (it->archive ? it->index.count(rel) > 0 : fs::is_regular_file(it->dir + "/" + rel, ec))
+            return true;
+    }
+    return fs::is_regular_file(p, ec);
+}
+
+bool Vfs::WriteArchive(const std::string& dir, const std::string& archivePath) {
+    std::vector<std::pair<std::string, fs::path>> files;
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(dir, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_regular_file(ec))
+            files.emplace_back(fs::relative(it->path(), dir, ec).generic_string(), it->path());
+    }
+    if (ec) { fprintf(stderr, "[Vfs] cannot scan %s\n", dir.c_str()); return false; }
+    std::sort(files.begin(), files.end());
+
+    // 목차 크기를 먼저 계산해서 데이터 오프셋을 확정
+    uint64_t offset = sizeof(PackHeader);
+    for (auto& f : files) offset += sizeof(PackEntry) + f.first.size();
+    std::vector<PackEntry> entries;
+    for (auto& f : files) {
+        offset = (offset + 15) & ~uint64_t(15);
+        const uint64_t size = fs::file_size(f.second, ec);
+        if (ec) { fprintf(stderr, "[Vfs] cannot stat %s\n", f.second.string().c_str()); return false; }
+        entries.push_back({ offset, size, (uint32_t)f.first.size() });
+        offset += size;
+    }
+
+    const std::string tmp = archivePath + ".tmp";
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    // 실패하면 쓰던 .tmp를 닫고 지움
+    auto fail = [&](const char* what, const std::string& path) {
+        fprintf(stderr, "[Vfs] %s: %s\n", what, path.c_str());
+        out.close();
+        fs::remove(tmp, ec);
+        return false;
+    };
+    if (!out) return fail("cannot create", tmp);
+    PackHeader hdr{ kPackMagic, kPackVersion, (uint32_t)files.size(), 0 };
+    out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    uint64_t pos = sizeof(hdr);
+    for (size_t i = 0; i < files.size(); ++i) {
+        out.write(reinterpret_cast<const char*>(&entries[i]), sizeof(PackEntry));
+        out.write(files[i].first.data(), files[i].first.size());
+        pos += sizeof(PackEntry) + files[i].first.size();
+    }
+    // 목차에 적은 크기만큼 정확히 복사 (스캔 뒤 파일이 바뀌면 실패)
+    std::vector<char> buf(1 << 16);
+    for (size_t i = 0; i < files.size(); ++i) {
+        static const char zeros[16] = {};
+        out.write(zeros, entries[i].offset - pos);
+        pos = entries[i].offset;
+        if (entries[i].size == 0) continue;
+        std::ifstream in(files[i].second, std::ios::binary);
+        for (uint64_t left = entries[i].size; left > 0;) {
+            const size_t n = (size_t)std::min<uint64_t>(left, buf.size());
+            if (!in.read(buf.data(), n)) return fail("read failed (changed while packing?)", files[i].second.string());
+            out.write(buf.data(), n);
+            left -= n;
+        }
+        pos += entries[i].size;
+    }
+    if (!out.flush()) return fail("write failed", tmp);
+    out.close();
+    fs::rename(tmp, archivePath, ec);
+    if (ec) return fail("cannot rename", tmp);
+    return true;
+}
+
+VfsStats Vfs::Stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void Vfs::PrintStats(FILE* out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fprintf(out, "[Vfs] mounts=%zu opens=%u failed=%u mapped=%zu bytes | %.3f ms\n",
+            mounts_.size(), stats_.opens, stats_.failures, stats_.bytesMapped, stats_.openMs);
+    for (const auto& [path, f] : files_) {
+        fprintf(out, "  %-40s x%u %8zu bytes  avg %.3f ms, max %.3f ms\n",
+                path.c_str(), f.opens, f.bytes, f.totalMs / f.opens, f.maxMs);
+    }
+}
+
+Vfs& GetVfs() {
+    static Vfs vfs;
+    return vfs;
+}